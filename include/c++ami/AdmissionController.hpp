@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_ADMISSION_CONTROLLER_HPP
+#define AMI_ADMISSION_CONTROLLER_HPP
+
+#include "c++ami/action/Action.hpp"
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cpp_ami {
+
+///
+/// @class AdmissionController
+///
+/// @brief Caps the number of actions in flight on an AMI session and queues the rest in priority lanes.
+///
+/// The AMI server processes the actions of a session one after another, so flooding a session with bulk actions makes
+/// latency critical actions wait behind them. This object sits in front of the socket writer: actions are written
+/// immediately while fewer than the configured maximum are in flight, otherwise they are queued in the lane matching
+/// their priority. Whenever an in-flight action is retired the oldest action of the most urgent non-empty lane is
+/// written.
+///
+/// Actions that are retired while still queued (timed out or cancelled) are removed from their lane without ever being
+/// written.
+///
+/// Actions are retired on the dispatcher's response thread, which mustn't be held up by socket writes. The actions a
+/// retirement admits are therefore handed to a writer thread of this object, started the first time it is needed;
+/// actions admitted by \c submit are written on the submitting thread unless admitted actions are still waiting for
+/// the writer thread, in which case they are queued behind them.
+///
+class AdmissionController {
+public:
+    using priority_t = action::Action::Priority;
+    using write_t = std::function<void(std::string const &)>;
+    using fail_t = std::function<void(std::string const &, std::exception_ptr const &)>;
+
+    static constexpr size_t LANE_COUNT{3};
+    static constexpr size_t MAX_ORPHANED{1024};     ///< Number of action IDs retired before submission that are remembered.
+
+    ///
+    /// @struct Request
+    ///
+    /// @brief Serialized action waiting to be admitted.
+    ///
+    struct Request {
+        std::string action_id;          ///< Action ID of the action.
+        priority_t priority;            ///< Lane the action is queued in.
+        std::string buf;                ///< Serialized action.
+    };
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Snapshot of the state of the controller.
+    ///
+    struct Metrics {
+        size_t max_in_flight{0};                    ///< Maximum number of actions in flight; 0 means unlimited.
+        size_t in_flight{0};                        ///< Number of actions currently in flight.
+        std::array<size_t, LANE_COUNT> queued{};    ///< Number of actions queued in each lane, indexed by priority.
+        uint64_t admitted{0};                       ///< Total number of actions written immediately.
+        uint64_t deferred{0};                       ///< Total number of actions that had to wait in a lane.
+        size_t orphaned{0};                         ///< Number of action IDs retired before they were submitted.
+    };
+
+public:
+    AdmissionController() = delete;
+    AdmissionController(AdmissionController const &) = delete;
+    AdmissionController(AdmissionController &&) noexcept = delete;
+
+    /// @brief Constructs an object that writes admitted actions through \c write.
+    ///
+    /// @param write Function writing serialized actions to the AMI server.
+    /// @param fail Function invoked for each action whose write failed.
+    /// @param max_in_flight Maximum number of actions in flight; 0 means unlimited.
+    explicit AdmissionController(write_t write, fail_t fail, size_t max_in_flight);
+
+    /// @brief Stops the writer thread; see \c close.
+    virtual ~AdmissionController();
+
+    AdmissionController& operator=(AdmissionController const &) = delete;
+    AdmissionController& operator=(AdmissionController &&) noexcept = delete;
+
+    /// @brief Sets the maximum number of actions in flight. Raising the limit admits queued actions right away.
+    ///
+    /// @param max_in_flight Maximum number of actions in flight; 0 means unlimited.
+    void set_max_in_flight(size_t max_in_flight);
+
+    /// @brief Writes \c requests that can be admitted in a single write and queues the rest.
+    ///
+    /// @param requests Actions to admit.
+    void submit(std::vector<Request> requests);
+
+    /// @brief Retires the action identified by \c action_id, freeing its slot for a queued action. The admitted action
+    ///        is written by the writer thread.
+    ///
+    /// @param action_id Action ID of the retired action.
+    void release(std::string const &action_id);
+
+    /// @brief Waits until every admitted action has been written.
+    void flush();
+
+    /// @brief Stops the writer thread. Actions admitted from then on are never written; the owner closes their
+    ///        requests as it shuts down.
+    void close();
+
+    /// @brief Returns a snapshot of the queue depths and counters of the controller.
+    ///
+    /// @return Controller metrics.
+    Metrics get_metrics() const;
+
+private:
+    using lane_t = std::list<Request>;
+
+    /// @brief Returns \c true if another action can be put in flight. Caller must hold \c mutex_.
+    ///
+    /// @return \c true if another action can be put in flight.
+    bool has_capacity() const;
+
+    /// @brief Moves queued actions into flight while there is capacity. Caller must hold \c mutex_.
+    ///
+    /// @return Actions to write.
+    std::vector<Request> pump();
+
+    /// @brief Writes \c requests in a single write, failing each of them if the write fails.
+    ///
+    /// @param requests Actions to write.
+    void write(std::vector<Request> const &requests) const;
+
+    /// @brief Hands \c requests to the writer thread, starting it if need be. Caller must hold \c mutex_.
+    ///
+    /// @param requests Actions to write.
+    void enqueue(std::vector<Request> requests);
+
+    /// @brief Writer thread for this object.
+    void work_thread();
+
+    write_t write_;                                 ///< Writes serialized actions to the AMI server.
+    fail_t fail_;                                   ///< Fails actions whose write failed.
+
+    size_t max_in_flight_;                          ///< Maximum number of actions in flight; 0 means unlimited.
+    std::unordered_set<std::string> in_flight_;     ///< Action IDs of the actions in flight.
+    std::unordered_set<std::string> orphaned_;      ///< Action IDs retired before they were submitted.
+    std::deque<std::string> orphan_order_;          ///< Action IDs in the order they were orphaned, oldest first; may still hold IDs since submitted.
+
+    std::array<lane_t, LANE_COUNT> lanes_;                          ///< Queued actions, indexed by priority.
+    std::unordered_map<std::string, lane_t::iterator> queued_;      ///< Location of each queued action.
+
+    uint64_t admitted_{0};                          ///< Total number of actions written immediately.
+    uint64_t deferred_{0};                          ///< Total number of actions that had to wait in a lane.
+
+    std::vector<Request> outbox_;                   ///< Admitted actions waiting for the writer thread.
+    bool writing_{false};                           ///< Flag indicating that the writer thread is writing.
+    bool closed_{false};                            ///< Flag to stop the writer thread.
+    std::condition_variable outbox_cv_;             ///< Condition variable used to wake the writer thread and \c flush.
+    std::thread thread_;                            ///< Handle to the writer thread, once started.
+
+    mutable std::mutex mutex_;                      ///< Mutex to control access to the in-flight and queue state.
+};
+
+}
+
+#endif
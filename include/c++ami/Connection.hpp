@@ -4,12 +4,22 @@
 #ifndef AMI_CONNECTION_HPP
 #define AMI_CONNECTION_HPP
 
+#include "c++ami/AdmissionController.hpp"
+#include "c++ami/DispatchGroup.hpp"
 #include "c++ami/EventDispatcher.hpp"
+#include "c++ami/InvokeAwaitable.hpp"
+#include "c++ami/Subscriber.hpp"
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace cpp_ami {
 
@@ -18,8 +28,10 @@ class Action;
 }
 
 namespace net {
+class SocketPoller;
 class SocketReader;
 class SocketWriter;
+class TcpSocket;
 } // namespace net
 
 class EventDispatcher;
@@ -37,8 +49,13 @@ class StreamParser;
 class Connection {
 public:
     using reaction_ptr_t = EventDispatcher::reaction_ptr_t;
+    using completion_handler_t = EventDispatcher::completion_handler_t;
+    using list_item_handler_t = EventDispatcher::list_item_handler_t;
+    using executor_t = InvokeAwaitable::executor_t;
 
     using event_callback_t = std::function<void(EventDispatcher::event_t const *)>;
+    using event_batch_t = std::span<EventDispatcher::event_t const * const>;
+    using event_batch_callback_t = std::function<void(event_batch_t)>;
     using event_callback_key_t = std::string;
 
 public:
@@ -52,6 +69,18 @@ public:
     /// @param port Port number on the AMI server to attach to.
     explicit Connection(std::string_view hostname, uint16_t port = 5038);
 
+    /// @brief Constructs an object that is connected to \c port on the \c hostname machine and shares its threads with
+    ///        other connections.
+    ///
+    /// @param hostname Hostname of the AMI server to attach to.
+    /// @param port Port number on the AMI server to attach to.
+    /// @param poller Poller reading the socket instead of a reader thread of its own.
+    /// @param group Dispatch group dispatching events instead of dispatcher threads of its own.
+    ///
+    /// The socket stream is parsed on the poller thread, so the connection doesn't start any thread at all.
+    Connection(std::string_view hostname, uint16_t port, std::shared_ptr<net::SocketPoller> poller,
+        std::shared_ptr<DispatchGroup> group);
+
     virtual ~Connection();
 
     Connection &operator=(Connection const &) = delete;
@@ -62,12 +91,51 @@ public:
     /// @return String containing AMI server version.
     std::string get_ami_version() const;
 
+    /// @brief Returns \c true until the AMI server closes the connection. Closure is only detected on connections
+    ///        read by a \c net::SocketPoller.
+    ///
+    /// @return \c true if the connection is open.
+    bool is_connected() const;
+
     /// @brief Sends \c action to the AMI server and immediately returns. The client application will need
     ///        to add callbacks to handle the responding events.
     ///
     /// @param action Action to send to the AMI server.
+    ///
+    /// Since nothing tracks the response, \c action bypasses the in-flight limit and is written right away.
     void async_invoke(action::Action const &action) const;
 
+    /// @brief Sends \c action to the AMI server and immediately returns. \c handler is invoked with the resulting
+    ///        Event object once the event stream is read back from the socket.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param handler Handler to invoke with the resulting Event object or the error that occurred.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request before \c handler is
+    ///        invoked with a timeout exception. A zero timeout waits indefinitely.
+    ///
+    /// Unlike \c invoke this doesn't allocate a promise/future pair or block a thread, allowing a single thread to
+    /// keep many requests in flight. \c handler is invoked on the event dispatcher response thread and shouldn't block.
+    /// If a request with the same ActionID is still outstanding, nothing is sent and \c handler is invoked right away
+    /// with an error.
+    void async_invoke(action::Action const &action, completion_handler_t handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Sends \c action to the AMI server and immediately returns. Items of the resulting EventList are streamed
+    ///        to \c item_handler as they are read back from the socket and \c handler is invoked once the list is
+    ///        complete.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param item_handler Handler to invoke with each EventList item.
+    /// @param handler Handler to invoke with the resulting EventList (head and tail events only) or the error that
+    ///        occurred.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request before \c handler is
+    ///        invoked with a timeout exception. A zero timeout waits indefinitely.
+    ///
+    /// Intended for actions with large list responses; items aren't buffered so memory use doesn't grow with the
+    /// length of the list. Both handlers are invoked on the event dispatcher response thread and shouldn't block.
+    void async_invoke(action::Action const &action, list_item_handler_t item_handler, completion_handler_t handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
     /// @brief Sends \c action to the AMI server and returns the resulting Event object. This call will block
     ///        indefinitely until all of the event stream is read back from the socket.
     ///
@@ -78,10 +146,68 @@ public:
     ///        \c timeout has elapsed (at which point an exception is raised) or the event stream was read back from the
     ///        socket.
     ///
+    /// The deadline is tracked by the event dispatcher; once it lapses the request is retired and any partially
+    /// received response is discarded.
+    /// An exception is raised, and nothing is sent, if a request with the same ActionID is still outstanding.
+    ///
     /// @param action Action to send to the AMI server.
     /// @param timeout Amount of time to wait for the AMI server to fulfill the event request.
     reaction_ptr_t invoke(action::Action const &action, std::chrono::milliseconds const &timeout) const;
 
+    /// @brief Sends \c action to the AMI server, streams the items of the resulting EventList to \c item_handler as
+    ///        they are read back from the socket and returns the EventList once it is complete. This call will block
+    ///        until \c timeout has elapsed (at which point an exception is raised) or the list is complete.
+    ///
+    /// @return Resulting EventList (head and tail events only); nullptr if the request was cancelled.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param item_handler Handler to invoke with each EventList item, on the event dispatcher response thread.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request. A zero timeout waits
+    ///        indefinitely.
+    reaction_ptr_t invoke(action::Action const &action, list_item_handler_t item_handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Sends all of \c actions to the AMI server in a single write and returns a future for each action's
+    ///        resulting Event object.
+    ///
+    /// @return Futures for the resulting Event objects, in the same order as \c actions.
+    ///
+    /// @param actions Actions to send to the AMI server.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill each event request before an exception is
+    ///        raised by the future. A zero timeout waits indefinitely.
+    ///
+    /// Response pipes for every action are registered before anything is written, so the AMI server can work through
+    /// the whole batch without waiting for a round trip per action. An exception is raised, and nothing is sent, if
+    /// two actions of the batch share an ActionID or one of them is still outstanding.
+    [[nodiscard]] std::vector<std::future<reaction_ptr_t>> invoke_many(std::span<action::Action const> actions,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Returns an awaitable that sends \c action to the AMI server when awaited and resumes the awaiting
+    ///        coroutine with the resulting Event object.
+    ///
+    /// @return Awaitable yielding the resulting Event object.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param executor Executor to resume the awaiting coroutine on. An empty executor resumes the coroutine inline on
+    ///        the event dispatcher response thread.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request before an exception is
+    ///        raised in the awaiting coroutine. A zero timeout waits indefinitely.
+    /// @param stop_token Token used to cancel the request; a cancelled request resumes with a null reaction.
+    ///
+    /// Unlike \c invoke no thread is blocked while the action is in flight, allowing a handful of threads to drive
+    /// many chains of dependent actions.
+    [[nodiscard]] InvokeAwaitable invoke_async(action::Action const &action, executor_t executor = {},
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero(),
+        std::stop_token stop_token = {}) const;
+
+    /// @brief Cancels an outstanding request for \c action.
+    ///
+    /// @param action Action to cancel the request for.
+    ///
+    /// The request is closed with a null reaction and any partially received response is discarded. Cancelling an
+    /// action that isn't outstanding has no effect.
+    void cancel(action::Action const &action) const;
+
     /// @brief Adds an event callback to the collection of callbacks. These callbacks are invoked whenever async_invoke
     ///        is invoked or the AMI server is sending events out.
     ///
@@ -90,24 +216,94 @@ public:
     /// @param callback Callback to invoke.
     event_callback_key_t add_callback(event_callback_t callback);
 
+    /// @brief Adds a batch event callback to the collection of callbacks. Batch callbacks are invoked once per event
+    ///        dispatcher wake-up with every event drained during that wake-up, rather than once per event.
+    ///
+    /// @return Callback ID.
+    ///
+    /// @param callback Callback to invoke.
+    ///
+    /// The events in the batch are only valid for the duration of the callback.
+    event_callback_key_t add_batch_callback(event_batch_callback_t callback);
+
+    /// @brief Adds a subscriber to the collection of callbacks. Unlike regular callbacks, \c callback is invoked from
+    ///        its own thread out of a bounded queue, so a slow subscriber doesn't delay other consumers.
+    ///
+    /// @return Callback ID.
+    ///
+    /// @param callback Callback to invoke.
+    /// @param options Queue capacity, overflow policy and thread name of the subscriber.
+    ///
+    /// Events queued for a subscriber are shared with other subscribers and stay valid until the callback returns.
+    /// Removing the subscriber delivers the events still queued before \c remove_callback returns, so it must not be
+    /// removed from its own callback.
+    event_callback_key_t add_subscriber(event_callback_t callback, Subscriber::Options options = {});
+
+    /// @brief Returns the queue depth, counters and lag of the subscriber identified by \c id.
+    ///
+    /// @return Subscriber metrics; std::nullopt if \c id doesn't identify a subscriber.
+    ///
+    /// @param id ID of the subscriber.
+    std::optional<Subscriber::Metrics> get_subscriber_metrics(event_callback_key_t const &id) const;
+
     /// @brief Removes an event callback from the collection of callbacks.
     ///
     /// @param id ID of callback to remove from the collection of event callbacks.
     void remove_callback(event_callback_key_t const &id);
 
+    /// @brief Conflates notification events of \c event_types before they reach any callback, keeping only the newest
+    ///        event per event type and Uniqueid.
+    ///
+    /// @param event_types Event types to conflate, e.g. "Newexten", "VarSet" or "Newstate". An empty set disables
+    ///        conflation.
+    /// @param window Amount of time events are held back waiting for a newer event. A zero window only conflates
+    ///        events that queued up while callbacks were busy.
+    void set_conflation(std::unordered_set<std::string> event_types,
+        std::chrono::milliseconds const &window = std::chrono::milliseconds::zero());
+
+    /// @brief Returns the counters of the conflation stage.
+    ///
+    /// @return Conflation metrics.
+    event::EventConflater::Metrics get_conflation_metrics() const;
+
+    /// @brief Sets the maximum number of correlated actions (all but the fire-and-forget \c async_invoke) in flight on
+    ///        the AMI session. Actions beyond the limit are queued by priority and sent as in-flight actions complete.
+    ///
+    /// @param max_in_flight Maximum number of actions in flight; 0 (the default) means unlimited.
+    void set_max_in_flight(size_t max_in_flight);
+
+    /// @brief Returns the in-flight count, per-priority queue depths and counters of the in-flight limiter.
+    ///
+    /// @return In-flight limiter metrics.
+    AdmissionController::Metrics get_admission_metrics() const;
+
 private:
-    /// @brief Invokes all event callbacks on \c dict.
+    /// @brief Sends \c action to the AMI server through the in-flight limiter.
+    ///
+    /// @param action Action to send. Its reaction pipe or handler must already be registered with the dispatcher.
+    void submit(action::Action const &action) const;
+
+    /// @brief Invokes all event callbacks on each event in \c events and all batch event callbacks on \c events, then
+    ///        hands \c events over to the subscribers.
     ///
-    /// @param dict Event values.
-    void dispatch_handler(EventDispatcher::event_ptr_t dict);
+    /// @param events Batch of events.
+    void dispatch_handler(EventDispatcher::event_batch_t events);
 
     std::string ami_version_;   ///< AMI version.
+    std::atomic<bool> connected_{ true };   ///< Flag cleared once the AMI server closes the connection.
 
-    std::unordered_map<event_callback_key_t, event_callback_t> callbacks_;  ///< Collection of event callbacks.
-    std::mutex callbacks_mutex_;                                            ///< Mutex to guard \c m_callbacks collection.
+    std::unordered_map<event_callback_key_t, event_callback_t> callbacks_;              ///< Collection of event callbacks.
+    std::unordered_map<event_callback_key_t, event_batch_callback_t> batch_callbacks_;  ///< Collection of batch event callbacks.
+    std::unordered_map<event_callback_key_t, std::shared_ptr<Subscriber>> subscribers_; ///< Collection of subscribers.
+    std::vector<EventDispatcher::event_t const *> batch_;                               ///< Scratch collection used to hand batches to batch event callbacks.
+    std::vector<Subscriber::event_ptr_t> shared_batch_;                                 ///< Scratch collection used to hand batches to subscribers.
+    mutable std::mutex callbacks_mutex_;                                                ///< Mutex to guard the callback collections.
 
+    std::unique_ptr<AdmissionController> admission_;    ///< Object responsible for limiting the number of actions in flight.
     std::unique_ptr<EventDispatcher> dispatcher_;   ///< Object responsible for dispatching AMI events.
     std::unique_ptr<net::SocketReader> reader_;     ///< Object responsible for pulling messages from the AMI socket.
+    std::shared_ptr<net::SocketPoller> poller_;     ///< Poller pulling messages from the AMI socket instead of \c reader_, if any.
+    std::shared_ptr<net::TcpSocket> socket_;        ///< Socket attached to the AMI server.
     std::unique_ptr<net::SocketWriter> writer_;     ///< Object responsible for writing messages to the AMI socket.
     std::unique_ptr<StreamParser> stream_parser_;   ///< Object responsible for parsing the socket stream into individual AMI messages.
 };
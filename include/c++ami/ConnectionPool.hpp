@@ -0,0 +1,219 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CONNECTION_POOL_HPP
+#define AMI_CONNECTION_POOL_HPP
+
+#include "c++ami/Connection.hpp"
+#include "c++ami/DispatchGroup.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_ami {
+
+namespace net {
+class SocketPoller;
+}
+
+///
+/// @class ConnectionPool
+///
+/// @brief Connections to many AMI servers behind a single interface, with a merged event stream.
+///
+/// Each server is identified by an ID chosen when it is added. Actions are routed to a server by its ID, and the
+/// notification events of every server are merged into one stream whose callbacks are told which server sent each
+/// event.
+///
+/// Members don't start threads of their own: one poller thread reads every socket and parses the streams, and one
+/// dispatch group services the event dispatchers of all members. Together with the health thread, which pings every
+/// server periodically, the pool runs four threads no matter how many servers it holds. Merged callbacks all run on
+/// the dispatch group's notification thread and shouldn't block.
+///
+class ConnectionPool {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using server_id_t = std::string;
+    using reaction_ptr_t = Connection::reaction_ptr_t;
+    using completion_handler_t = Connection::completion_handler_t;
+    using event_callback_t = std::function<void(server_id_t const &, EventDispatcher::event_t const *)>;
+    using event_callback_key_t = Connection::event_callback_key_t;
+
+    ///
+    /// @struct Options
+    ///
+    /// @brief Health checking of the pool.
+    ///
+    struct Options {
+        std::chrono::milliseconds health_interval{ std::chrono::seconds(5) };   ///< Amount of time between pings of each server; zero disables the health thread.
+        std::chrono::milliseconds health_timeout{ std::chrono::seconds(2) };    ///< Amount of time a server has to answer a ping.
+    };
+
+    ///
+    /// @struct Health
+    ///
+    /// @brief Health of a server.
+    ///
+    struct Health {
+        bool connected{ true };                 ///< Flag indicating that the server hasn't closed the connection.
+        bool healthy{ true };                   ///< Flag indicating that the server is connected and answered its last ping.
+        clock_t::duration rtt{ 0 };             ///< Round-trip time of the last answered ping.
+        clock_t::time_point last_reply;         ///< Time the last ping was answered.
+        uint64_t failures{ 0 };                 ///< Number of consecutive pings that went unanswered.
+    };
+
+public:
+    ConnectionPool(ConnectionPool const &) = delete;
+    ConnectionPool(ConnectionPool &&) noexcept = delete;
+
+    /// @brief Constructs an empty pool with the default options and starts its threads.
+    ConnectionPool();
+
+    /// @brief Constructs an empty pool and starts its threads.
+    ///
+    /// @param options Health checking of the pool.
+    explicit ConnectionPool(Options const &options);
+
+    /// @brief Detaches every server from the merged event stream, disconnects from them and stops the threads.
+    virtual ~ConnectionPool();
+
+    ConnectionPool& operator=(ConnectionPool const &) = delete;
+    ConnectionPool& operator=(ConnectionPool &&) noexcept = delete;
+
+    /// @brief Connects to \c port on the \c hostname machine and adds the connection to the pool as \c id.
+    ///
+    /// @return Connection to the server, e.g. to log in with.
+    ///
+    /// @param id ID of the server in the pool.
+    /// @param hostname Hostname of the AMI server to attach to.
+    /// @param port Port number on the AMI server to attach to.
+    ///
+    /// An exception is raised if \c id is already in the pool or the connection fails.
+    std::shared_ptr<Connection> add_server(server_id_t const &id, std::string_view hostname, uint16_t port = 5038);
+
+    /// @brief Removes the server \c id from the pool and its events from the merged stream. The connection is closed
+    ///        once the last reference to it goes away, which waits for calls made through the pool to return.
+    ///
+    /// @param id ID of the server.
+    void remove_server(server_id_t const &id);
+
+    /// @brief Returns the connection to the server \c id. The connection stays open while it is referenced, even once
+    ///        the server is removed from the pool.
+    ///
+    /// @return Connection to the server.
+    ///
+    /// @param id ID of the server.
+    ///
+    /// An exception is raised if \c id isn't in the pool.
+    std::shared_ptr<Connection> get(server_id_t const &id) const;
+
+    /// @brief Returns the IDs of the servers in the pool.
+    ///
+    /// @return Server IDs.
+    std::vector<server_id_t> get_servers() const;
+
+    /// @brief Sends \c action to the server \c id and returns the resulting Event object.
+    ///
+    /// @return Resulting Event object.
+    ///
+    /// @param id ID of the server.
+    /// @param action Action to send.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request.
+    reaction_ptr_t invoke(server_id_t const &id, action::Action const &action,
+        std::chrono::milliseconds const &timeout) const;
+
+    /// @brief Sends \c action to the server \c id and immediately returns; \c handler is invoked with the resulting
+    ///        Event object.
+    ///
+    /// @param id ID of the server.
+    /// @param action Action to send.
+    /// @param handler Handler to invoke with the resulting Event object or the error that occurred.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request. A zero timeout waits
+    ///        indefinitely.
+    void async_invoke(server_id_t const &id, action::Action const &action, completion_handler_t handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Adds a callback to the merged event stream.
+    ///
+    /// @return Callback ID.
+    ///
+    /// @param callback Callback to invoke with the ID of the server and each notification event it sent.
+    event_callback_key_t add_callback(event_callback_t callback);
+
+    /// @brief Removes a callback from the merged event stream.
+    ///
+    /// @param id ID of callback to remove.
+    void remove_callback(event_callback_key_t const &id);
+
+    /// @brief Returns the health of the server \c id.
+    ///
+    /// @return Health of the server; std::nullopt if \c id isn't in the pool.
+    ///
+    /// @param id ID of the server.
+    std::optional<Health> get_health(server_id_t const &id) const;
+
+    /// @brief Pings every server that isn't waiting on a ping already. Returns right away; the health of each server
+    ///        is updated once its ping is answered or times out.
+    void check_health();
+
+private:
+    ///
+    /// @struct HealthState
+    ///
+    /// @brief Health of a server, shared with the handlers of its pings.
+    ///
+    struct HealthState {
+        Health health;                  ///< Health of the server.
+        bool pinging{ false };          ///< Flag indicating that a ping is outstanding.
+        std::mutex mutex;               ///< Mutex to control access to the health.
+    };
+
+    ///
+    /// @struct Member
+    ///
+    /// @brief Server in the pool.
+    ///
+    struct Member {
+        std::shared_ptr<Connection> connection;     ///< Connection to the server.
+        std::shared_ptr<HealthState> health;        ///< Health of the server.
+        event_callback_key_t callback_key;          ///< Key of the batch callback feeding the merged event stream.
+    };
+
+    /// @brief Invokes the merged callbacks on each event in \c events.
+    ///
+    /// @param id ID of the server that sent the events.
+    /// @param events Batch of events.
+    void dispatch_handler(server_id_t const &id, Connection::event_batch_t events);
+
+    /// @brief Health thread for this object.
+    void work_thread();
+
+    Options options_;                                           ///< Health checking of the pool.
+
+    std::shared_ptr<net::SocketPoller> poller_;                 ///< Poller reading the sockets of all members.
+    std::shared_ptr<DispatchGroup> group_;                      ///< Dispatch group servicing the dispatchers of all members.
+
+    std::unordered_map<server_id_t, Member> members_;           ///< Servers in the pool keyed by ID.
+    mutable std::mutex members_mutex_;                          ///< Mutex to control access to the members.
+
+    std::unordered_map<event_callback_key_t, event_callback_t> callbacks_;  ///< Callbacks of the merged event stream.
+    std::mutex callbacks_mutex_;                                ///< Mutex to control access to the callbacks.
+
+    std::mutex thread_mutex_;                                   ///< Mutex used to wait between health checks.
+    std::condition_variable thread_cv_;                         ///< Condition variable used to stop the health thread.
+    bool run_{ true };                                          ///< Flag to stop the health thread. Guarded by \c thread_mutex_.
+    std::thread thread_;                                        ///< Handle to health thread.
+};
+
+}
+
+#endif
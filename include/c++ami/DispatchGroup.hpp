@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_DISPATCH_GROUP_HPP
+#define AMI_DISPATCH_GROUP_HPP
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace cpp_ami {
+
+class EventDispatcher;
+
+///
+/// @class DispatchGroup
+///
+/// @brief Pair of threads shared by the event dispatchers of many connections.
+///
+/// On its own every event dispatcher runs a notification thread and a response thread. Dispatchers constructed with a
+/// group don't start any threads; the group's notification thread and response thread service whichever member has
+/// work queued, one member at a time per lane. A member is never serviced by two threads on the same lane, so the
+/// notification events of a connection are still delivered in order and notification callbacks of all members run on
+/// a single thread.
+///
+/// The response thread also services the deadlines of members with requests outstanding, and the notification thread
+/// wakes up in time to release events held back by the conflation stage of any member.
+///
+class DispatchGroup {
+public:
+    DispatchGroup(DispatchGroup const &) = delete;
+    DispatchGroup(DispatchGroup &&) noexcept = delete;
+
+    /// @brief Constructs the group and starts its threads.
+    DispatchGroup();
+
+    /// @brief Stops the threads. Every member must have been destroyed.
+    virtual ~DispatchGroup();
+
+    DispatchGroup& operator=(DispatchGroup const &) = delete;
+    DispatchGroup& operator=(DispatchGroup &&) noexcept = delete;
+
+    /// @brief Returns the number of dispatchers serviced by the group.
+    ///
+    /// @return Number of members.
+    size_t size() const;
+
+private:
+    friend class EventDispatcher;
+
+    ///
+    /// @enum Lane
+    ///
+    /// @brief Work a member can have queued.
+    ///
+    enum class Lane : uint8_t {
+        events,     ///< Notification events, serviced by the notification thread.
+        responses,  ///< Responses and deadlines, serviced by the response thread.
+    };
+
+    ///
+    /// @struct LaneState
+    ///
+    /// @brief Members waiting to be serviced on a lane.
+    ///
+    struct LaneState {
+        std::deque<EventDispatcher *> ready;                ///< Members with work queued, in the order they were woken.
+        std::unordered_set<EventDispatcher *> queued;       ///< Members in \c ready.
+        EventDispatcher *busy{ nullptr };                   ///< Member being serviced, if any.
+        std::chrono::steady_clock::time_point swept;        ///< Time the members with deadlines were last serviced.
+        std::condition_variable cv;                         ///< Condition variable used to wake the lane's thread.
+        std::thread thread;                                 ///< Handle to the lane's thread.
+    };
+
+    /// @brief Adds \c dispatcher to the group.
+    ///
+    /// @param dispatcher Dispatcher to service.
+    void add(EventDispatcher *dispatcher);
+
+    /// @brief Removes \c dispatcher from the group. Blocks until neither thread is servicing it; it isn't serviced
+    ///        again afterwards.
+    ///
+    /// @param dispatcher Dispatcher to stop servicing.
+    void remove(EventDispatcher *dispatcher);
+
+    /// @brief Queues \c dispatcher to be serviced on \c lane.
+    ///
+    /// @param dispatcher Member with work queued.
+    /// @param lane Lane the work is queued on.
+    void wake(EventDispatcher *dispatcher, Lane lane);
+
+    /// @brief Thread servicing \c lane.
+    ///
+    /// @param lane Lane to service.
+    void work_thread(Lane lane);
+
+    /// @brief Services \c dispatcher on \c lane with \c lock released. Caller must hold \c lock on \c mutex_.
+    ///
+    /// @param lock Lock on \c mutex_.
+    /// @param dispatcher Member to service.
+    /// @param lane Lane to service.
+    void service(std::unique_lock<std::mutex> &lock, EventDispatcher *dispatcher, Lane lane);
+
+    /// @brief Returns the state of \c lane.
+    ///
+    /// @return Lane state.
+    ///
+    /// @param lane Lane.
+    LaneState& state(Lane lane);
+
+    std::unordered_set<EventDispatcher *> members_;     ///< Dispatchers serviced by the group.
+    std::array<LaneState, 2> lanes_;                    ///< Per-lane state, indexed by \c Lane.
+    std::condition_variable idle_cv_;                   ///< Condition variable used to wake threads waiting for a member to be idle.
+    mutable std::mutex mutex_;                          ///< Mutex to control access to the members and lanes.
+    bool run_{ true };                                  ///< Flag to stop the threads. Guarded by \c mutex_.
+};
+
+}
+
+#endif
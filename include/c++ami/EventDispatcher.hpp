@@ -4,17 +4,27 @@
 #ifndef AMI_EVENT_DISPATCHER_HPP
 #define AMI_EVENT_DISPATCHER_HPP
 
+#include "c++ami/DispatchGroup.hpp"
 #include "c++ami/reaction/Reaction.hpp"
 #include "c++ami/event/Event.hpp"
+#include "c++ami/event/EventConflater.hpp"
+#include "c++ami/event/EventPool.hpp"
+#include "c++ami/util/TimerWheel.hpp"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace cpp_ami {
@@ -40,13 +50,27 @@ namespace reaction {
 /// This class is also responsible for returning response events to callers of the invoke functions. Response events can
 /// be bundled together into more complex system event messages to be processed by the client application.
 ///
+/// Messages are classified as they are added: a message whose action ID matches an outstanding request is queued on a
+/// separate response lane served by its own thread, which also services request deadlines. Notification events are
+/// queued and dispatched on the work thread. A burst of notification events therefore never delays the completion of
+/// a request.
+///
+/// Dispatchers constructed with a \c DispatchGroup don't start their own threads; both lanes are serviced by the
+/// group's threads instead, shared with the other members of the group.
+///
 class EventDispatcher {
 public:
     // The following are typedefs for objects used by the function based event handler. Events of this type
-    // will be dispatched via the dispatch function.
+    // will be dispatched via the dispatch function. Dispatched events are recycled through a per-dispatcher pool once
+    // they are released.
     using event_t = util::KeyValDict;
-    using event_ptr_t = std::unique_ptr<event_t const>;
-    using event_callback_t = std::function<void(event_ptr_t)>;
+    using event_ptr_t = std::unique_ptr<event::Event const, event::EventPool::Deleter>;
+    using event_batch_t = std::span<event_ptr_t>;
+    using event_callback_t = std::function<void(event_batch_t)>;
+
+    // Invoked with the action ID of each request that stops being outstanding, whether it completed, failed, timed out
+    // or was closed.
+    using retired_callback_t = std::function<void(std::string const &)>;
 
     // The following are typedefs for used by the promise/future interface when returning AMI events in a
     // synchronous manner.
@@ -54,6 +78,17 @@ public:
     using reaction_ptr_t = std::unique_ptr<reaction_t const>;
     using pipe_t = std::promise<reaction_ptr_t>;
 
+    // Completion handlers receive the reaction directly from the dispatcher without a promise/future pair. On failure
+    // the reaction is null and the exception describes the error. A null reaction without an exception means the
+    // request was closed via set_null_on_pipe.
+    using completion_handler_t = std::function<void(reaction_ptr_t, std::exception_ptr)>;
+
+    // List item handlers receive the items of an EventList response as they arrive rather than having them buffered in
+    // the EventList until the list is complete.
+    using list_item_handler_t = std::function<void(event::Event const &)>;
+
+    using timeout_t = std::chrono::milliseconds;
+
 public:
     EventDispatcher() = delete;
     EventDispatcher(EventDispatcher const &) = delete;
@@ -63,7 +98,16 @@ public:
     ///        are received.
     ///
     /// @param callback Callback to invoke when new notification events are received.
-    explicit EventDispatcher(event_callback_t callback);
+    ///
+    /// Notification events are delivered in batches; \c callback is invoked once per work thread iteration with every
+    /// notification event drained from the incoming queue during that iteration. The callback may take ownership of
+    /// the events in the batch.
+    ///
+    /// @param retired Callback to invoke whenever a request stops being outstanding; invoked right before the request's
+    ///        pipe or handler is completed, with no locks held.
+    /// @param group Group whose threads service the dispatcher; the dispatcher starts its own threads if null.
+    explicit EventDispatcher(event_callback_t callback, retired_callback_t retired = {},
+        std::shared_ptr<DispatchGroup> group = {});
 
     virtual ~EventDispatcher();
 
@@ -80,13 +124,62 @@ public:
     /// @return \c future to receive response event on.
     ///
     /// @param action_id Action ID of an action.
+    /// @param timeout Amount of time the AMI server has to fulfill the request before the pipe is closed with a
+    ///        timeout exception. A zero timeout doesn't arm a deadline.
+    /// @param completion_event Name of the event that completes the request; empty if the response completes it. See
+    ///        \c action::Action::set_completion_event.
     ///
     /// This function can be used by a caller to create a new response event pipe that events can be returned on.
     /// Invoking this function using the action ID of the action to be sent to the AMI server will create a
     /// promise/future pipe pair that this object will use to send the response event back on. This allows the client
     /// application to behave in a more synchronous manner since all messages belonging to an action response appear to
     /// be immediately returned from the AMI server at once.
-    [[nodiscard]] std::future<reaction_ptr_t> get_event_pipe(std::string const &action_id);
+    ///
+    /// An exception is raised if a request with \c action_id is already outstanding; its response couldn't be told
+    /// apart from the one to this request.
+    ///
+    /// Deadlines are tracked in a timer wheel serviced by the response thread, so arming and cancelling a deadline is
+    /// O(1) no matter how many requests are outstanding. When a deadline lapses the pipe is closed with an exception and
+    /// any partially built EventList is freed.
+    [[nodiscard]] std::future<reaction_ptr_t> get_event_pipe(std::string const &action_id,
+        timeout_t timeout = timeout_t::zero(), std::string completion_event = {});
+
+    /// @brief Registers \c handler to be invoked with the response event for \c action_id.
+    ///
+    /// @return \c false if a request with \c action_id is already outstanding; the action mustn't be sent then.
+    ///
+    /// @param action_id Action ID of an action.
+    /// @param handler Handler invoked once the response is complete, has failed or has timed out.
+    /// @param timeout Amount of time the AMI server has to fulfill the request before \c handler is invoked with a
+    ///        timeout exception. A zero timeout doesn't arm a deadline.
+    /// @param completion_event Name of the event that completes the request; empty if the response completes it.
+    ///
+    /// This is the callback counterpart of \c get_event_pipe. No promise/future shared state is allocated; \c handler
+    /// is invoked on the response thread (or on the thread closing the request through \c set_exception_on_pipe or
+    /// \c set_null_on_pipe) with no locks held, so it may invoke further actions but shouldn't block.
+    ///
+    /// If a request with \c action_id is already outstanding, \c handler is invoked right away with an error and
+    /// nothing is registered.
+    bool add_completion_handler(std::string const &action_id, completion_handler_t handler,
+        timeout_t timeout = timeout_t::zero(), std::string completion_event = {});
+
+    /// @brief Registers \c handler to be invoked with the response event for \c action_id and \c item_handler to be
+    ///        invoked with each EventList item of the response as it arrives.
+    ///
+    /// @return \c false if a request with \c action_id is already outstanding; the action mustn't be sent then.
+    ///
+    /// @param action_id Action ID of an action.
+    /// @param item_handler Handler invoked with each EventList item.
+    /// @param handler Handler invoked once the response is complete, has failed or has timed out.
+    /// @param timeout Amount of time the AMI server has to fulfill the request before \c handler is invoked with a
+    ///        timeout exception. A zero timeout doesn't arm a deadline.
+    ///
+    /// Streamed items aren't kept; the EventList handed to \c handler only contains the head and tail events of the
+    /// list. Memory use therefore doesn't grow with the length of the list. Items are delivered in order on the
+    /// response thread, followed by the completion. As with \c add_completion_handler, a duplicate \c action_id is
+    /// handed to \c handler as an error.
+    bool add_streaming_handler(std::string const &action_id, list_item_handler_t item_handler,
+        completion_handler_t handler, timeout_t timeout = timeout_t::zero());
 
     /// @brief Sets an exception on a pipe.
     ///
@@ -112,7 +205,43 @@ public:
     /// be non-null.
     void set_null_on_pipe(std::string const &action_id);
 
+    /// @brief Closes the pipe of an action that was never sent with a null value, without telling the owner that the
+    ///        request retired.
+    ///
+    /// @param action_id Action ID of the pipe to withdraw.
+    void withdraw_pipe(std::string const &action_id);
+
+    /// @brief Conflates notification events of \c event_types, keeping only the newest event per event type and
+    ///        Uniqueid.
+    ///
+    /// @param event_types Event types to conflate, e.g. "Newexten", "VarSet" or "Newstate". An empty set disables
+    ///        conflation.
+    /// @param window Amount of time events are held back waiting for a newer event. A zero window only conflates the
+    ///        events drained in the same work thread iteration, that is while the consumer is behind.
+    ///
+    /// Conflation is off by default. Events of a channel are still dispatched in order; see \c event::EventConflater.
+    void set_conflation(std::unordered_set<std::string> event_types, timeout_t window = timeout_t::zero());
+
+    /// @brief Returns the counters of the conflation stage.
+    ///
+    /// @return Conflation metrics.
+    event::EventConflater::Metrics get_conflation_metrics() const;
+
 private:
+    friend class DispatchGroup;
+
+    ///
+    /// @struct Pending
+    ///
+    /// @brief Bookkeeping for a request that is waiting on a response from the AMI server.
+    ///
+    struct Pending {
+        std::variant<pipe_t, completion_handler_t> sink;        ///< Promise end of the pipe or handler the response is returned on.
+        std::optional<util::TimerWheel::handle_t> timer;        ///< Deadline for the request, if one was armed.
+        std::shared_ptr<list_item_handler_t const> items;       ///< Handler EventList items are streamed to, if any.
+        std::string completion_event;                           ///< Event completing the request; empty if the response completes it.
+    };
+
     /// @brief Starts the work thread.
     void start_work_thread();
 
@@ -121,14 +250,55 @@ private:
 
     /// @brief Work thread for this object.
     ///
-    /// This thread is responsible for parsing incoming Events messages and dispatching them to the \c dispatch_
-    /// function or returning events via promise/future pipes to awaiting AMI clients.
+    /// This thread is responsible for parsing incoming notification event messages and dispatching them to the
+    /// \c dispatch_ function.
     void work_thread();
 
+    /// @brief Response thread for this object.
+    ///
+    /// This thread is responsible for parsing incoming response event messages and returning them via promise/future
+    /// pipes or completion handlers to awaiting AMI clients. It also closes requests whose deadline has lapsed.
+    void response_thread();
+
+    /// @brief Dispatches the notification events queued so far and releases the conflated events whose window lapsed.
+    void service_events();
+
+    /// @brief Dispatches the notification events still queued at shutdown, including the conflated ones.
+    void finish_events();
+
+    /// @brief Dispatches the responses queued so far and closes the requests whose deadline has lapsed.
+    void service_responses();
+
+    /// @brief Dispatches the responses still queued at shutdown.
+    void finish_responses();
+
+    /// @brief Wakes whichever thread services notification events. Caller must hold \c events_mutex_.
+    void notify_events();
+
+    /// @brief Wakes whichever thread services responses. Caller must hold \c responses_mutex_.
+    void notify_responses();
+
     /// @brief Dispatches an AMI message in string format.
     ///
+    /// @return Notification event to dispatch to the \c dispatch_ function; nullptr if the message was a response
+    ///         event.
+    ///
     /// @param event_buf String containing an AMI string event.
-    void dispatch_event(std::string event_buf);
+    event_ptr_t dispatch_event(std::string event_buf);
+
+    /// @brief Dispatches AMI messages in string format, handing notification events to the \c dispatch_ function in a
+    ///        single batch.
+    ///
+    /// @param event_bufs Strings containing AMI string events.
+    /// @param batch Scratch collection used to build the batch of notification events.
+    void dispatch_events(std::vector<std::string> &event_bufs, std::vector<event_ptr_t> &batch);
+
+    /// @brief Dispatches AMI response messages in string format. Messages whose request was retired before they could
+    ///        be dispatched are handed to the work thread as notification events.
+    ///
+    /// @param event_bufs Strings containing AMI string events.
+    /// @param strays Scratch collection used to collect messages that turned out to be notification events.
+    void dispatch_responses(std::vector<std::string> &event_bufs, std::vector<event_ptr_t> &strays);
 
     /// @brief Dispatches a response event.
     ///
@@ -144,17 +314,79 @@ private:
     /// function will also free any memory allocated for working multipart response events.
     void cleanup_object();
 
-    std::vector<std::string> events_;                           ///< Events received from AMI.
+    /// @brief Adds \c pending to the collection of requests waiting on a response and arms its deadline.
+    ///
+    /// @return \c false if a request with \c action_id is already outstanding; \c pending is left untouched then.
+    ///
+    /// @param action_id Action ID of the request.
+    /// @param pending Request to add.
+    /// @param timeout Deadline for the request. A zero timeout doesn't arm a deadline.
+    bool add_pending(std::string const &action_id, Pending &pending, timeout_t timeout);
+
+    /// @brief Hands the error of a duplicate \c action_id to the handler of \c pending, which was never added.
+    ///
+    /// @return \c false, for the caller to return.
+    ///
+    /// @param action_id Action ID of the request.
+    /// @param pending Request that was rejected.
+    static bool reject(std::string const &action_id, Pending &pending);
+
+    /// @brief Removes the request for \c action_id along with any working EventList. Caller must hold
+    ///        \c pending_map_mutex_ and \c event_map_mutex_.
+    ///
+    /// @return The removed request, or std::nullopt if nothing was waiting on \c action_id.
+    ///
+    /// @param action_id Action ID of the request to remove.
+    std::optional<Pending> retire(std::string const &action_id);
+
+    /// @brief Delivers \c reaction or \c err to the pipe or handler of \c pending.
+    ///
+    /// @param action_id Action ID of the retired request.
+    /// @param pending Retired request to complete.
+    /// @param reaction Response for the request.
+    /// @param err Error for the request; takes precedence over \c reaction.
+    void complete(std::string const &action_id, Pending &pending, reaction_ptr_t reaction,
+        std::exception_ptr const &err);
+
+    /// @brief Cancels the deadline armed for \c pending, if any. Caller must hold \c pending_map_mutex_.
+    ///
+    /// @param pending Request to cancel the deadline for.
+    void disarm(Pending &pending);
+
+    /// @brief Closes the pipes of all requests whose deadline has lapsed with a timeout exception.
+    void expire_timers();
+
+    event::EventPool event_pool_{ 1024 };                       ///< Pool dispatched events are recycled through. Outlives the work thread.
+
+    std::vector<std::string> event_bufs_;                       ///< Scratch collection of notification events being dispatched. Used by the work thread.
+    std::vector<event_ptr_t> batch_;                            ///< Scratch collection used to build batches of notification events. Used by the work thread.
+    std::vector<std::string> response_bufs_;                    ///< Scratch collection of responses being dispatched. Used by the response thread.
+    std::vector<event_ptr_t> response_strays_;                  ///< Scratch collection of responses that turned out to be notification events. Used by the response thread.
+
+    std::vector<std::string> events_;                           ///< Notification events received from AMI.
+    std::vector<event_ptr_t> strays_;                           ///< Parsed notification events handed over by the response thread.
     std::mutex events_mutex_;                                   ///< Mutex controlling access to event collection.
 
+    std::vector<std::string> responses_;                        ///< Response events received from AMI.
+    std::mutex responses_mutex_;                                ///< Mutex controlling access to response collection.
+
+    std::shared_ptr<DispatchGroup> group_;                      ///< Group servicing the dispatcher instead of its own threads, if any.
     std::thread thread_;                                        ///< Handle to working thread.
-    std::atomic<bool> thread_run_{ false };                     ///< Flag to stop working thread.
+    std::thread responder_;                                     ///< Handle to response thread.
+    std::atomic<bool> thread_run_{ false };                     ///< Flag to stop working and response threads.
     std::condition_variable thread_cv_;                         ///< Condition variable used to wake working thread on receipt of new events.
+    std::condition_variable responder_cv_;                      ///< Condition variable used to wake response thread on receipt of new responses or deadlines.
+
+    event::EventConflater conflater_;                           ///< Conflation stage for notification events. Used by the work thread.
+
+    event_callback_t dispatch_{ [](event_batch_t) -> void {} }; ///< Dispatch function to call on batches of non-response events.
+    retired_callback_t retired_{ [](std::string const &) -> void {} };  ///< Function to call when a request stops being outstanding.
 
-    event_callback_t dispatch_{ [](event_ptr_t) -> void {} };   ///< Dispatch function to call on non-response events.
+    std::unordered_map<std::string, Pending> pending_map_;     ///< Pending requests to return events on.
+    std::mutex pending_map_mutex_;                              ///< Mutex to control access to pending request collection.
 
-    std::unordered_map<std::string, pipe_t> promise_map_;       ///< Promise map to return events on.
-    std::mutex promise_map_mutex_;                              ///< Mutex to control access to promise collection.
+    util::TimerWheel timers_{ timeout_t{ 10 } };                ///< Deadlines for pending requests. Guarded by \c pending_map_mutex_.
+    std::atomic<bool> timers_armed_{ false };                   ///< Flag indicating that \c timers_ has deadlines to service.
 
     std::unordered_map<std::string, std::unique_ptr<reaction::EventList>> event_map_;   ///< Event map to store working events in. Some events are made up of multiple event messages; in-progress messages are stored here until ready for dispatch.
     std::mutex event_map_mutex_;                                ///< Mutex to control access to in-progress event collection.
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_INVOKE_AWAITABLE_HPP
+#define AMI_INVOKE_AWAITABLE_HPP
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/EventDispatcher.hpp"
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <stop_token>
+
+namespace cpp_ami {
+
+class Connection;
+
+///
+/// @class InvokeAwaitable
+///
+/// @brief Awaitable returned by \c Connection::invoke_async that suspends a coroutine until the reaction to an action
+///        has been received.
+///
+/// The action is sent when the awaitable is awaited. The coroutine is resumed with the reaction once the event
+/// dispatcher completes it, on the executor the awaitable was created with. If no executor was provided the coroutine
+/// is resumed inline on the thread that completed the reaction (normally the event dispatcher response thread), in
+/// which case the coroutine shouldn't make blocking calls on the connection before its next suspension point.
+///
+/// Awaiting the object raises an exception if the action timed out. If cancellation was requested through the stop
+/// token, the coroutine is resumed with a null reaction, mirroring \c EventDispatcher::set_null_on_pipe.
+///
+class InvokeAwaitable {
+public:
+    using reaction_ptr_t = EventDispatcher::reaction_ptr_t;
+    using executor_t = std::function<void(std::function<void()>)>;
+
+public:
+    InvokeAwaitable() = delete;
+    InvokeAwaitable(InvokeAwaitable const &) = delete;
+    InvokeAwaitable(InvokeAwaitable &&) noexcept = delete;
+
+    /// @brief Constructs an awaitable that will send \c action over \c connection when awaited.
+    ///
+    /// @param connection Connection to send \c action over.
+    /// @param action Action to send to the AMI server.
+    /// @param executor Executor to resume the awaiting coroutine on. An empty executor resumes the coroutine inline.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the request. A zero timeout waits
+    ///        indefinitely.
+    /// @param stop_token Token used to cancel the request.
+    explicit InvokeAwaitable(Connection const &connection, action::Action action, executor_t executor,
+        std::chrono::milliseconds timeout, std::stop_token stop_token);
+
+    virtual ~InvokeAwaitable() = default;
+
+    InvokeAwaitable& operator=(InvokeAwaitable const &) = delete;
+    InvokeAwaitable& operator=(InvokeAwaitable &&) noexcept = delete;
+
+    /// @brief Returns \c true if the request was cancelled before it was sent.
+    ///
+    /// @return \c true if the awaiting coroutine doesn't need to be suspended.
+    bool await_ready() const noexcept;
+
+    /// @brief Sends the action and suspends the awaiting coroutine until the reaction has been received.
+    ///
+    /// @return \c false if the reaction was received before the coroutine could be suspended.
+    ///
+    /// @param handle Handle of the awaiting coroutine.
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    /// @brief Returns the reaction to the action.
+    ///
+    /// @return Reaction to the action; nullptr if the request was cancelled.
+    reaction_ptr_t await_resume();
+
+private:
+    /// @brief Completes the request with \c reaction or \c err and resumes the awaiting coroutine.
+    ///
+    /// @param reaction Reaction to the action.
+    /// @param err Error raised while waiting for the reaction.
+    void complete(reaction_ptr_t reaction, std::exception_ptr err);
+
+    Connection const &connection_;          ///< Connection the action is sent over.
+    action::Action action_;                 ///< Action to send.
+    executor_t executor_;                   ///< Executor the awaiting coroutine is resumed on.
+    std::chrono::milliseconds timeout_;     ///< Amount of time to wait for the reaction.
+    std::stop_token stop_token_;            ///< Token used to cancel the request.
+
+    std::optional<std::stop_callback<std::function<void()>>> stop_callback_;    ///< Cancels the request once stop is requested.
+
+    std::coroutine_handle<> handle_;        ///< Handle of the awaiting coroutine.
+    std::atomic<bool> ready_{ false };      ///< Set by whichever of await_suspend or complete finishes last; the other resumes the coroutine.
+    reaction_ptr_t reaction_;               ///< Reaction to the action.
+    std::exception_ptr err_;                ///< Error raised while waiting for the reaction.
+};
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_ORIGINATE_ENGINE_HPP
+#define AMI_ORIGINATE_ENGINE_HPP
+
+#include "c++ami/action/Originate.hpp"
+#include "c++ami/EventDispatcher.hpp"
+#include "c++ami/util/TokenBucket.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+class Connection;
+
+///
+/// @class OriginateEngine
+///
+/// @brief Places calls with asynchronous \c Originate actions at a bounded rate and concurrency.
+///
+/// Originations are queued with \c submit and sent by a single scheduling thread as long as the calls-per-second token
+/// bucket has a token and fewer than the maximum number of originations are in flight. An origination stays in flight
+/// until the AMI server reports its outcome with an OriginateResponse event, which is correlated by ActionID through
+/// the event dispatcher; no thread waits on an origination, so thread usage doesn't depend on the number in flight.
+///
+/// Outcomes are queued on a completion stream in the order they are reported and read with \c next.
+///
+class OriginateEngine {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using reaction_ptr_t = EventDispatcher::reaction_ptr_t;
+
+    ///
+    /// @struct Options
+    ///
+    /// @brief Limits of the engine.
+    ///
+    struct Options {
+        double calls_per_second{ 10.0 };                        ///< Number of originations sent per second.
+        size_t burst{ 1 };                                      ///< Number of originations that may be sent back to back after an idle period.
+        size_t max_concurrent{ 100 };                           ///< Maximum number of originations in flight; 0 means unlimited.
+        std::chrono::milliseconds timeout{ std::chrono::seconds(60) };  ///< Amount of time the AMI server has to report the outcome of an origination.
+    };
+
+    ///
+    /// @struct Result
+    ///
+    /// @brief Outcome of an origination.
+    ///
+    struct Result {
+        std::string action_id;                  ///< Action ID of the Originate action.
+        bool success{ false };                  ///< Flag indicating that the call was answered.
+        reaction_ptr_t reaction;                ///< OriginateResponse event, or the error response if the action was rejected; null on failure.
+        std::exception_ptr error;               ///< Reason the outcome wasn't reported, e.g. a timeout; null otherwise.
+        clock_t::duration latency{ 0 };         ///< Amount of time between sending the action and its outcome.
+    };
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Snapshot of the state of the engine.
+    ///
+    struct Metrics {
+        size_t queued{ 0 };                     ///< Number of originations waiting to be sent.
+        size_t in_flight{ 0 };                  ///< Number of originations sent whose outcome hasn't been reported.
+        size_t completed{ 0 };                  ///< Number of outcomes waiting to be read from the completion stream.
+        uint64_t sent{ 0 };                     ///< Total number of originations sent.
+        uint64_t succeeded{ 0 };                ///< Total number of originations that were answered.
+        uint64_t failed{ 0 };                   ///< Total number of originations that failed, were rejected or timed out.
+    };
+
+public:
+    OriginateEngine() = delete;
+    OriginateEngine(OriginateEngine const &) = delete;
+    OriginateEngine(OriginateEngine &&) noexcept = delete;
+
+    /// @brief Constructs an engine placing calls over \c connection and starts its scheduling thread.
+    ///
+    /// @param connection Connection to send originations over. Must outlive the engine.
+    /// @param options Limits of the engine.
+    ///
+    /// An std::invalid_argument exception is raised if the rate isn't positive or the burst is 0.
+    OriginateEngine(Connection &connection, Options const &options);
+
+    /// @brief Stops the scheduling thread. Queued originations are discarded; originations in flight are cancelled.
+    virtual ~OriginateEngine();
+
+    OriginateEngine& operator=(OriginateEngine const &) = delete;
+    OriginateEngine& operator=(OriginateEngine &&) noexcept = delete;
+
+    /// @brief Queues \c originate to be sent once the limits allow it.
+    ///
+    /// @return Action ID the outcome is reported under.
+    ///
+    /// @param originate Origination to place.
+    std::string submit(action::Originate originate);
+
+    /// @brief Returns the next outcome from the completion stream, waiting up to \c timeout for one to be reported.
+    ///
+    /// @return Next outcome; nothing if none was reported in time.
+    ///
+    /// @param timeout Maximum amount of time to wait.
+    std::optional<Result> next(std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero());
+
+    /// @brief Blocks until every queued origination has been sent and its outcome reported.
+    void wait_idle();
+
+    /// @brief Changes the calls-per-second rate, burst and concurrency limits. Originations in flight aren't affected.
+    ///
+    /// @param options New limits; the timeout only applies to originations sent from now on.
+    ///
+    /// An std::invalid_argument exception is raised, and the limits left unchanged, if the rate isn't positive or the
+    /// burst is 0.
+    void set_options(Options const &options);
+
+    /// @brief Returns the counters of the engine.
+    ///
+    /// @return Engine metrics.
+    Metrics get_metrics() const;
+
+private:
+    ///
+    /// @struct Inflight
+    ///
+    /// @brief Origination waiting for its outcome.
+    ///
+    struct Inflight {
+        action::Originate action;               ///< Originate action sent; kept so that the request can be cancelled.
+        clock_t::time_point sent;               ///< Time the action was sent.
+    };
+
+    /// @brief Scheduling thread for this object.
+    void work_thread();
+
+    /// @brief Queues the outcome of the origination \c action_id on the completion stream.
+    ///
+    /// @param action_id Action ID of the origination.
+    /// @param reaction OriginateResponse event or error response.
+    /// @param err Error of the origination, if any.
+    void complete(std::string const &action_id, reaction_ptr_t reaction, std::exception_ptr const &err);
+
+    Connection *connection_;                                ///< Connection originations are sent over.
+    Options options_;                                       ///< Limits of the engine.
+    util::TokenBucket bucket_;                              ///< Calls-per-second limiter. Guarded by \c mutex_.
+
+    std::deque<action::Originate> queue_;                   ///< Originations waiting to be sent, oldest first.
+    std::unordered_map<std::string, Inflight> in_flight_;   ///< Originations in flight keyed by Action ID.
+    std::deque<Result> completed_;                          ///< Outcomes waiting to be read, oldest first.
+    Metrics metrics_;                                       ///< Counters of the engine.
+    mutable std::mutex mutex_;                              ///< Mutex to control access to the queues and limits.
+    std::condition_variable schedule_cv_;                   ///< Condition variable used to wake the scheduling thread.
+    std::condition_variable completed_cv_;                  ///< Condition variable used to wake readers of the completion stream.
+    bool run_{ true };                                      ///< Flag to stop the scheduling thread. Guarded by \c mutex_.
+    std::thread thread_;                                    ///< Handle to scheduling thread.
+};
+
+}
+
+#endif
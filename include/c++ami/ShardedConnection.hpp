@@ -0,0 +1,285 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_SHARDED_CONNECTION_HPP
+#define AMI_SHARDED_CONNECTION_HPP
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/DispatchGroup.hpp"
+#include "c++ami/util/LatencyHistogram.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_ami {
+
+namespace net {
+class SocketPoller;
+}
+
+///
+/// @class ShardedConnection
+///
+/// @brief Several authenticated AMI sessions to one server behind the interface of a single connection.
+///
+/// The AMI server works through the actions of a session one at a time, so a single session caps action throughput
+/// at its round-trip rate. This object logs in the given number of sessions and sends each action over the session
+/// with the fewest actions outstanding, so independent actions are worked on in parallel.
+///
+/// Notification events are only enabled on the first session; event callbacks are added to that session, so every
+/// event is seen once. Responses are still read back on the session the action was sent over. Sessions share one
+/// poller thread and one dispatch group, so the object runs three threads regardless of the number of sessions.
+///
+/// Idempotent actions with a tight latency budget can be sent with \c invoke_hedged: if the session picked is slow to
+/// answer, the action is sent again over another session and whichever answers first wins. The other copy still
+/// occupies its session until it is answered, and its latency is observed all the same.
+///
+class ShardedConnection {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using reaction_ptr_t = Connection::reaction_ptr_t;
+    using completion_handler_t = Connection::completion_handler_t;
+    using list_item_handler_t = Connection::list_item_handler_t;
+    using event_callback_t = Connection::event_callback_t;
+    using event_batch_callback_t = Connection::event_batch_callback_t;
+    using event_callback_key_t = Connection::event_callback_key_t;
+
+    ///
+    /// @struct HedgePolicy
+    ///
+    /// @brief When \c invoke_hedged sends an action again.
+    ///
+    struct HedgePolicy {
+        double quantile{ 0.95 };                                ///< Quantile of the observed latencies of the action after which it is sent again.
+        std::chrono::milliseconds min_delay{ 1 };               ///< Least amount of time to wait before sending the action again.
+        std::chrono::milliseconds initial_delay{ 50 };          ///< Amount of time to wait while too few latencies of the action were observed.
+        size_t min_samples{ 20 };                               ///< Number of latencies of an action observed before their quantile is used.
+        std::chrono::milliseconds half_life{ std::chrono::minutes(1) };    ///< Amount of time after which an observed latency counts half; zero keeps every latency for good.
+    };
+
+    ///
+    /// @struct HedgeMetrics
+    ///
+    /// @brief Counters of \c invoke_hedged.
+    ///
+    struct HedgeMetrics {
+        uint64_t invoked{ 0 };          ///< Actions sent with \c invoke_hedged.
+        uint64_t hedged{ 0 };           ///< Actions sent a second time.
+        uint64_t hedge_wins{ 0 };       ///< Actions whose second copy answered first.
+    };
+
+public:
+    ShardedConnection() = delete;
+    ShardedConnection(ShardedConnection const &) = delete;
+    ShardedConnection(ShardedConnection &&) noexcept = delete;
+
+    /// @brief Connects \c sessions sessions to \c port on the \c hostname machine and logs each of them in.
+    ///
+    /// @param hostname Hostname of the AMI server to attach to.
+    /// @param port Port number on the AMI server to attach to.
+    /// @param username Username to log in with.
+    /// @param secret Secret to log in with.
+    /// @param sessions Number of sessions; at least one.
+    /// @param timeout Amount of time the AMI server has to accept each login.
+    ///
+    /// An exception is raised if a session can't connect or log in.
+    ShardedConnection(std::string_view hostname, uint16_t port, std::string const &username, std::string const &secret,
+        size_t sessions, std::chrono::milliseconds const &timeout = std::chrono::seconds(5));
+
+    /// @brief Disconnects every session. Outstanding requests are closed.
+    virtual ~ShardedConnection();
+
+    ShardedConnection& operator=(ShardedConnection const &) = delete;
+    ShardedConnection& operator=(ShardedConnection &&) noexcept = delete;
+
+    /// @brief Returns the number of sessions.
+    ///
+    /// @return Number of sessions.
+    size_t size() const;
+
+    /// @brief Returns the session at \c index. Session 0 is the one notification events are enabled on.
+    ///
+    /// @return Session.
+    ///
+    /// @param index Index of the session, less than \c size.
+    Connection& get_session(size_t index) const;
+
+    /// @brief Returns the number of actions outstanding on each session.
+    ///
+    /// @return Outstanding actions, indexed by session.
+    std::vector<size_t> get_outstanding() const;
+
+    /// @brief Sends \c action over the session notification events are enabled on and immediately returns. As with a
+    ///        single connection, the response is handed to the event callbacks.
+    ///
+    /// @param action Action to send to the AMI server.
+    ///
+    /// The action isn't correlated with its response, so it doesn't count against the session.
+    void async_invoke(action::Action const &action) const;
+
+    /// @brief Sends \c action over the least busy session and immediately returns. \c handler is invoked with the
+    ///        resulting Event object.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param handler Handler to invoke with the resulting Event object or the error that occurred.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request. A zero timeout waits
+    ///        indefinitely.
+    void async_invoke(action::Action const &action, completion_handler_t handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Sends \c action over the least busy session and returns the resulting Event object. This call will
+    ///        block indefinitely until all of the event stream is read back from the socket.
+    ///
+    /// @param action Action to send to the AMI server.
+    reaction_ptr_t invoke(action::Action const &action) const;
+
+    /// @brief Sends \c action over the least busy session and returns the resulting Event object.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request.
+    reaction_ptr_t invoke(action::Action const &action, std::chrono::milliseconds const &timeout) const;
+
+    /// @brief Sends \c action over the least busy session, streams the items of the resulting EventList to
+    ///        \c item_handler and returns the EventList once it is complete.
+    ///
+    /// @return Resulting EventList (head and tail events only); nullptr if the request was cancelled.
+    ///
+    /// @param action Action to send to the AMI server.
+    /// @param item_handler Handler to invoke with each EventList item.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request. A zero timeout waits
+    ///        indefinitely.
+    reaction_ptr_t invoke(action::Action const &action, list_item_handler_t item_handler,
+        std::chrono::milliseconds const &timeout = std::chrono::milliseconds::zero()) const;
+
+    /// @brief Sends \c action over the least busy session and returns the resulting Event object. If it isn't answered
+    ///        within the hedge delay, the action is sent again over another session; the first reaction wins. The
+    ///        other copy counts against its session until it is answered or the timeout passes.
+    ///
+    /// @return Resulting Event object; nullptr if the request was cancelled.
+    ///
+    /// @param action Action to send to the AMI server. The AMI server may carry it out twice, so it must be
+    ///        idempotent, e.g. ExtensionState or Getvar.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request, hedge included.
+    ///
+    /// The hedge delay is the policy's quantile of the latencies observed for actions of the same name. An exception
+    /// is raised if neither copy is answered in time.
+    reaction_ptr_t invoke_hedged(action::Action const &action, std::chrono::milliseconds const &timeout) const;
+
+    /// @brief Changes when \c invoke_hedged sends an action again.
+    ///
+    /// @param policy Hedge policy.
+    void set_hedge_policy(HedgePolicy const &policy);
+
+    /// @brief Returns the counters of \c invoke_hedged.
+    ///
+    /// @return Hedge metrics.
+    HedgeMetrics get_hedge_metrics() const;
+
+    /// @brief Cancels an outstanding request for \c action, whichever session it was sent over.
+    ///
+    /// @param action Action to cancel the request for.
+    void cancel(action::Action const &action) const;
+
+    /// @brief Adds an event callback to the session notification events are enabled on.
+    ///
+    /// @return Callback ID.
+    ///
+    /// @param callback Callback to invoke.
+    event_callback_key_t add_callback(event_callback_t callback);
+
+    /// @brief Adds a batch event callback to the session notification events are enabled on.
+    ///
+    /// @return Callback ID.
+    ///
+    /// @param callback Callback to invoke.
+    event_callback_key_t add_batch_callback(event_batch_callback_t callback);
+
+    /// @brief Removes an event callback.
+    ///
+    /// @param id ID of callback to remove.
+    void remove_callback(event_callback_key_t const &id);
+
+private:
+    ///
+    /// @struct Shard
+    ///
+    /// @brief Session and the number of actions outstanding on it.
+    ///
+    struct Shard {
+        std::atomic<size_t> outstanding{ 0 };       ///< Number of correlated actions outstanding on the session.
+        std::unique_ptr<Connection> connection;     ///< Session. Goes first, as its outstanding handlers update \c outstanding.
+    };
+
+    ///
+    /// @struct Race
+    ///
+    /// @brief Copies of a hedged action racing for the first reaction.
+    ///
+    struct Race {
+        std::mutex mutex;                   ///< Mutex to control access to the race.
+        std::condition_variable cv;         ///< Condition variable used to wake the caller once the race is settled.
+        size_t running{ 0 };                ///< Number of copies not answered yet.
+        std::optional<size_t> winner;       ///< Copy whose reaction won, if any.
+        reaction_ptr_t reaction;            ///< Winning reaction.
+        std::exception_ptr error;           ///< First error of a copy, if no copy won.
+    };
+
+    /// @brief Picks the session with the fewest actions outstanding and counts an action against it.
+    ///
+    /// @return Session picked.
+    ///
+    /// @param exclude Session not to pick, if any.
+    Shard& acquire(Shard const *exclude = nullptr) const;
+
+    /// @brief Picks the session with the fewest actions outstanding.
+    ///
+    /// @return Session picked.
+    ///
+    /// @param exclude Session not to pick, if any.
+    Shard& least_outstanding(Shard const *exclude = nullptr) const;
+
+    /// @brief Sends \c action over \c shard, which it was already counted against; the count is released once
+    ///        \c handler is invoked.
+    ///
+    /// @param shard Session to send over.
+    /// @param action Action to send.
+    /// @param handler Handler to invoke with the resulting Event object or the error that occurred.
+    /// @param timeout Amount of time to wait for the AMI server to fulfill the event request.
+    void submit(Shard &shard, action::Action const &action, completion_handler_t handler,
+        std::chrono::milliseconds const &timeout) const;
+
+    /// @brief Returns the latency histogram of actions named \c name, creating it if needed.
+    ///
+    /// @return Latency histogram.
+    ///
+    /// @param name Action name.
+    util::LatencyHistogram& get_latencies(std::string const &name) const;
+
+    std::shared_ptr<net::SocketPoller> poller_;         ///< Poller reading the sockets of all sessions.
+    std::shared_ptr<DispatchGroup> group_;              ///< Dispatch group servicing the dispatchers of all sessions.
+    std::vector<std::unique_ptr<Shard>> shards_;        ///< Sessions; events are enabled on the first one.
+    mutable std::atomic<size_t> next_{ 0 };             ///< Session the next search starts at, so that ties rotate.
+
+    HedgePolicy hedge_policy_;                          ///< When \c invoke_hedged sends an action again. Guarded by \c hedge_mutex_.
+    mutable std::unordered_map<std::string, std::unique_ptr<util::LatencyHistogram>> latencies_;    ///< Observed latencies keyed by action name. Guarded by \c hedge_mutex_.
+    mutable std::mutex hedge_mutex_;                    ///< Mutex to control access to the hedge policy and histograms.
+    mutable std::atomic<uint64_t> invoked_{ 0 };        ///< Actions sent with \c invoke_hedged.
+    mutable std::atomic<uint64_t> hedged_{ 0 };         ///< Actions sent a second time.
+    mutable std::atomic<uint64_t> hedge_wins_{ 0 };     ///< Actions whose second copy answered first.
+    mutable std::unordered_map<std::string, action::Action> hedges_;   ///< Hedged actions with a copy outstanding, keyed by ActionID.
+    mutable std::mutex hedges_mutex_;                   ///< Mutex to control access to the hedged actions.
+};
+
+}
+
+#endif
@@ -8,7 +8,9 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -22,6 +24,12 @@ namespace cpp_ami {
 /// As messages data is read from the socket attached to the AMI server this class will build full message
 /// events and dispatch them to a callback function.
 ///
+/// The output of a Command action can be far larger than any other message, so it isn't buffered whole. Both the
+/// \c Output lines of current AMI servers and the raw \c --END \c COMMAND-- terminated output of older ones are
+/// turned into an EventList as they arrive: the response header starts the list, each batch of lines read from the
+/// socket is dispatched as a \c CommandOutput item (one \c Output header per line) and a \c CommandComplete event
+/// ends the list. Only the line being read is buffered, no matter how long the output is.
+///
 class StreamParser {
 public:
     using callback_t = std::function<void(std::string)>;
@@ -37,7 +45,9 @@ public:
     ///
     /// @param version_callback Callback that will be invoked when the AMI server version is received.
     /// @param callback Callback that will be invoked when AMI messages are received.
-    explicit StreamParser(version_callback_t version_callback, callback_t callback);
+    /// @param threaded Flag to parse on a worker thread; otherwise buffers are parsed by the thread adding them, which
+    ///        must always be the same one.
+    explicit StreamParser(version_callback_t version_callback, callback_t callback, bool threaded = true);
 
     virtual ~StreamParser();
 
@@ -71,13 +81,49 @@ private:
     /// are evaluated.
     void process_chunk(std::string stream_chunk);
 
+    ///
+    /// @struct CommandOutput
+    ///
+    /// @brief Command response whose output is being streamed.
+    ///
+    struct CommandOutput {
+        std::string action_id;      ///< Action ID of the Command action.
+        bool legacy{ false };       ///< Flag indicating raw output terminated by --END COMMAND-- rather than Output lines.
+        std::string batch;          ///< Output lines read but not dispatched yet, as Output headers.
+        size_t items{ 0 };          ///< Number of CommandOutput items dispatched so far.
+    };
+
+    /// @brief Starts streaming the message at \c msg_beg if it is a successful Command response with output.
+    ///
+    /// @return \c true if the message is a Command response; \c msg_beg is moved to the first line of output.
+    ///
+    /// @param msg_beg Position of the message in \c event_buf_.
+    /// @param eom_loc Position of the end-of-message sequence of the message in \c event_buf_, if it was read.
+    bool start_command(size_t &msg_beg, size_t eom_loc);
+
+    /// @brief Reads the output lines of the streamed Command response starting at \c msg_beg.
+    ///
+    /// @return \c true once the end of the output was read; \c false if more data is needed.
+    ///
+    /// @param msg_beg Position of the next output line in \c event_buf_; moved past the lines read.
+    bool stream_command(size_t &msg_beg);
+
+    /// @brief Adds \c line to the output batch of the streamed Command response.
+    ///
+    /// @param line Line of output.
+    void add_command_output(std::string_view line);
+
+    /// @brief Dispatches the output batch of the streamed Command response as a CommandOutput item.
+    void flush_command_output();
+
     bool first_event_{ true };      ///< Flag indicating if a received chunk is the first message part. The first message will contain the AMI version string.
     std::string event_buf_;         ///< Working event buffer. Partial AMI events are concatenated to this string to build up a complete message.
+    std::optional<CommandOutput> command_;  ///< Command response whose output is being streamed, if any.
 
     std::vector<std::string> stream_chunks_;    ///< Collection of stream chunks to process.
     std::mutex stream_chunks_mutex_;            ///< Mutex to control access to collection of stream chunks.
 
-    std::thread thread_;                        ///< Handle to worker thread.
+    std::thread thread_;                        ///< Handle to worker thread, if any.
     std::atomic<bool> thread_run_{ false };     ///< Flag to stop worker thread.
     std::condition_variable thread_cv_;         ///< Condition flag to wake sleeping thread when new message chunks have arrived for processing.
 
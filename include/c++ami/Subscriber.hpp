@@ -0,0 +1,148 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_SUBSCRIBER_HPP
+#define AMI_SUBSCRIBER_HPP
+
+#include "c++ami/util/KeyValDict.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+///
+/// @class Subscriber
+///
+/// @brief Delivers notification events to a callback from a bounded queue serviced by a dedicated thread.
+///
+/// Regular event callbacks run back to back on the event dispatcher thread, so a slow callback delays every other
+/// consumer of the connection. A subscriber decouples its callback from the dispatcher: events are queued by the
+/// dispatcher and delivered by the subscriber's own thread. What happens when the queue is full is determined by the
+/// subscriber's overflow policy.
+///
+class Subscriber {
+public:
+    using event_t = util::KeyValDict;
+    using event_ptr_t = std::shared_ptr<event_t const>;
+    using callback_t = std::function<void(event_t const *)>;
+    using conflate_key_t = std::function<std::string(event_t const &)>;
+    using clock_t = std::chrono::steady_clock;
+
+    ///
+    /// @enum Overflow
+    ///
+    /// @brief What to do with events that arrive while the queue is full.
+    ///
+    enum class Overflow : uint8_t {
+        block,      ///< Wait for room in the queue; stalls the event dispatcher (and every other consumer) meanwhile.
+        drop,       ///< Discard the incoming event.
+        conflate,   ///< Replace the newest queued event with the same conflation key, or discard the oldest queued event.
+    };
+
+    ///
+    /// @struct Options
+    ///
+    /// @brief Subscription options.
+    ///
+    struct Options {
+        size_t capacity{ 1024 };                    ///< Maximum number of queued events.
+        Overflow overflow{ Overflow::block };       ///< Overflow policy.
+        conflate_key_t conflate_key;                ///< Conflation key of an event; defaults to its Event and Uniqueid. Events with an empty key are never merged.
+        std::string thread_name{ "ami_subscriber" };    ///< Name of the delivery thread; at most 15 characters.
+    };
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Snapshot of the state of the subscriber.
+    ///
+    struct Metrics {
+        size_t queued{ 0 };                         ///< Number of events currently queued.
+        size_t high_water{ 0 };                     ///< Largest number of events ever queued.
+        uint64_t delivered{ 0 };                    ///< Total number of events delivered to the callback.
+        uint64_t dropped{ 0 };                      ///< Total number of events discarded because the queue was full.
+        uint64_t conflated{ 0 };                    ///< Total number of queued events replaced by a newer event.
+        std::chrono::nanoseconds lag{ 0 };          ///< Amount of time the oldest queued event has been waiting.
+        std::chrono::nanoseconds max_lag{ 0 };      ///< Longest amount of time a delivered event waited in the queue.
+    };
+
+public:
+    Subscriber() = delete;
+    Subscriber(Subscriber const &) = delete;
+    Subscriber(Subscriber &&) noexcept = delete;
+
+    /// @brief Constructs an object delivering events to \c callback according to \c options.
+    ///
+    /// @param callback Callback to invoke on each event.
+    /// @param options Subscription options.
+    explicit Subscriber(callback_t callback, Options options);
+
+    /// @brief Delivers the events that are still queued and stops the delivery thread. Must not be invoked from the
+    ///        subscriber's own callback.
+    virtual ~Subscriber();
+
+    Subscriber& operator=(Subscriber const &) = delete;
+    Subscriber& operator=(Subscriber &&) noexcept = delete;
+
+    /// @brief Queues \c events for delivery, applying the overflow policy to events that don't fit.
+    ///
+    /// @param events Events to queue.
+    void push(std::span<event_ptr_t const> events);
+
+    /// @brief Returns a snapshot of the queue depth, counters and lag of the subscriber.
+    ///
+    /// @return Subscriber metrics.
+    Metrics get_metrics() const;
+
+private:
+    ///
+    /// @struct Entry
+    ///
+    /// @brief Queued event.
+    ///
+    struct Entry {
+        event_ptr_t event;              ///< Event to deliver.
+        std::string key;                ///< Conflation key of the event; only set for keyed events of conflating subscribers.
+        clock_t::time_point queued;     ///< Time the event was first queued.
+    };
+
+    /// @brief Delivery thread for this object.
+    void work_thread();
+
+    /// @brief Queues \c event, applying the overflow policy if the queue is full. Caller must hold \c mutex_.
+    ///
+    /// @param event Event to queue.
+    /// @param now Time the event is queued.
+    void enqueue(event_ptr_t const &event, clock_t::time_point now);
+
+    /// @brief Removes the oldest queued event. Caller must hold \c mutex_.
+    void pop_front();
+
+    callback_t callback_;                       ///< Callback to deliver events to.
+    Options options_;                           ///< Subscription options.
+
+    std::deque<Entry> queue_;                   ///< Queued events.
+    uint64_t head_seq_{ 0 };                    ///< Sequence number of the event at the front of \c queue_.
+    std::unordered_map<std::string, uint64_t> keys_;    ///< Sequence number of the newest queued event for each conflation key.
+
+    Metrics metrics_;                           ///< Counters; \c queued and \c lag are computed on demand.
+
+    mutable std::mutex mutex_;                  ///< Mutex to control access to the queue and counters.
+    std::condition_variable ready_cv_;          ///< Condition variable used to wake the delivery thread.
+    std::condition_variable room_cv_;           ///< Condition variable used to wake a blocked producer.
+    bool run_{ true };                          ///< Flag to stop the delivery thread. Guarded by \c mutex_.
+    std::thread thread_;                        ///< Handle to delivery thread.
+};
+
+}
+
+#endif
@@ -6,12 +6,22 @@
 
 #include "c++ami/util/KeyValDict.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace cpp_ami::action {
 
 class Action
     : public util::KeyValDict {
+public:
+    /// Scheduling class used when actions are waiting to be admitted to the AMI server. Urgent actions are sent ahead
+    /// of normal actions, which are sent ahead of bulk actions. The priority isn't sent to the AMI server.
+    enum class Priority : uint8_t {
+        urgent,
+        normal,
+        bulk,
+    };
+
 public:
     Action() = delete;
     Action(Action const &) = default;
@@ -27,11 +37,26 @@ public:
     std::string get_action() const;
     std::string get_action_id() const;
 
+    Priority get_priority() const;
+    void set_priority(Priority priority);
+
+    /// @brief Returns the name of the event that completes the action; empty if the response completes it.
+    std::string const& get_completion_event() const;
+
+    /// @brief Makes the action complete on the event named \c event carrying its ActionID rather than on the response.
+    ///        The response then only acknowledges the action, unless it is an error. Used by actions such as an
+    ///        asynchronous Originate whose outcome is reported by a later event. The name isn't sent to the AMI server.
+    ///
+    /// @param event Name of the completing event, e.g. OriginateResponse; empty to complete on the response.
+    void set_completion_event(std::string event);
+
     std::string to_string() const override;
 
 private:
     std::string action_;
     std::string action_id_;
+    Priority priority_{ Priority::normal };
+    std::string completion_event_;
 };
 
 }
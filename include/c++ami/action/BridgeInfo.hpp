@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_BRIDGEINFO_HPP
+#define ACTION_BRIDGEINFO_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class BridgeInfo
+    : public Action {
+public:
+    explicit BridgeInfo(std::string bridge_uniqueid);
+};
+
+}
+
+#endif
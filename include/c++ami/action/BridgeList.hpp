@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_BRIDGELIST_HPP
+#define ACTION_BRIDGELIST_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class BridgeList
+    : public Action {
+public:
+    BridgeList();
+};
+
+}
+
+#endif
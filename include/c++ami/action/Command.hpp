@@ -0,0 +1,21 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_COMMAND_HPP
+#define ACTION_COMMAND_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+/// Runs a CLI command. The output is returned as an EventList of CommandOutput items whose Output value holds a batch
+/// of output lines separated by line feeds; invoke it with a list item handler to receive the output as it is read.
+class Command
+    : public Action {
+public:
+    explicit Command(std::string command);
+};
+
+}
+
+#endif
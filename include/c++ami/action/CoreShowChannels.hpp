@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_CORESHOWCHANNELS_HPP
+#define ACTION_CORESHOWCHANNELS_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class CoreShowChannels
+    : public Action {
+public:
+    CoreShowChannels();
+};
+
+}
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_DBDEL_HPP
+#define ACTION_DBDEL_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class DBDel
+    : public Action {
+public:
+    DBDel(std::string family, std::string key);
+};
+
+}
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_DBGET_HPP
+#define ACTION_DBGET_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class DBGet
+    : public Action {
+public:
+    DBGet(std::string family, std::string key);
+};
+
+}
+
+#endif
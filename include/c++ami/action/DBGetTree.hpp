@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_DBGETTREE_HPP
+#define ACTION_DBGETTREE_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class DBGetTree
+    : public Action {
+public:
+    DBGetTree(std::string family);
+};
+
+}
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_DBPUT_HPP
+#define ACTION_DBPUT_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class DBPut
+    : public Action {
+public:
+    DBPut(std::string family, std::string key, std::string val);
+};
+
+}
+
+#endif
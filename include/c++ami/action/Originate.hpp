@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_ORIGINATE_HPP
+#define ACTION_ORIGINATE_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class Originate
+    : public Action {
+public:
+    explicit Originate(std::string channel);
+};
+
+}
+
+#endif
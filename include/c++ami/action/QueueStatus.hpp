@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_QUEUESTATUS_HPP
+#define ACTION_QUEUESTATUS_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class QueueStatus
+    : public Action {
+public:
+    QueueStatus();
+};
+
+}
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef ACTION_QUEUESUMMARY_HPP
+#define ACTION_QUEUESUMMARY_HPP
+
+#include "c++ami/action/Action.hpp"
+
+namespace cpp_ami::action {
+
+class QueueSummary
+    : public Action {
+public:
+    QueueSummary();
+};
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_ASTDB_CACHE_HPP
+#define AMI_CACHE_ASTDB_CACHE_HPP
+
+#include "c++ami/util/KeyValDict.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class AstDbCache
+///
+/// @brief Client-side cache of the Asterisk database (AstDB) with read-through lookups and write-behind updates.
+///
+/// A key that isn't cached is read from the AMI server with \c DBGet on its first lookup; later lookups are answered
+/// from memory. Keys that don't exist are cached as such. Concurrent lookups of a key that isn't cached share a single
+/// query. \c warm loads a whole family with a single \c DBGetTree.
+///
+/// \c put and \c del update the cache right away and queue the write for a background thread, so callers don't wait
+/// for a round trip. Queued writes to the same key are coalesced into the newest one, and the writer pipelines up to a
+/// batch of \c DBPut/\c DBDel actions in a single socket write. A write the AMI server rejects drops the key from the
+/// cache so that its next lookup reads it back.
+///
+/// The AMI server doesn't report changes to the database, so changes made by other clients are only seen once the key
+/// is invalidated.
+///
+class AstDbCache {
+public:
+    using value_t = std::optional<std::string>;
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Counters of the cache.
+    ///
+    struct Metrics {
+        uint64_t hits{ 0 };         ///< Lookups answered from the cache.
+        uint64_t misses{ 0 };       ///< Lookups read from the AMI server.
+        uint64_t writes{ 0 };       ///< Writes queued by \c put and \c del.
+        uint64_t coalesced{ 0 };    ///< Writes superseded by a newer write to the same key before they were sent.
+        uint64_t batches{ 0 };      ///< Batches of writes sent to the AMI server.
+        uint64_t failures{ 0 };     ///< Writes rejected by the AMI server or lost.
+        size_t pending{ 0 };        ///< Writes waiting to be sent.
+        size_t entries{ 0 };        ///< Number of cached keys.
+    };
+
+public:
+    AstDbCache(AstDbCache const &) = delete;
+    AstDbCache(AstDbCache &&) noexcept = delete;
+
+    /// @brief Constructs a detached cache. A detached cache only holds what is stored through \c load, \c put and
+    ///        \c del; it neither reads nor writes the database.
+    AstDbCache() = default;
+
+    /// @brief Constructs a cache attached to \c connection and starts its writer thread.
+    ///
+    /// @param connection Connection to read and write the database over. Must outlive the cache.
+    /// @param timeout Amount of time the AMI server has to fulfill a read or a write.
+    /// @param max_batch Maximum number of writes sent in a single socket write.
+    explicit AstDbCache(Connection &connection, std::chrono::milliseconds const &timeout = std::chrono::seconds(5),
+        size_t max_batch = 64);
+
+    /// @brief Sends the queued writes and stops the writer thread.
+    virtual ~AstDbCache();
+
+    AstDbCache& operator=(AstDbCache const &) = delete;
+    AstDbCache& operator=(AstDbCache &&) noexcept = delete;
+
+    /// @brief Returns the value of \c key in \c family, reading it from the AMI server if it isn't cached.
+    ///
+    /// @return Value of the key; nothing if the key doesn't exist.
+    ///
+    /// @param family Database family.
+    /// @param key Database key.
+    ///
+    /// An exception is raised if the read fails; failures aren't cached.
+    value_t get(std::string const &family, std::string const &key);
+
+    /// @brief Loads every key of \c family into the cache with a single \c DBGetTree. Blocks until the whole family
+    ///        has been received.
+    ///
+    /// @param family Database family.
+    ///
+    /// An exception is raised if the cache is detached or the read fails.
+    void warm(std::string const &family);
+
+    /// @brief Sets \c key in \c family to \c value. The cache is updated right away; the write is sent by the writer
+    ///        thread.
+    ///
+    /// @param family Database family.
+    /// @param key Database key.
+    /// @param value Value to store.
+    void put(std::string const &family, std::string const &key, std::string value);
+
+    /// @brief Deletes \c key from \c family. The cache is updated right away; the deletion is sent by the writer
+    ///        thread.
+    ///
+    /// @param family Database family.
+    /// @param key Database key.
+    void del(std::string const &family, std::string const &key);
+
+    /// @brief Blocks until every write queued before the call has been sent and acknowledged.
+    void flush();
+
+    /// @brief Drops the keys of \c family (or every key if \c family is empty) from the cache so that they are read
+    ///        again on their next lookup. Keys with a queued write are kept.
+    ///
+    /// @param family Database family; empty for every family.
+    void invalidate(std::string const &family = {});
+
+    /// @brief Stores a key listed by a \c DBGet or \c DBGetTree response.
+    ///
+    /// @param event DBGetResponse or DBGetTreeResponse item of a list response.
+    void load(util::KeyValDict const &event);
+
+    /// @brief Returns the counters of the cache.
+    ///
+    /// @return Cache metrics.
+    Metrics get_metrics() const;
+
+private:
+    ///
+    /// @struct Inflight
+    ///
+    /// @brief Read that is populating a key.
+    ///
+    struct Inflight {
+        std::shared_future<value_t> result;     ///< Result shared by every lookup waiting on the read.
+        bool stale{ false };                    ///< Flag indicating that the key was changed while the read was in flight.
+    };
+
+    ///
+    /// @struct Write
+    ///
+    /// @brief Write waiting to be sent.
+    ///
+    struct Write {
+        std::string family;         ///< Database family.
+        std::string key;            ///< Database key.
+        value_t value;              ///< Value to store; nothing to delete the key.
+    };
+
+    /// @brief Reads \c key in \c family from the AMI server.
+    ///
+    /// @return Value of the key; nothing if the key doesn't exist.
+    ///
+    /// @param family Database family.
+    /// @param key Database key.
+    value_t fetch(std::string const &family, std::string const &key) const;
+
+    /// @brief Updates the cache with \c write and queues it for the writer thread.
+    ///
+    /// @param write Write to queue.
+    void enqueue(Write write);
+
+    /// @brief Writer thread for this object.
+    void work_thread();
+
+    /// @brief Returns the key of \c key in \c family in the cache.
+    ///
+    /// @return Cache key.
+    ///
+    /// @param family Database family.
+    /// @param key Database key.
+    static std::string entry_key(std::string const &family, std::string const &key);
+
+    Connection *connection_{ nullptr };             ///< Connection the cache is attached to, if any.
+    std::chrono::milliseconds timeout_{ 0 };        ///< Amount of time the AMI server has to fulfill a read or a write.
+    size_t max_batch_{ 0 };                         ///< Maximum number of writes sent in a single socket write.
+
+    std::unordered_map<std::string, value_t> entries_;      ///< Cached values keyed by cache key.
+    std::unordered_map<std::string, Inflight> inflight_;    ///< Reads in flight keyed by cache key.
+    std::unordered_map<std::string, Write> pending_;        ///< Queued writes keyed by cache key.
+    std::deque<std::string> write_order_;           ///< Cache keys of the queued writes, oldest first.
+    uint64_t queued_{ 0 };                          ///< Number of writes queued so far.
+    uint64_t completed_{ 0 };                       ///< Number of queued writes sent (or coalesced) so far.
+    Metrics metrics_;                               ///< Counters of the cache.
+    mutable std::mutex mutex_;                      ///< Mutex to control access to the cache and the write queue.
+    std::condition_variable write_cv_;              ///< Condition variable used to wake the writer thread.
+    std::condition_variable flushed_cv_;            ///< Condition variable used to wake threads waiting in \c flush.
+    bool run_{ true };                              ///< Flag to stop the writer thread. Guarded by \c mutex_.
+    std::thread thread_;                            ///< Handle to writer thread.
+};
+
+}
+
+}
+
+#endif
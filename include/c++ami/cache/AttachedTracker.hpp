@@ -0,0 +1,146 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_ATTACHED_TRACKER_HPP
+#define AMI_CACHE_ATTACHED_TRACKER_HPP
+
+#include "c++ami/util/KeyValDict.hpp"
+#include <chrono>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace action {
+
+class Action;
+
+}
+
+namespace cache {
+
+///
+/// @class AttachedTracker
+///
+/// @brief Base of the caches and trackers that mirror server state from a list action and the events that follow it.
+///
+/// An attached tracker registers an event callback with its connection that hands every event to \c apply, then
+/// bootstraps itself through \c refresh. A refresh lists the server state through \c synchronize, which feeds the list
+/// items to \c load and drops whatever went away unseen. Events keep arriving while the list is coming in and are
+/// newer than the listed state; derived classes mark what an event touched with \c report and only store listed state
+/// for which \c list returns \c true.
+///
+/// A detached tracker is only fed through \c apply and \c load.
+///
+class AttachedTracker {
+public:
+    AttachedTracker(AttachedTracker const &) = delete;
+    AttachedTracker(AttachedTracker &&) noexcept = delete;
+
+    /// @brief Detaches the tracker from its connection.
+    virtual ~AttachedTracker();
+
+    AttachedTracker& operator=(AttachedTracker const &) = delete;
+    AttachedTracker& operator=(AttachedTracker &&) noexcept = delete;
+
+    /// @brief Re-synchronizes the tracker with the AMI server. Blocks until the server state has been listed.
+    ///
+    /// @param timeout Amount of time the AMI server has to answer each list action.
+    ///
+    /// State that isn't listed and hasn't been reported by an event since the refresh started is removed. An exception
+    /// is raised if the tracker is detached or the refresh fails.
+    void refresh(std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Applies a notification event. Events that don't concern the tracker are ignored.
+    ///
+    /// @param event Notification event.
+    virtual void apply(util::KeyValDict const &event) = 0;
+
+    /// @brief Stores state listed by a list action. Listed state doesn't override state reported by an event since the
+    ///        current refresh started.
+    ///
+    /// @param event Item of a list response.
+    virtual void load(util::KeyValDict const &event) = 0;
+
+protected:
+    /// @brief Constructs a detached tracker.
+    ///
+    /// @param name Name of the tracker, used in error messages.
+    explicit AttachedTracker(std::string name);
+
+    /// @brief Attaches the tracker to \c connection and bootstraps it. Called from the constructor of the derived class
+    ///        so that the bootstrap reaches the derived \c synchronize.
+    ///
+    /// @param connection Connection to receive events from. Must outlive the tracker.
+    /// @param timeout Amount of time the AMI server has to answer each list action.
+    ///
+    /// The tracker is left detached and an exception is raised if the bootstrap fails.
+    void attach(Connection &connection, std::chrono::milliseconds const &timeout);
+
+    /// @brief Removes the event callback from the connection. Derived destructors call this before their state goes
+    ///        away, since the base destructor runs too late to keep events from reaching it.
+    void detach();
+
+    /// @brief Returns the connection the tracker is attached to. An exception is raised if the tracker is detached.
+    ///
+    /// @return Connection.
+    Connection& connection() const;
+
+    /// @brief Invokes list action \c action and feeds its items to \c load as they arrive. An exception is raised if
+    ///        the action fails.
+    ///
+    /// @param action List action.
+    /// @param timeout Amount of time the AMI server has to answer.
+    void fetch(action::Action const &action, std::chrono::milliseconds const &timeout);
+
+    /// @brief Lists the server state through \c fetch and drops what went away unseen. Called by \c refresh while
+    ///        the refresh is in progress.
+    ///
+    /// @param timeout Amount of time the AMI server has to answer each list action.
+    virtual void synchronize(std::chrono::milliseconds const &timeout) = 0;
+
+    /// @brief Called with \c mutex_ held exclusively when a refresh starts.
+    virtual void begin_refresh();
+
+    /// @brief Returns \c true if listed state for \c key is to be stored, and records that \c key was listed. Caller
+    ///        must hold \c mutex_ exclusively.
+    ///
+    /// @return \c true if no event reported \c key since the current refresh started.
+    ///
+    /// @param key Key of the listed state.
+    bool list(std::string const &key);
+
+    /// @brief Records that an event reported \c key. Caller must hold \c mutex_ exclusively.
+    ///
+    /// @param key Key of the reported state.
+    void report(std::string const &key);
+
+    /// @brief Returns \c true if \c key was listed or reported since the current refresh started. Caller must hold
+    ///        \c mutex_.
+    ///
+    /// @return \c true if \c key was seen.
+    ///
+    /// @param key Key of the state.
+    bool seen(std::string const &key) const;
+
+    mutable std::shared_mutex mutex_;               ///< Mutex to control access to the state of the tracker.
+
+private:
+    std::string name_;                              ///< Name of the tracker.
+    Connection *connection_{ nullptr };             ///< Connection the tracker is attached to, if any.
+    std::optional<std::string> callback_key_;       ///< Key of the event callback registered with \c connection_.
+
+    bool refreshing_{ false };                      ///< Flag indicating that a refresh is in progress.
+    std::unordered_set<std::string> listed_;        ///< Keys listed by the refresh in progress.
+    std::unordered_set<std::string> reported_;      ///< Keys reported by an event while a refresh is in progress.
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_BRIDGE_TRACKER_HPP
+#define AMI_CACHE_BRIDGE_TRACKER_HPP
+
+#include "c++ami/cache/AttachedTracker.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class BridgeTracker
+///
+/// @brief In-memory graph of the bridges on the Asterisk server and the channels in them, kept current from bridge
+///        events.
+///
+/// The graph is bootstrapped with a \c BridgeList action and a \c BridgeInfo action per listed bridge, all of them in
+/// flight at once. From then on the graph is maintained from BridgeCreate, BridgeEnter, BridgeLeave, BridgeDestroy and
+/// BridgeMerge events, so applications can tell who is talking to whom without polling \c BridgeList and
+/// \c BridgeInfo.
+///
+/// Bridges are immutable snapshots handed out as shared pointers. The bridge a channel is in is found with a single
+/// hash table lookup; \c snapshot returns every bridge as of a single point in time.
+///
+class BridgeTracker
+    : public AttachedTracker {
+public:
+    ///
+    /// @struct Participant
+    ///
+    /// @brief Channel in a bridge.
+    ///
+    struct Participant {
+        std::string uniqueid;       ///< Unique ID of the channel.
+        std::string channel;        ///< Name of the channel.
+    };
+
+    ///
+    /// @struct Bridge
+    ///
+    /// @brief State of a bridge.
+    ///
+    struct Bridge {
+        std::string uniqueid;       ///< Unique ID of the bridge.
+        std::string type;           ///< Type of the bridge, e.g. basic.
+        std::string technology;     ///< Technology mixing the bridge, e.g. simple_bridge.
+        std::string creator;        ///< Entity that created the bridge.
+        std::string name;           ///< Name of the bridge.
+        std::vector<Participant> participants;  ///< Channels in the bridge, in the order they entered it.
+    };
+
+    using bridge_ptr_t = std::shared_ptr<Bridge const>;
+
+public:
+    BridgeTracker(BridgeTracker const &) = delete;
+    BridgeTracker(BridgeTracker &&) noexcept = delete;
+
+    /// @brief Constructs a detached tracker. A detached tracker is only fed through \c apply and \c load.
+    BridgeTracker();
+
+    /// @brief Constructs a tracker attached to \c connection and bootstraps it.
+    ///
+    /// @param connection Connection to receive bridge events from. Must outlive the tracker.
+    /// @param timeout Amount of time the AMI server has to list the bridges and the channels.
+    ///
+    /// An exception is raised if the bootstrap fails.
+    explicit BridgeTracker(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Detaches the tracker from its connection.
+    virtual ~BridgeTracker();
+
+    BridgeTracker& operator=(BridgeTracker const &) = delete;
+    BridgeTracker& operator=(BridgeTracker &&) noexcept = delete;
+
+    /// @brief Applies a notification event to the graph. Events that don't concern a bridge are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event) override;
+
+    /// @brief Stores a bridge listed by a \c BridgeList response. Listed state doesn't override state reported by an
+    ///        event since the current refresh started.
+    ///
+    /// @param event BridgeListItem item of a \c BridgeList response.
+    void load(util::KeyValDict const &event) override;
+
+    /// @brief Returns the bridge with unique ID \c bridge.
+    ///
+    /// @return Bridge snapshot; nullptr if the bridge isn't known.
+    ///
+    /// @param bridge Unique ID of the bridge.
+    bridge_ptr_t find(std::string const &bridge) const;
+
+    /// @brief Returns the bridge the channel with unique ID \c uniqueid is in.
+    ///
+    /// @return Bridge snapshot; nullptr if the channel isn't bridged.
+    ///
+    /// @param uniqueid Unique ID of the channel.
+    bridge_ptr_t bridge_of(std::string const &uniqueid) const;
+
+    /// @brief Returns the channels sharing a bridge with the channel with unique ID \c uniqueid.
+    ///
+    /// @return Peers of the channel; empty if the channel isn't bridged.
+    ///
+    /// @param uniqueid Unique ID of the channel.
+    std::vector<Participant> peers(std::string const &uniqueid) const;
+
+    /// @brief Returns all known bridges.
+    ///
+    /// @return Bridge snapshots.
+    std::vector<bridge_ptr_t> snapshot() const;
+
+private:
+    /// @brief Lists the bridges and the participants of each bridge, then drops the bridges and participants that went
+    ///        away without this tracker seeing them leave.
+    ///
+    /// @param timeout Amount of time the AMI server has to answer the \c BridgeList and each \c BridgeInfo.
+    void synchronize(std::chrono::milliseconds const &timeout) override;
+
+    /// @brief Returns a copy of bridge \c bridge to modify, or a new bridge if it isn't known. Caller must hold
+    ///        \c mutex_ exclusively.
+    ///
+    /// @return Bridge copy.
+    ///
+    /// @param bridge Unique ID of the bridge.
+    std::shared_ptr<Bridge> edit(std::string const &bridge) const;
+
+    /// @brief Moves \c participant into bridge \c bridge, creating the bridge if it isn't known. Caller must hold
+    ///        \c mutex_ exclusively.
+    ///
+    /// @param bridge Unique ID of the bridge.
+    /// @param participant Channel entering the bridge.
+    /// @param event Event describing the bridge; nullptr if there is none.
+    void enter(std::string const &bridge, Participant participant, util::KeyValDict const *event);
+
+    /// @brief Removes the channel with unique ID \c uniqueid from bridge \c bridge. Caller must hold \c mutex_
+    ///        exclusively.
+    ///
+    /// @param bridge Unique ID of the bridge.
+    /// @param uniqueid Unique ID of the channel.
+    void leave(std::string const &bridge, std::string const &uniqueid);
+
+    /// @brief Removes bridge \c bridge and unbridges its participants. Caller must hold \c mutex_ exclusively.
+    ///
+    /// @param bridge Unique ID of the bridge.
+    void destroy(std::string const &bridge);
+
+    /// @brief Stores a participant of bridge \c bridge listed by a \c BridgeInfo response, unless an event reported
+    ///        the channel or destroyed the bridge since the current refresh started.
+    ///
+    /// @param bridge Unique ID of the bridge the \c BridgeInfo was sent for.
+    /// @param item BridgeInfoChannel item of the \c BridgeInfo response.
+    void load_participant(std::string const &bridge, util::KeyValDict const &item);
+
+    /// @brief Copies the fields of \c event describing a bridge into \c bridge.
+    ///
+    /// @param bridge Bridge to update.
+    /// @param event Event describing the bridge.
+    static void update(Bridge &bridge, util::KeyValDict const &event);
+
+    std::unordered_map<std::string, bridge_ptr_t> bridges_;     ///< Bridges keyed by unique ID.
+    std::unordered_map<std::string, std::string> channels_;     ///< Bridge unique IDs keyed by channel unique ID.
+};
+
+}
+
+}
+
+#endif
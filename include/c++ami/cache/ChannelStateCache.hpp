@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_CHANNEL_STATE_CACHE_HPP
+#define AMI_CACHE_CHANNEL_STATE_CACHE_HPP
+
+#include "c++ami/cache/AttachedTracker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class ChannelStateCache
+///
+/// @brief In-memory table of the channels that are up on the Asterisk server, kept current from channel events.
+///
+/// The table is bootstrapped with a \c CoreShowChannels action. From then on the table is maintained from Newchannel,
+/// Newstate, Newexten, NewCallerid, NewConnectedLine, Rename, VarSet and Hangup events, so applications can look up the
+/// calls that are up without polling the AMI server.
+///
+/// Channels are immutable snapshots handed out as shared pointers; an update replaces the channel's snapshot rather
+/// than modifying it, so a snapshot obtained from the cache can be read without holding any lock. Lookups only take a
+/// shared lock for as long as it takes to find the snapshot.
+///
+class ChannelStateCache
+    : public AttachedTracker {
+public:
+    ///
+    /// @struct Channel
+    ///
+    /// @brief State of a single channel.
+    ///
+    struct Channel {
+        std::string uniqueid;               ///< Unique ID of the channel.
+        std::string linkedid;               ///< Unique ID of the oldest channel associated with this channel.
+        std::string channel;                ///< Name of the channel.
+        std::string state;                  ///< Numeric state of the channel.
+        std::string state_desc;             ///< Description of the state of the channel.
+        std::string caller_id_num;          ///< Caller ID number.
+        std::string caller_id_name;         ///< Caller ID name.
+        std::string connected_line_num;     ///< Connected line number.
+        std::string connected_line_name;    ///< Connected line name.
+        std::string account_code;           ///< Account code of the channel.
+        std::string context;                ///< Dialplan context the channel is in.
+        std::string exten;                  ///< Dialplan extension the channel is in.
+        std::string priority;               ///< Dialplan priority the channel is in.
+        std::string application;            ///< Dialplan application the channel is executing.
+        std::string application_data;       ///< Arguments of the dialplan application.
+        std::string bridge_id;              ///< Unique ID of the bridge the channel is in; only known from the bootstrap.
+        std::unordered_map<std::string, std::string> variables;     ///< Channel variables reported through VarSet.
+    };
+
+    using channel_ptr_t = std::shared_ptr<Channel const>;
+
+public:
+    ChannelStateCache(ChannelStateCache const &) = delete;
+    ChannelStateCache(ChannelStateCache &&) noexcept = delete;
+
+    /// @brief Constructs a detached cache. A detached cache is only fed through \c apply and \c load.
+    ChannelStateCache();
+
+    /// @brief Constructs a cache attached to \c connection and bootstraps it.
+    ///
+    /// @param connection Connection to receive channel events from. Must outlive the cache.
+    /// @param timeout Amount of time the AMI server has to list the channels that are up.
+    ///
+    /// An exception is raised if the bootstrap fails.
+    explicit ChannelStateCache(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Detaches the cache from its connection.
+    virtual ~ChannelStateCache();
+
+    ChannelStateCache& operator=(ChannelStateCache const &) = delete;
+    ChannelStateCache& operator=(ChannelStateCache &&) noexcept = delete;
+
+    /// @brief Applies a notification event to the table. Events that don't describe a channel are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event) override;
+
+    /// @brief Adds a channel listed by a \c CoreShowChannel event unless the channel is already known or was hung up
+    ///        since the current refresh started.
+    ///
+    /// @param event CoreShowChannel item of a \c CoreShowChannels response.
+    void load(util::KeyValDict const &event) override;
+
+    /// @brief Returns the channel with unique ID \c uniqueid.
+    ///
+    /// @return Channel snapshot; nullptr if no such channel is up.
+    ///
+    /// @param uniqueid Unique ID of the channel.
+    channel_ptr_t find_by_uniqueid(std::string const &uniqueid) const;
+
+    /// @brief Returns the channel named \c channel.
+    ///
+    /// @return Channel snapshot; nullptr if no such channel is up.
+    ///
+    /// @param channel Name of the channel.
+    channel_ptr_t find_by_channel(std::string const &channel) const;
+
+    /// @brief Returns the channels whose linked ID is \c linkedid, i.e. all channels of a call.
+    ///
+    /// @return Channel snapshots.
+    ///
+    /// @param linkedid Linked ID of the channels.
+    std::vector<channel_ptr_t> find_by_linkedid(std::string const &linkedid) const;
+
+    /// @brief Returns all channels that are up.
+    ///
+    /// @return Channel snapshots.
+    std::vector<channel_ptr_t> snapshot() const;
+
+    /// @brief Returns the number of channels that are up.
+    ///
+    /// @return Number of channels.
+    size_t size() const;
+
+private:
+    ///
+    /// @struct Entry
+    ///
+    /// @brief Table entry for a channel.
+    ///
+    struct Entry {
+        channel_ptr_t channel;      ///< Current snapshot of the channel.
+        uint64_t epoch;             ///< Refresh epoch the channel was last reported in.
+    };
+
+    /// @brief Lists the channels that are up with \c CoreShowChannels and drops the channels that went away without
+    ///        this cache seeing their hangup.
+    ///
+    /// @param timeout Amount of time the AMI server has to list the channels that are up.
+    void synchronize(std::chrono::milliseconds const &timeout) override;
+
+    /// @brief Starts a new refresh epoch.
+    void begin_refresh() override;
+
+    /// @brief Inserts or replaces the snapshot of a channel and updates the indexes. Caller must hold \c mutex_
+    ///        exclusively.
+    ///
+    /// @param channel New snapshot of the channel.
+    void store(channel_ptr_t channel);
+
+    /// @brief Removes the channel with unique ID \c uniqueid and updates the indexes. Caller must hold \c mutex_
+    ///        exclusively.
+    ///
+    /// @param uniqueid Unique ID of the channel.
+    void erase(std::string const &uniqueid);
+
+    /// @brief Copies the fields of \c event describing the channel into \c channel.
+    ///
+    /// @param channel Channel to update.
+    /// @param event Event describing the channel.
+    static void update(Channel &channel, util::KeyValDict const &event);
+
+    std::unordered_map<std::string, Entry> channels_;                               ///< Channels keyed by unique ID.
+    std::unordered_map<std::string, std::string> by_channel_;                       ///< Unique IDs keyed by channel name.
+    std::unordered_map<std::string, std::unordered_set<std::string>> by_linkedid_;  ///< Unique IDs keyed by linked ID.
+
+    uint64_t epoch_{ 0 };                           ///< Current refresh epoch.
+};
+
+}
+
+}
+
+#endif
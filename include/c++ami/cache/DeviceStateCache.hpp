@@ -0,0 +1,194 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_DEVICE_STATE_CACHE_HPP
+#define AMI_CACHE_DEVICE_STATE_CACHE_HPP
+
+#include "c++ami/cache/AttachedTracker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class DeviceStateCache
+///
+/// @brief In-memory table of device states and extension (hint) states, kept current from state change events.
+///
+/// The device table is bootstrapped with a \c DeviceStateList action. From then on devices are maintained from
+/// DeviceStateChange events and extensions from ExtensionStatus events. Lookups are hash table lookups under a shared
+/// lock and don't involve the AMI server.
+///
+/// Extension states are only known once the AMI server reports them; \c fetch_extension queries the state of an
+/// extension that hasn't been reported yet.
+///
+/// Listeners can subscribe to the changes of a single device or extension. Listeners are invoked on the thread applying
+/// the change (normally the event dispatcher thread), only when the state actually changed and in the order the changes
+/// were applied. Notifications are serialized by a lock of their own, so listeners may look states up but mustn't
+/// feed the cache.
+///
+class DeviceStateCache
+    : public AttachedTracker {
+public:
+    ///
+    /// @struct Device
+    ///
+    /// @brief State of a device.
+    ///
+    struct Device {
+        std::string device;         ///< Name of the device, e.g. PJSIP/100.
+        std::string state;          ///< State of the device, e.g. INUSE.
+    };
+
+    ///
+    /// @struct Extension
+    ///
+    /// @brief State of an extension with a hint.
+    ///
+    struct Extension {
+        std::string exten;          ///< Extension.
+        std::string context;        ///< Dialplan context of the extension.
+        std::string hint;           ///< Hint of the extension, e.g. PJSIP/100.
+        std::string status;         ///< Numeric state of the extension.
+        std::string status_text;    ///< Description of the state of the extension, e.g. InUse.
+    };
+
+    using device_ptr_t = std::shared_ptr<Device const>;
+    using extension_ptr_t = std::shared_ptr<Extension const>;
+    using device_listener_t = std::function<void(Device const &)>;
+    using extension_listener_t = std::function<void(Extension const &)>;
+    using subscription_t = uint64_t;
+
+public:
+    DeviceStateCache(DeviceStateCache const &) = delete;
+    DeviceStateCache(DeviceStateCache &&) noexcept = delete;
+
+    /// @brief Constructs a detached cache. A detached cache is only fed through \c apply and \c load.
+    DeviceStateCache();
+
+    /// @brief Constructs a cache attached to \c connection and bootstraps its device table.
+    ///
+    /// @param connection Connection to receive state change events from. Must outlive the cache.
+    /// @param timeout Amount of time the AMI server has to list the device states.
+    ///
+    /// An exception is raised if the bootstrap fails.
+    explicit DeviceStateCache(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Detaches the cache from its connection.
+    virtual ~DeviceStateCache();
+
+    DeviceStateCache& operator=(DeviceStateCache const &) = delete;
+    DeviceStateCache& operator=(DeviceStateCache &&) noexcept = delete;
+
+    /// @brief Queries the state of an extension from the AMI server and caches it.
+    ///
+    /// @return State of the extension.
+    ///
+    /// @param exten Extension.
+    /// @param context Dialplan context of the extension.
+    /// @param timeout Amount of time the AMI server has to report the state.
+    ///
+    /// An exception is raised if the cache is detached or the query fails.
+    extension_ptr_t fetch_extension(std::string const &exten, std::string const &context,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(5));
+
+    /// @brief Applies a notification event to the tables. Events that don't report a state change are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event) override;
+
+    /// @brief Stores a device listed by a \c DeviceStateList response unless an event reported the device since the
+    ///        current refresh started.
+    ///
+    /// @param event DeviceStateChange item of a \c DeviceStateList response.
+    void load(util::KeyValDict const &event) override;
+
+    /// @brief Returns the state of \c device.
+    ///
+    /// @return Device state; nullptr if the device isn't known.
+    ///
+    /// @param device Name of the device.
+    device_ptr_t find_device(std::string const &device) const;
+
+    /// @brief Returns the state of extension \c exten in \c context.
+    ///
+    /// @return Extension state; nullptr if the state of the extension hasn't been reported.
+    ///
+    /// @param exten Extension.
+    /// @param context Dialplan context of the extension.
+    extension_ptr_t find_extension(std::string const &exten, std::string const &context) const;
+
+    /// @brief Registers \c listener to be invoked whenever the state of \c device changes.
+    ///
+    /// @return Subscription ID.
+    ///
+    /// @param device Name of the device.
+    /// @param listener Listener to invoke with the new state.
+    subscription_t subscribe_device(std::string const &device, device_listener_t listener);
+
+    /// @brief Registers \c listener to be invoked whenever the state of extension \c exten in \c context changes.
+    ///
+    /// @return Subscription ID.
+    ///
+    /// @param exten Extension.
+    /// @param context Dialplan context of the extension.
+    /// @param listener Listener to invoke with the new state.
+    subscription_t subscribe_extension(std::string const &exten, std::string const &context,
+        extension_listener_t listener);
+
+    /// @brief Removes the subscription identified by \c id.
+    ///
+    /// @param id Subscription ID.
+    void unsubscribe(subscription_t id);
+
+private:
+    /// @brief Lists the device states with \c DeviceStateList.
+    ///
+    /// @param timeout Amount of time the AMI server has to list the device states.
+    void synchronize(std::chrono::milliseconds const &timeout) override;
+
+    /// @brief Stores \c device and notifies its listeners if its state changed.
+    ///
+    /// @param device New state of the device.
+    /// @param listed \c true if the state comes from a \c DeviceStateList response rather than an event.
+    void store(Device device, bool listed);
+
+    /// @brief Stores \c extension and notifies its listeners if its state changed.
+    ///
+    /// @param extension New state of the extension.
+    void store(Extension extension);
+
+    /// @brief Returns the key of extension \c exten in \c context.
+    ///
+    /// @return Extension key.
+    ///
+    /// @param exten Extension.
+    /// @param context Dialplan context of the extension.
+    static std::string extension_key(std::string const &exten, std::string const &context);
+
+    std::unordered_map<std::string, device_ptr_t> devices_;         ///< Device states keyed by device name.
+    std::unordered_map<std::string, extension_ptr_t> extensions_;   ///< Extension states keyed by extension key.
+
+    std::unordered_map<std::string, std::unordered_map<subscription_t, device_listener_t>> device_listeners_;       ///< Device listeners keyed by device name.
+    std::unordered_map<std::string, std::unordered_map<subscription_t, extension_listener_t>> extension_listeners_; ///< Extension listeners keyed by extension key.
+    std::unordered_map<subscription_t, std::string> subscriptions_; ///< Device name or extension key of each subscription.
+    subscription_t next_subscription_{ 0 };         ///< ID of the next subscription.
+    std::mutex listeners_mutex_;                    ///< Mutex to control access to the listeners.
+    std::mutex notify_mutex_;                       ///< Mutex to apply changes and notify their listeners one at a time.
+};
+
+}
+
+}
+
+#endif
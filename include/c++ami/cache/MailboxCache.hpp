@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_MAILBOX_CACHE_HPP
+#define AMI_CACHE_MAILBOX_CACHE_HPP
+
+#include "c++ami/util/KeyValDict.hpp"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class MailboxCache
+///
+/// @brief Caches voicemail message counts, populating mailboxes lazily on first lookup.
+///
+/// The first lookup of a mailbox queries its counts from the AMI server with \c MailboxCount and \c MailboxStatus
+/// (pipelined in a single write); later lookups are answered from memory. Concurrent lookups of a mailbox that isn't
+/// cached yet share a single query.
+///
+/// Cached mailboxes are kept current from MessageWaiting events; a MessageWaiting event without counts and a
+/// VoicemailPasswordChange event invalidate the mailbox so that it is queried again on its next lookup. \c resync
+/// invalidates mailboxes and has the AMI server re-evaluate them with \c VoicemailRefresh.
+///
+/// Mailboxes are identified as mailbox@context; a mailbox without a context is in the "default" context.
+///
+class MailboxCache {
+public:
+    ///
+    /// @struct Mailbox
+    ///
+    /// @brief Message counts of a mailbox.
+    ///
+    struct Mailbox {
+        std::string mailbox;        ///< Mailbox, as mailbox@context.
+        int urgent_messages{ 0 };   ///< Number of urgent messages.
+        int new_messages{ 0 };      ///< Number of new messages.
+        int old_messages{ 0 };      ///< Number of old messages.
+        bool waiting{ false };      ///< Flag indicating that messages are waiting.
+    };
+
+    using mailbox_ptr_t = std::shared_ptr<Mailbox const>;
+    using fetch_t = std::function<Mailbox(std::string const &)>;
+
+public:
+    MailboxCache() = delete;
+    MailboxCache(MailboxCache const &) = delete;
+    MailboxCache(MailboxCache &&) noexcept = delete;
+
+    /// @brief Constructs a detached cache that populates mailboxes through \c fetch. A detached cache is only kept
+    ///        current through \c apply.
+    ///
+    /// @param fetch Function returning the counts of a mailbox; raises an exception on failure.
+    explicit MailboxCache(fetch_t fetch);
+
+    /// @brief Constructs a cache attached to \c connection.
+    ///
+    /// @param connection Connection to query mailboxes over and receive voicemail events from. Must outlive the cache.
+    /// @param timeout Amount of time the AMI server has to report the counts of a mailbox.
+    explicit MailboxCache(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(5));
+
+    /// @brief Detaches the cache from its connection.
+    virtual ~MailboxCache();
+
+    MailboxCache& operator=(MailboxCache const &) = delete;
+    MailboxCache& operator=(MailboxCache &&) noexcept = delete;
+
+    /// @brief Returns the counts of \c mailbox, querying them if the mailbox isn't cached.
+    ///
+    /// @return Message counts.
+    ///
+    /// @param mailbox Mailbox, as mailbox or mailbox@context.
+    ///
+    /// An exception is raised if the query fails; failures aren't cached.
+    mailbox_ptr_t get(std::string const &mailbox);
+
+    /// @brief Returns the counts of \c mailbox if it is cached.
+    ///
+    /// @return Message counts; nullptr if the mailbox isn't cached.
+    ///
+    /// @param mailbox Mailbox, as mailbox or mailbox@context.
+    mailbox_ptr_t find(std::string const &mailbox) const;
+
+    /// @brief Drops \c mailbox from the cache so that it is queried on its next lookup.
+    ///
+    /// @param mailbox Mailbox, as mailbox or mailbox@context.
+    void invalidate(std::string const &mailbox);
+
+    /// @brief Drops \c mailbox (or every mailbox if \c mailbox is empty) from the cache and, on an attached cache, has
+    ///        the AMI server re-evaluate it with \c VoicemailRefresh.
+    ///
+    /// @param mailbox Mailbox, as mailbox or mailbox@context; empty for every mailbox.
+    void resync(std::string const &mailbox = {});
+
+    /// @brief Applies a notification event to the cache. Events that don't concern a mailbox are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event);
+
+private:
+    ///
+    /// @struct Inflight
+    ///
+    /// @brief Query that is populating a mailbox.
+    ///
+    struct Inflight {
+        std::shared_future<mailbox_ptr_t> result;   ///< Result shared by every lookup waiting on the query.
+        bool stale{ false };                        ///< Flag indicating that the mailbox was invalidated while the query was in flight.
+    };
+
+    /// @brief Queries the counts of \c mailbox over the attached connection.
+    ///
+    /// @return Message counts.
+    ///
+    /// @param mailbox Mailbox, as mailbox@context.
+    Mailbox fetch(std::string const &mailbox) const;
+
+    /// @brief Drops \c mailbox from the cache. Caller must hold \c mutex_.
+    ///
+    /// @param mailbox Mailbox, as mailbox@context.
+    void drop(std::string const &mailbox);
+
+    /// @brief Returns \c mailbox as mailbox@context.
+    ///
+    /// @return Normalized mailbox.
+    ///
+    /// @param mailbox Mailbox, as mailbox or mailbox@context.
+    static std::string normalize(std::string const &mailbox);
+
+    Connection *connection_{ nullptr };             ///< Connection the cache is attached to, if any.
+    std::optional<std::string> callback_key_;       ///< Key of the event callback registered with \c connection_.
+    std::chrono::milliseconds timeout_{ 0 };        ///< Amount of time the AMI server has to report the counts of a mailbox.
+    fetch_t fetch_;                                 ///< Function returning the counts of a mailbox.
+
+    std::unordered_map<std::string, mailbox_ptr_t> mailboxes_;  ///< Cached mailboxes keyed by mailbox@context.
+    std::unordered_map<std::string, Inflight> inflight_;        ///< Queries in flight keyed by mailbox@context.
+    mutable std::mutex mutex_;                      ///< Mutex to control access to the cache.
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_PARKING_TRACKER_HPP
+#define AMI_CACHE_PARKING_TRACKER_HPP
+
+#include "c++ami/cache/AttachedTracker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class ParkingTracker
+///
+/// @brief In-memory table of parking lots and the calls parked in them, kept current from parking events.
+///
+/// The tables are bootstrapped with the \c Parkinglots and \c ParkedCalls actions. From then on slots are maintained
+/// from ParkedCall, UnParkedCall, ParkedCallTimeOut, ParkedCallGiveUp and ParkedCallSwap events.
+///
+/// Parked calls are immutable snapshots handed out as shared pointers. Listeners are notified of every slot that is
+/// filled, changes or is emptied; they are invoked on the thread applying the change (normally the event dispatcher
+/// thread) with no locks held.
+///
+class ParkingTracker
+    : public AttachedTracker {
+public:
+    ///
+    /// @struct Lot
+    ///
+    /// @brief Configuration of a parking lot.
+    ///
+    struct Lot {
+        std::string name;           ///< Name of the parking lot.
+        std::string start_space;    ///< First parking space of the lot.
+        std::string stop_space;     ///< Last parking space of the lot.
+        std::string timeout;        ///< Number of seconds a call stays parked before it times out.
+    };
+
+    ///
+    /// @struct ParkedCall
+    ///
+    /// @brief Call occupying a parking space.
+    ///
+    struct ParkedCall {
+        std::string lot;                ///< Name of the parking lot.
+        std::string space;              ///< Parking space.
+        std::string channel;            ///< Name of the parked channel.
+        std::string uniqueid;           ///< Unique ID of the parked channel.
+        std::string caller_id_num;      ///< Caller ID number of the parked channel.
+        std::string caller_id_name;     ///< Caller ID name of the parked channel.
+        std::string parker_dial_string; ///< Dial string of the party that parked the call.
+        std::string timeout;            ///< Number of seconds left before the call times out, as of the last update.
+    };
+
+    using lot_ptr_t = std::shared_ptr<Lot const>;
+    using parked_call_ptr_t = std::shared_ptr<ParkedCall const>;
+
+    // Invoked with the lot and space of a slot and its new occupant; a null occupant means the slot was emptied.
+    using listener_t = std::function<void(std::string const &, std::string const &, parked_call_ptr_t const &)>;
+    using subscription_t = uint64_t;
+
+public:
+    ParkingTracker(ParkingTracker const &) = delete;
+    ParkingTracker(ParkingTracker &&) noexcept = delete;
+
+    /// @brief Constructs a detached tracker. A detached tracker is only fed through \c apply and \c load.
+    ParkingTracker();
+
+    /// @brief Constructs a tracker attached to \c connection and bootstraps it.
+    ///
+    /// @param connection Connection to receive parking events from. Must outlive the tracker.
+    /// @param timeout Amount of time the AMI server has to list the parking lots and the parked calls.
+    ///
+    /// An exception is raised if the bootstrap fails.
+    explicit ParkingTracker(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Detaches the tracker from its connection.
+    virtual ~ParkingTracker();
+
+    ParkingTracker& operator=(ParkingTracker const &) = delete;
+    ParkingTracker& operator=(ParkingTracker &&) noexcept = delete;
+
+    /// @brief Applies a notification event to the tables. Events that don't concern parking are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event) override;
+
+    /// @brief Stores a parking lot or parked call listed by a \c Parkinglots or \c ParkedCalls response. A listed call
+    ///        doesn't override a slot reported by an event since the current refresh started.
+    ///
+    /// @param event Parkinglot or ParkedCall item of a list response.
+    void load(util::KeyValDict const &event) override;
+
+    /// @brief Returns the call parked in \c space of \c lot.
+    ///
+    /// @return Parked call; nullptr if the space is empty.
+    ///
+    /// @param lot Name of the parking lot.
+    /// @param space Parking space.
+    parked_call_ptr_t find(std::string const &lot, std::string const &space) const;
+
+    /// @brief Returns the parking lot named \c lot.
+    ///
+    /// @return Parking lot; nullptr if the lot isn't known.
+    ///
+    /// @param lot Name of the parking lot.
+    lot_ptr_t find_lot(std::string const &lot) const;
+
+    /// @brief Returns the calls parked in \c lot, or in every lot if \c lot is empty.
+    ///
+    /// @return Parked calls.
+    ///
+    /// @param lot Name of the parking lot; empty for every lot.
+    std::vector<parked_call_ptr_t> parked_calls(std::string const &lot = {}) const;
+
+    /// @brief Returns all known parking lots.
+    ///
+    /// @return Parking lots.
+    std::vector<lot_ptr_t> lots() const;
+
+    /// @brief Registers \c listener to be invoked whenever a slot changes.
+    ///
+    /// @return Subscription ID.
+    ///
+    /// @param listener Listener to invoke.
+    subscription_t subscribe(listener_t listener);
+
+    /// @brief Removes the subscription identified by \c id.
+    ///
+    /// @param id Subscription ID.
+    void unsubscribe(subscription_t id);
+
+private:
+    /// @brief Lists the parking lots and the parked calls, then empties the slots whose call went away without this
+    ///        tracker seeing it leave.
+    ///
+    /// @param timeout Amount of time the AMI server has to list the parking lots and the parked calls.
+    void synchronize(std::chrono::milliseconds const &timeout) override;
+
+    /// @brief Starts a new refresh epoch.
+    void begin_refresh() override;
+
+    ///
+    /// @struct Slot
+    ///
+    /// @brief Table entry for an occupied parking space.
+    ///
+    struct Slot {
+        parked_call_ptr_t call;     ///< Call occupying the space.
+        uint64_t epoch;             ///< Refresh epoch the slot was last reported in.
+    };
+
+    /// @brief Fills (or empties, if \c call is null) \c space of \c lot and notifies the listeners.
+    ///
+    /// @param lot Name of the parking lot.
+    /// @param space Parking space.
+    /// @param call New occupant of the slot; nullptr to empty the slot.
+    /// @param listed \c true if the call comes from a \c ParkedCalls response rather than an event.
+    void store(std::string const &lot, std::string const &space, parked_call_ptr_t call, bool listed);
+
+    /// @brief Invokes the listeners with a slot change.
+    ///
+    /// @param lot Name of the parking lot.
+    /// @param space Parking space.
+    /// @param call New occupant of the slot.
+    void notify(std::string const &lot, std::string const &space, parked_call_ptr_t const &call);
+
+    /// @brief Returns the parked call described by the Parkee fields of \c event.
+    ///
+    /// @return Parked call.
+    ///
+    /// @param event ParkedCall event or list item.
+    static parked_call_ptr_t to_parked_call(util::KeyValDict const &event);
+
+    /// @brief Returns the key of \c space in \c lot.
+    ///
+    /// @return Slot key.
+    ///
+    /// @param lot Name of the parking lot.
+    /// @param space Parking space.
+    static std::string slot_key(std::string const &lot, std::string const &space);
+
+    std::unordered_map<std::string, lot_ptr_t> lots_;   ///< Parking lots keyed by name.
+    std::unordered_map<std::string, Slot> slots_;       ///< Occupied slots keyed by slot key.
+    uint64_t epoch_{ 0 };                           ///< Current refresh epoch.
+
+    std::unordered_map<subscription_t, listener_t> listeners_;  ///< Listeners keyed by subscription ID.
+    subscription_t next_subscription_{ 0 };         ///< ID of the next subscription.
+    std::mutex listeners_mutex_;                    ///< Mutex to control access to the listeners.
+};
+
+}
+
+}
+
+#endif
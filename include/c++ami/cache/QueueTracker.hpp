@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_QUEUE_TRACKER_HPP
+#define AMI_CACHE_QUEUE_TRACKER_HPP
+
+#include "c++ami/cache/AttachedTracker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace cache {
+
+///
+/// @class QueueTracker
+///
+/// @brief In-memory table of call queues, their members and their waiting callers, kept current from queue events.
+///
+/// The table is bootstrapped with a \c QueueStatus action. From then on queues are maintained from QueueMemberStatus,
+/// QueueMemberAdded, QueueMemberRemoved, QueueMemberPause, QueueCallerJoin, QueueCallerLeave, QueueCallerAbandon,
+/// AgentConnect and AgentComplete events, so dashboards can read queue state without polling the AMI server.
+///
+/// Each queue is an immutable snapshot handed out as a shared pointer; an update replaces the queue's snapshot rather
+/// than modifying it, so a queue obtained from the tracker is internally consistent and can be read without holding
+/// any lock. \c summarize computes the figures of a \c QueueSummary response from the snapshot.
+///
+class QueueTracker
+    : public AttachedTracker {
+public:
+    ///
+    /// @struct Member
+    ///
+    /// @brief State of a queue member (agent).
+    ///
+    struct Member {
+        std::string interface;          ///< Interface the member is reached on, e.g. PJSIP/100.
+        std::string name;               ///< Name of the member.
+        std::string state_interface;    ///< Interface whose device state is the state of the member.
+        std::string membership;         ///< Membership of the member: static, dynamic or realtime.
+        std::string penalty;            ///< Penalty of the member.
+        std::string status;             ///< Numeric device state of the member.
+        std::string paused;             ///< "1" if the member is paused.
+        std::string paused_reason;      ///< Reason the member is paused.
+        std::string in_call;            ///< "1" if the member is on a call from the queue.
+        std::string last_call;          ///< Time of the last call the member took, in seconds since the epoch.
+        int calls_taken{ 0 };           ///< Number of calls the member took.
+    };
+
+    ///
+    /// @struct Caller
+    ///
+    /// @brief Caller waiting in a queue.
+    ///
+    struct Caller {
+        std::string channel;            ///< Name of the waiting channel.
+        std::string uniqueid;           ///< Unique ID of the waiting channel.
+        std::string caller_id_num;      ///< Caller ID number.
+        std::string caller_id_name;     ///< Caller ID name.
+        int position{ 0 };              ///< Position of the caller in the queue, starting at 1.
+        std::chrono::steady_clock::time_point joined;   ///< Time the caller joined the queue.
+    };
+
+    ///
+    /// @struct Queue
+    ///
+    /// @brief State of a call queue.
+    ///
+    struct Queue {
+        std::string name;               ///< Name of the queue.
+        std::string strategy;           ///< Ring strategy of the queue.
+        std::string max;                ///< Maximum number of waiting callers; 0 if unlimited.
+        std::string service_level;      ///< Service level of the queue, in seconds.
+        std::string service_level_perf; ///< Percentage of calls answered within the service level.
+        std::string weight;             ///< Weight of the queue.
+        int hold_time{ 0 };             ///< Average hold time, in seconds.
+        int talk_time{ 0 };             ///< Average talk time, in seconds.
+        int completed{ 0 };             ///< Number of calls completed.
+        int abandoned{ 0 };             ///< Number of calls abandoned.
+        std::map<std::string, Member> members;  ///< Members keyed by interface.
+        std::vector<Caller> callers;            ///< Waiting callers in queue order.
+    };
+
+    ///
+    /// @struct Summary
+    ///
+    /// @brief Figures of a queue as reported by a \c QueueSummary response.
+    ///
+    struct Summary {
+        std::string queue;              ///< Name of the queue.
+        int logged_in{ 0 };             ///< Number of members that are logged in.
+        int available{ 0 };             ///< Number of logged in members that are neither paused nor busy.
+        int callers{ 0 };               ///< Number of waiting callers.
+        int hold_time{ 0 };             ///< Average hold time, in seconds.
+        int talk_time{ 0 };             ///< Average talk time, in seconds.
+        std::chrono::seconds longest_hold_time{ 0 };    ///< Time the longest waiting caller has been waiting.
+    };
+
+    using queue_ptr_t = std::shared_ptr<Queue const>;
+
+    // Invoked with the name of a queue and its new snapshot; a null snapshot means the queue is gone.
+    using listener_t = std::function<void(std::string const &, queue_ptr_t const &)>;
+    using subscription_t = uint64_t;
+
+public:
+    QueueTracker(QueueTracker const &) = delete;
+    QueueTracker(QueueTracker &&) noexcept = delete;
+
+    /// @brief Constructs a detached tracker. A detached tracker is only fed through \c apply and \c load.
+    QueueTracker();
+
+    /// @brief Constructs a tracker attached to \c connection and bootstraps it.
+    ///
+    /// @param connection Connection to receive queue events from. Must outlive the tracker.
+    /// @param timeout Amount of time the AMI server has to list the queues.
+    ///
+    /// An exception is raised if the bootstrap fails.
+    explicit QueueTracker(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(30));
+
+    /// @brief Detaches the tracker from its connection.
+    virtual ~QueueTracker();
+
+    QueueTracker& operator=(QueueTracker const &) = delete;
+    QueueTracker& operator=(QueueTracker &&) noexcept = delete;
+
+    /// @brief Applies a notification event to the table. Events that don't concern a queue are ignored.
+    ///
+    /// @param event Notification event.
+    void apply(util::KeyValDict const &event) override;
+
+    /// @brief Stores a queue, member or caller listed by a \c QueueStatus response. Listed state doesn't override
+    ///        state reported by an event since the current refresh started.
+    ///
+    /// @param event QueueParams, QueueMember or QueueEntry item of a \c QueueStatus response.
+    void load(util::KeyValDict const &event) override;
+
+    /// @brief Returns the queue named \c queue.
+    ///
+    /// @return Queue snapshot; nullptr if the queue isn't known.
+    ///
+    /// @param queue Name of the queue.
+    queue_ptr_t find(std::string const &queue) const;
+
+    /// @brief Returns all known queues.
+    ///
+    /// @return Queue snapshots.
+    std::vector<queue_ptr_t> snapshot() const;
+
+    /// @brief Returns the \c QueueSummary figures of \c queue, computed from its snapshot.
+    ///
+    /// @return Queue summary; nothing if the queue isn't known.
+    ///
+    /// @param queue Name of the queue.
+    std::optional<Summary> summarize(std::string const &queue) const;
+
+    /// @brief Registers \c listener to be invoked whenever a queue changes.
+    ///
+    /// @return Subscription ID.
+    ///
+    /// @param listener Listener to invoke.
+    subscription_t subscribe(listener_t listener);
+
+    /// @brief Removes the subscription identified by \c id.
+    ///
+    /// @param id Subscription ID.
+    void unsubscribe(subscription_t id);
+
+private:
+    /// @brief Lists the queues with \c QueueStatus, then drops the queues, members and callers that went away without
+    ///        this tracker seeing them leave.
+    ///
+    /// @param timeout Amount of time the AMI server has to list the queues.
+    void synchronize(std::chrono::milliseconds const &timeout) override;
+
+    /// @brief Replaces the snapshot of \c queue with a copy modified by \c change and notifies the listeners. The
+    ///        queue is created if it isn't known.
+    ///
+    /// @param queue Name of the queue.
+    /// @param change Function modifying the copy; returns \c false if it left the queue unchanged. Invoked with
+    ///        \c mutex_ held exclusively.
+    void modify(std::string const &queue, std::function<bool(Queue &)> const &change);
+
+    /// @brief Invokes the listeners with a queue change.
+    ///
+    /// @param queue Name of the queue.
+    /// @param snapshot New snapshot of the queue.
+    void notify(std::string const &queue, queue_ptr_t const &snapshot);
+
+    /// @brief Returns the key of entry \c id of kind \c kind in \c queue.
+    ///
+    /// @return Entry key.
+    ///
+    /// @param queue Name of the queue.
+    /// @param kind 'q' for the queue itself, 'p' for its parameters, 'm' for a member, 'c' for a caller.
+    /// @param id Interface of a member or unique ID of a caller.
+    static std::string entry_key(std::string const &queue, char kind, std::string const &id = {});
+
+    /// @brief Inserts or replaces the caller described by \c event at its position in \c queue.
+    ///
+    /// @param queue Queue to update.
+    /// @param event QueueCallerJoin event or QueueEntry item.
+    /// @param joined Time the caller joined the queue.
+    static void place_caller(Queue &queue, util::KeyValDict const &event,
+        std::chrono::steady_clock::time_point joined);
+
+    /// @brief Removes the caller with unique ID \c uniqueid from \c queue.
+    ///
+    /// @return \c true if the caller was waiting in the queue.
+    ///
+    /// @param queue Queue to update.
+    /// @param uniqueid Unique ID of the caller.
+    static bool remove_caller(Queue &queue, std::string const &uniqueid);
+
+    /// @brief Copies the fields of \c event describing a member into \c member.
+    ///
+    /// @param member Member to update.
+    /// @param event Event describing the member.
+    static void update(Member &member, util::KeyValDict const &event);
+
+    std::unordered_map<std::string, queue_ptr_t> queues_;   ///< Queues keyed by name.
+
+    std::unordered_map<subscription_t, listener_t> listeners_;  ///< Listeners keyed by subscription ID.
+    subscription_t next_subscription_{ 0 };         ///< ID of the next subscription.
+    std::mutex listeners_mutex_;                    ///< Mutex to control access to the listeners.
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_CACHE_REACTION_CACHE_HPP
+#define AMI_CACHE_REACTION_CACHE_HPP
+
+#include "c++ami/EventDispatcher.hpp"
+#include "c++ami/util/TimerWheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cpp_ami {
+
+class Connection;
+
+namespace action {
+class Action;
+}
+
+namespace cache {
+
+///
+/// @class ReactionCache
+///
+/// @brief Read-through cache of the reactions to read-only actions, sitting in front of \c Connection::invoke.
+///
+/// Caching is opt-in per action: only actions given a time-to-live with \c set_ttl are cached, every other action is
+/// passed straight through to the connection. Cached reactions are keyed by action name and headers (the ActionID
+/// excluded), so two \c Getvar actions for the same variable share an entry.
+///
+/// Concurrent invocations of an identical action that isn't cached are coalesced: the first one is sent to the AMI
+/// server and the others wait for its reaction, so N simultaneous requests cost a single round trip. Reactions are
+/// shared; every caller receives the same immutable reaction. Failed and unsuccessful reactions are handed to the
+/// waiting callers but never cached.
+///
+class ReactionCache {
+public:
+    using reaction_ptr_t = std::shared_ptr<EventDispatcher::reaction_t const>;
+    using invoke_t = std::function<EventDispatcher::reaction_ptr_t(action::Action const &)>;
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Counters of the cache.
+    ///
+    struct Metrics {
+        uint64_t hits{ 0 };         ///< Invocations answered from the cache.
+        uint64_t misses{ 0 };       ///< Invocations sent to the AMI server.
+        uint64_t coalesced{ 0 };    ///< Invocations that waited for an identical invocation already in flight.
+        uint64_t bypassed{ 0 };     ///< Invocations of actions that aren't cached.
+        size_t entries{ 0 };        ///< Number of cached reactions, expired ones included until they are swept.
+    };
+
+public:
+    ReactionCache() = delete;
+    ReactionCache(ReactionCache const &) = delete;
+    ReactionCache(ReactionCache &&) noexcept = delete;
+
+    /// @brief Constructs a cache that sends actions through \c invoke.
+    ///
+    /// @param invoke Function sending an action to the AMI server and returning its reaction; raises an exception on
+    ///        failure.
+    explicit ReactionCache(invoke_t invoke);
+
+    /// @brief Constructs a cache in front of \c connection.
+    ///
+    /// @param connection Connection to send actions over. Must outlive the cache.
+    /// @param timeout Amount of time the AMI server has to fulfill an action.
+    explicit ReactionCache(Connection &connection,
+        std::chrono::milliseconds const &timeout = std::chrono::seconds(5));
+
+    virtual ~ReactionCache() = default;
+
+    ReactionCache& operator=(ReactionCache const &) = delete;
+    ReactionCache& operator=(ReactionCache &&) noexcept = delete;
+
+    /// @brief Caches the reactions to \c action for \c ttl.
+    ///
+    /// @param action Name of the action, e.g. Getvar. Action names are case-insensitive.
+    /// @param ttl Amount of time a reaction stays cached. A zero TTL doesn't retain reactions but still coalesces
+    ///        concurrent invocations.
+    void set_ttl(std::string const &action, std::chrono::milliseconds const &ttl);
+
+    /// @brief Stops caching the reactions to \c action and drops the cached ones.
+    ///
+    /// @param action Name of the action.
+    void clear_ttl(std::string const &action);
+
+    /// @brief Returns the reaction to \c action, from the cache if an identical action was invoked within its TTL.
+    ///
+    /// @return Reaction to \c action; nullptr if the request was cancelled.
+    ///
+    /// @param action Action to invoke.
+    ///
+    /// An exception is raised if the invocation fails; the exception is also raised in every coalesced invocation.
+    reaction_ptr_t invoke(action::Action const &action);
+
+    /// @brief Drops the cached reactions to \c action, or every cached reaction if \c action is empty. Invocations
+    ///        in flight aren't cached when they complete.
+    ///
+    /// @param action Name of the action; empty for every action.
+    void invalidate(std::string const &action = {});
+
+    /// @brief Returns the counters of the cache.
+    ///
+    /// @return Cache metrics.
+    Metrics get_metrics() const;
+
+    /// @brief Returns the key identifying \c action in the cache: its lower-cased name followed by its headers in
+    ///        sorted order. The ActionID isn't part of the key.
+    ///
+    /// @return Cache key.
+    ///
+    /// @param action Action to return the key of.
+    static std::string cache_key(action::Action const &action);
+
+private:
+    using clock_t = util::TimerWheel::clock_t;
+
+    ///
+    /// @struct Entry
+    ///
+    /// @brief Cached reaction.
+    ///
+    struct Entry {
+        reaction_ptr_t reaction;    ///< Cached reaction.
+        clock_t::time_point expires;    ///< Time the reaction expires.
+        util::TimerWheel::handle_t timer;   ///< Timer removing the reaction once it expired.
+    };
+
+    ///
+    /// @struct Inflight
+    ///
+    /// @brief Invocation sent to the AMI server that identical invocations are waiting on.
+    ///
+    struct Inflight {
+        std::shared_future<reaction_ptr_t> result;  ///< Result shared by every invocation waiting on the invocation.
+        bool stale{ false };                        ///< Flag indicating that the cache was invalidated while the invocation was in flight.
+    };
+
+    /// @brief Removes the reactions whose timer expired. Caller must hold \c mutex_.
+    ///
+    /// @param now Current time.
+    void sweep(clock_t::time_point now);
+
+    /// @brief Removes the cached reaction referenced by \c it and cancels its timer. Caller must hold \c mutex_.
+    ///
+    /// @param it Cached reaction.
+    void erase(std::unordered_map<std::string, Entry>::iterator it);
+
+    /// @brief Returns \c name lower-cased.
+    ///
+    /// @return Lower-cased name.
+    ///
+    /// @param name Action name.
+    static std::string normalize(std::string const &name);
+
+    invoke_t invoke_;                               ///< Function sending an action to the AMI server.
+
+    std::unordered_map<std::string, std::chrono::milliseconds> ttls_;   ///< TTLs keyed by lower-cased action name.
+    std::unordered_map<std::string, Entry> entries_;                    ///< Cached reactions keyed by cache key.
+    util::TimerWheel expiry_{ std::chrono::milliseconds(100) };         ///< Expiry timers of the cached reactions, keyed by cache key.
+    std::unordered_map<std::string, Inflight> inflight_;                ///< Invocations in flight keyed by cache key.
+    Metrics metrics_;                               ///< Counters of the cache.
+    mutable std::mutex mutex_;                      ///< Mutex to control access to the cache.
+};
+
+}
+
+}
+
+#endif
@@ -33,6 +33,12 @@ public:
 
     Event& operator=(Event const &) = default;
     Event& operator=(Event &&) noexcept = default;
+
+    /// @brief Replaces the contents of the object with the AMI message in \c event_buf, reusing the storage of the
+    ///        previous contents.
+    ///
+    /// @param event_buf String buffer containing the textual representation of an AMI Event.
+    void reset(std::string event_buf);
 };
 
 }
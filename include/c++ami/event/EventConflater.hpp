@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_EVENT_CONFLATER_HPP
+#define AMI_EVENT_CONFLATER_HPP
+
+#include "c++ami/event/EventPool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cpp_ami::event {
+
+///
+/// @class EventConflater
+///
+/// @brief Collapses bursts of high-frequency channel events down to the newest event per event type and channel.
+///
+/// Events of the configured types that carry a Uniqueid are held back. A newer event with the same type and Uniqueid
+/// replaces the held one and moves behind the other events held for its channel, so consumers only see the latest
+/// state, in the order it was reached. With a zero window events are only conflated within a batch, that is while the
+/// consumer is behind.
+///
+/// The held events of a channel are released together, once the configured window has lapsed since the first of them
+/// was held back, and ahead of any other event for that channel, so the order of events per channel is preserved.
+/// Events of different channels may be reordered.
+///
+class EventConflater {
+public:
+    using event_ptr_t = std::unique_ptr<Event const, EventPool::Deleter>;
+    using clock_t = std::chrono::steady_clock;
+
+    ///
+    /// @struct Metrics
+    ///
+    /// @brief Snapshot of the state of the conflater.
+    ///
+    struct Metrics {
+        uint64_t conflatable{ 0 };      ///< Total number of events of a configured type seen.
+        uint64_t conflated{ 0 };        ///< Total number of events replaced by a newer event.
+        size_t held{ 0 };               ///< Number of events currently held back.
+    };
+
+public:
+    EventConflater() = default;
+    EventConflater(EventConflater const &) = delete;
+    EventConflater(EventConflater &&) noexcept = delete;
+
+    virtual ~EventConflater() = default;
+
+    EventConflater& operator=(EventConflater const &) = delete;
+    EventConflater& operator=(EventConflater &&) noexcept = delete;
+
+    /// @brief Sets the event types to conflate and how long to hold them back. A new window applies to events already
+    ///        held back as well; an empty set disables conflation and releases them with the next batch.
+    ///
+    /// @param event_types Event types to conflate, e.g. "Newexten" or "VarSet".
+    /// @param window Amount of time to hold events back for.
+    void configure(std::unordered_set<std::string> event_types, std::chrono::milliseconds window);
+
+    /// @brief Conflates \c batch in place; held back events are removed from \c batch and events whose window has
+    ///        lapsed are added to it.
+    ///
+    /// @param batch Batch of events, in arrival order.
+    /// @param now Current time.
+    void process(std::vector<event_ptr_t> &batch, clock_t::time_point now);
+
+    /// @brief Adds all held back events to \c batch.
+    ///
+    /// @param batch Batch of events to release held back events into.
+    void flush(std::vector<event_ptr_t> &batch);
+
+    /// @brief Returns the time at which the oldest held back event must be released.
+    ///
+    /// @return Release time; std::nullopt if no events are held back.
+    std::optional<clock_t::time_point> next_deadline() const;
+
+    /// @brief Returns a snapshot of the counters of the conflater.
+    ///
+    /// @return Conflater metrics.
+    Metrics get_metrics() const;
+
+private:
+    ///
+    /// @struct Held
+    ///
+    /// @brief Event held back for conflation.
+    ///
+    struct Held {
+        std::string key;                ///< Event type and Uniqueid of the event.
+        std::string uniqueid;           ///< Uniqueid of the event.
+        event_ptr_t event;              ///< Newest event for \c key.
+    };
+
+    ///
+    /// @struct Channel
+    ///
+    /// @brief Channel with events held back.
+    ///
+    struct Channel {
+        std::string uniqueid;           ///< Uniqueid of the channel.
+        clock_t::time_point since;      ///< Time at which the first of the held events was held back.
+        size_t held{ 0 };               ///< Number of events held back for the channel.
+    };
+
+    using held_t = std::list<Held>;
+    using channels_t = std::list<Channel>;
+
+    /// @brief Releases the held back event at \c it into \c batch. Caller must hold \c mutex_.
+    ///
+    /// @param it Held back event to release.
+    /// @param batch Batch to release the event into.
+    void release(held_t::iterator it, std::vector<event_ptr_t> &batch);
+
+    /// @brief Releases all held back events for the channel identified by \c uniqueid into \c batch. Caller must hold
+    ///        \c mutex_.
+    ///
+    /// @param uniqueid Uniqueid of the channel.
+    /// @param batch Batch to release the events into.
+    void release_channel(std::string const &uniqueid, std::vector<event_ptr_t> &batch);
+
+    std::unordered_set<std::string> event_types_;               ///< Event types to conflate.
+    std::chrono::milliseconds window_{ 0 };                     ///< Amount of time to hold events back for.
+
+    held_t held_;                                               ///< Held back events, in the order they are released.
+    std::unordered_map<std::string, held_t::iterator> index_;   ///< Location of the held back event for each key.
+    channels_t channels_;                                       ///< Channels with events held back, oldest first.
+    std::unordered_map<std::string, channels_t::iterator> channel_index_;  ///< Location of each channel, by Uniqueid.
+    std::vector<event_ptr_t> scratch_;                          ///< Scratch collection used to rebuild batches.
+
+    Metrics metrics_;                                           ///< Counters; \c held is computed on demand.
+
+    mutable std::mutex mutex_;                                  ///< Mutex to control access to the configuration and held back events.
+};
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef AMI_EVENT_POOL_HPP
+#define AMI_EVENT_POOL_HPP
+
+#include "c++ami/event/Event.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cpp_ami::event {
+
+///
+/// @class EventPool
+///
+/// @brief Recycles Event objects, along with the storage backing their key/value pairs.
+///
+/// Events are handed out wrapped in a \c std::unique_ptr whose deleter returns them to the pool instead of freeing
+/// them. A recycled Event is re-initialized in place, so once the pool has warmed up dispatching an event doesn't need
+/// to allocate any memory for the Event or its key/value pairs. The message text itself still arrives from the parser
+/// in a string of its own.
+///
+/// Events may be returned to the pool from any thread. Every Event handed out must be returned before the pool is
+/// destroyed.
+///
+class EventPool {
+public:
+    ///
+    /// @struct Deleter
+    ///
+    /// @brief Returns pooled events to the pool they came from. Events not owned by a pool are deleted.
+    ///
+    /// The deleter is typed on \c Event so that it can only ever be handed objects of the type the pool allocates.
+    ///
+    struct Deleter {
+        EventPool *pool{ nullptr };     ///< Pool to return the event to.
+
+        void operator()(Event const *event) const;
+    };
+
+    using ptr_t = std::unique_ptr<Event, Deleter>;
+
+public:
+    EventPool() = delete;
+    EventPool(EventPool const &) = delete;
+    EventPool(EventPool &&) noexcept = delete;
+
+    /// @brief Constructs a pool that holds on to at most \c capacity idle events.
+    ///
+    /// @param capacity Maximum number of idle events kept for reuse. Events released while the pool is full are freed.
+    explicit EventPool(size_t capacity);
+
+    /// @brief Frees all idle events.
+    virtual ~EventPool();
+
+    EventPool& operator=(EventPool const &) = delete;
+    EventPool& operator=(EventPool &&) noexcept = delete;
+
+    /// @brief Returns an event initialized with the AMI message in \c event_buf.
+    ///
+    /// @return Pooled event.
+    ///
+    /// @param event_buf String buffer containing the textual representation of an AMI Event.
+    ptr_t acquire(std::string event_buf);
+
+    /// @brief Returns the number of idle events held by the pool.
+    ///
+    /// @return Number of idle events.
+    size_t idle_count() const;
+
+private:
+    /// @brief Returns \c event to the pool.
+    ///
+    /// @param event Event to return to the pool.
+    void release(Event *event);
+
+    size_t capacity_;               ///< Maximum number of idle events.
+    std::vector<Event *> idle_;     ///< Events available for reuse.
+    mutable std::mutex mutex_;      ///< Mutex to control access to \c idle_.
+};
+
+}
+
+#endif
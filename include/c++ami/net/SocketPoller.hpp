@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef NET_SOCKETPOLLER_HPP
+#define NET_SOCKETPOLLER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace cpp_ami::net {
+
+class TcpSocket;
+
+///
+/// @class SocketPoller
+///
+/// @brief Starts a single thread that reads data from many socket objects.
+///
+/// Where a \c SocketReader dedicates a thread to one socket, the poller waits on every socket added to it at once and
+/// reads whichever ones have data. Handlers of all sockets run on the poller thread, one at a time, so they shouldn't
+/// block.
+///
+class SocketPoller {
+public:
+    using handler_t = std::function<void(std::string)>;
+    using closed_handler_t = std::function<void()>;
+
+    using socket_t = net::TcpSocket;
+    using socket_ptr_t = std::shared_ptr<socket_t>;
+
+public:
+    SocketPoller(SocketPoller const &) = delete;
+    SocketPoller(SocketPoller &&) = delete;
+
+    /// @brief Constructs the poller and starts its thread.
+    SocketPoller();
+
+    /// @brief Stops the thread.
+    virtual ~SocketPoller();
+
+    SocketPoller& operator=(SocketPoller const &) = delete;
+    SocketPoller& operator=(SocketPoller &&) = delete;
+
+    /// @brief Starts reading \c socket. \c callback is invoked with the data received on it.
+    ///
+    /// @param socket Socket to read data from.
+    /// @param callback Callback function to invoke on received data.
+    /// @param closed Callback function to invoke once the peer closes the socket or it can no longer be polled; the
+    ///        socket is no longer read.
+    void add(socket_ptr_t socket, handler_t callback, closed_handler_t closed = {});
+
+    /// @brief Stops reading \c socket. Unless called from the poller thread, blocks until its callbacks are no longer
+    ///        running.
+    ///
+    /// @param socket Socket to stop reading.
+    void remove(socket_t const &socket);
+
+    /// @brief Returns the number of sockets being read.
+    ///
+    /// @return Number of sockets.
+    size_t size() const;
+
+private:
+    ///
+    /// @struct Entry
+    ///
+    /// @brief Socket being read.
+    ///
+    struct Entry {
+        socket_ptr_t socket;        ///< Socket to read data from.
+        handler_t callback;         ///< Callback to invoke on received data.
+        closed_handler_t closed;    ///< Callback to invoke once the socket is closed.
+    };
+
+    /// @brief Implements the work thread responsible for waiting on the sockets and invoking the data callbacks on
+    ///        received data.
+    void work_thread();
+
+    /// @brief Interrupts the poller thread so that it picks up a change to the socket collection.
+    void interrupt() const;
+
+    /// @brief Stops reading every socket after polling failed and invokes their closed callbacks. Sockets added
+    ///        afterwards are reported closed right away.
+    void abandon();
+
+    std::unordered_map<int, Entry> sockets_;    ///< Sockets being read keyed by file descriptor.
+    uint64_t generation_{ 0 };                  ///< Number of changes made to \c sockets_.
+    uint64_t serviced_{ 0 };                    ///< Generation of \c sockets_ the poller thread is waiting on.
+    mutable std::mutex mutex_;                  ///< Mutex to control access to the socket collection.
+    std::condition_variable serviced_cv_;       ///< Condition variable used to wake threads waiting in \c remove.
+    bool failed_{ false };                      ///< Flag indicating that polling failed and the thread stopped.
+
+    int wake_fd_{ -1 };                         ///< Event file descriptor used to interrupt the poller thread.
+    std::thread thread_;                        ///< Handle to poller thread.
+    std::atomic<bool> thread_spin_{ false };    ///< Flag indicating if thread is still running.
+};
+
+}
+
+#endif
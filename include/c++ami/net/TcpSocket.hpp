@@ -62,6 +62,11 @@ public:
     /// is free for write.
     void write(std::string_view data);
 
+    /// @brief Returns the socket file descriptor.
+    ///
+    /// @return Socket file descriptor.
+    int native_handle() const;
+
 private:
     /// @brief Closes socket \c sock_fd.
     ///
@@ -65,6 +65,23 @@ public:
     size_t event_count() const;
     event::Event const& get_event(size_t event_idx) const;
 
+    /// @brief Returns the event that started the list.
+    ///
+    /// @return Head event.
+    event::Event const& get_head() const;
+
+    /// @brief Returns the event that completed the list.
+    ///
+    /// @return Tail event; nullptr if the list didn't complete.
+    event::Event const* get_tail() const;
+
+    /// @brief Returns \c true if \c dict is the event that terminates an EventList.
+    ///
+    /// @return \c true if \c dict has an EventList value marking the list as complete.
+    ///
+    /// @param dict Event to check.
+    static bool is_list_complete(util::KeyValDict const &dict);
+
 private:
     static bool is_list_complete(std::string const &event_list_val);
 
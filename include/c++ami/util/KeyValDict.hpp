@@ -22,7 +22,7 @@ namespace cpp_ami::util {
 class KeyValDict {
 public:
     KeyValDict() = delete;
-    KeyValDict(KeyValDict const &) = default;
+    KeyValDict(KeyValDict const &right);
     KeyValDict(KeyValDict &&) noexcept = default;
 
     /// @brief Constructs an object from \c event_buf string containing the AMI message.
@@ -37,7 +37,7 @@ public:
 
     virtual ~KeyValDict() = default;
 
-    KeyValDict &operator=(KeyValDict const &) = default;
+    KeyValDict &operator=(KeyValDict const &right);
     KeyValDict &operator=(KeyValDict &&) noexcept = default;
 
     /// @brief Returns \c true if the object has a key of value \c key.
@@ -74,6 +74,11 @@ public:
     /// @param val Value to set key to.
     void set_value(std::string const &key, std::string val);
 
+    /// @brief Returns the keys of the object in order.
+    ///
+    /// @return Ordered keys of the object.
+    std::vector<std::string> const& get_keys() const;
+
     /// @brief Returns number of keys in object.
     ///
     /// @return Number of keys in object.
@@ -82,17 +87,31 @@ public:
     /// @brief Returns an AMI string representation of the object.
     ///
     /// @return AMI string representation of the object.
+    ///
+    /// Values spanning several lines are written as a repeated key, one line each. The lines of a key that was repeated
+    /// in the parsed message keep their position amongst the other keys.
     virtual std::string to_string() const;
 
 protected:
     /// @brief Initializes the object using the key/value pairs found in \c event_buf.
     ///
     /// @param event_buf String containing AMI key/value pairs.
+    ///
+    /// The message is parsed a line at a time. The values of a key repeated on several lines are joined with line
+    /// feeds, so the \c Output lines of a Command response read as a single value; the order of the lines is remembered
+    /// for to_string(). Lines that aren't key/value pairs are skipped and the space after the colon is optional.
+    ///
+    /// Storage from any previous contents is reused; re-initializing an object with a message of a similar shape
+    /// doesn't need to allocate.
     void set_message(std::string event_buf);
 
 private:
-    std::vector<std::string> ordered_keys_;                 ///< Collection of ordered keys for object.
-    std::unordered_map<std::string, std::string> values_;   ///< Collection of Key/value pairs.
+    using values_t = std::unordered_map<std::string, std::string>;
+
+    std::vector<std::string> ordered_keys_;     ///< Collection of ordered keys for object.
+    values_t values_;                           ///< Collection of Key/value pairs.
+    std::vector<size_t> lines_;                 ///< Index into \c ordered_keys_ of each line read when a key repeats.
+    std::vector<values_t::node_type> spare_;    ///< Nodes recycled from previous contents of \c values_. Not copied.
 };
 
 }
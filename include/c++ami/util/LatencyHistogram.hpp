@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef UTIL_LATENCY_HISTOGRAM_HPP
+#define UTIL_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace cpp_ami::util {
+
+///
+/// @class LatencyHistogram
+///
+/// @brief Histogram of latencies with log-linear buckets, for estimating quantiles at a bounded relative error.
+///
+/// Latencies are counted in microseconds. Below 16us every microsecond has a bucket of its own; above that every power
+/// of two is split into 8 buckets, so a reported quantile is never more than 12.5% above the true value. The bucket
+/// counters are atomic: recording never blocks and may happen from any number of threads while quantiles are read.
+///
+/// Given a half-life, older latencies fade out: every time a half-life passes, the counts are halved, so quantiles
+/// follow a server whose latencies drift instead of being anchored to its whole history.
+///
+class LatencyHistogram {
+public:
+    using duration_t = std::chrono::microseconds;
+
+public:
+    LatencyHistogram(LatencyHistogram const &) = delete;
+    LatencyHistogram(LatencyHistogram &&) noexcept = delete;
+
+    /// @brief Constructs a histogram that counts every latency for good.
+    LatencyHistogram() = default;
+
+    /// @brief Constructs a histogram whose counts halve every \c half_life.
+    ///
+    /// @param half_life Amount of time after which a latency counts half; zero never halves the counts.
+    explicit LatencyHistogram(std::chrono::nanoseconds half_life);
+
+    virtual ~LatencyHistogram() = default;
+
+    LatencyHistogram& operator=(LatencyHistogram const &) = delete;
+    LatencyHistogram& operator=(LatencyHistogram &&) noexcept = delete;
+
+    /// @brief Counts \c latency in the histogram.
+    ///
+    /// @param latency Latency to count; negative latencies count as zero.
+    void record(std::chrono::nanoseconds latency);
+
+    /// @brief Returns the number of latencies counted.
+    ///
+    /// @return Number of latencies.
+    uint64_t count() const;
+
+    /// @brief Returns the latency that \c quantile of the counted latencies don't exceed.
+    ///
+    /// @return Upper bound of the bucket holding the quantile; zero if nothing was counted.
+    ///
+    /// @param quantile Quantile in [0, 1], e.g. 0.99 for the 99th percentile.
+    duration_t quantile(double quantile) const;
+
+    /// @brief Discards every latency counted.
+    void reset();
+
+    /// @brief Halves the count of every bucket. Latencies recorded concurrently are kept whole.
+    void decay();
+
+    /// @brief Changes the amount of time after which the counts are halved.
+    ///
+    /// @param half_life Amount of time after which a latency counts half; zero never halves the counts.
+    void set_half_life(std::chrono::nanoseconds half_life);
+
+private:
+    static constexpr size_t LINEAR_BUCKETS = 16;    ///< Number of one-microsecond buckets at the bottom of the range.
+    static constexpr size_t SUB_BUCKET_BITS = 3;    ///< Each power of two above the linear range is split into 2^3 buckets.
+    static constexpr size_t BUCKETS = LINEAR_BUCKETS + (64 - 4) * (1 << SUB_BUCKET_BITS);  ///< Number of buckets covering every 64-bit latency.
+
+    /// @brief Returns the bucket of \c micros.
+    ///
+    /// @return Bucket index.
+    ///
+    /// @param micros Latency in microseconds.
+    static size_t bucket(uint64_t micros);
+
+    /// @brief Returns the largest latency counted in \c index.
+    ///
+    /// @return Upper bound of the bucket, in microseconds.
+    ///
+    /// @param index Bucket index.
+    static uint64_t upper_bound(size_t index);
+
+    /// @brief Halves the counts once for every half-life that passed since they were last halved.
+    void age();
+
+    /// @brief Divides the count of every bucket by 2^\c halvings.
+    ///
+    /// @param halvings Number of times to halve the counts.
+    void shrink(uint64_t halvings);
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};  ///< Number of latencies counted per bucket.
+    std::atomic<uint64_t> count_{ 0 };                      ///< Number of latencies counted.
+    std::atomic<int64_t> half_life_{ 0 };                   ///< Amount of time after which the counts are halved, in nanoseconds.
+    std::atomic<int64_t> aged_{ 0 };                        ///< Steady clock time the counts were last halved at, in nanoseconds.
+};
+
+}
+
+#endif
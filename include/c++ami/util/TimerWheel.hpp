@@ -0,0 +1,134 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef UTIL_TIMER_WHEEL_HPP
+#define UTIL_TIMER_WHEEL_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace cpp_ami::util {
+
+///
+/// @class TimerWheel
+///
+/// @brief Hierarchical timer wheel that tracks deadlines for keyed timers.
+///
+/// Timers are hashed into one of \c LEVEL_COUNT wheels of \c SLOT_COUNT slots each based on how far into the future
+/// they expire. Arming and cancelling a timer are O(1) operations; timers living in the coarser wheels are cascaded
+/// down into the finer wheels as the wheel advances. The wheel does not invoke any callbacks; calling \c advance
+/// returns the keys of the timers that expired so that the owner can act on them outside of any locks it holds.
+///
+/// This object is not thread-safe; callers are expected to provide their own synchronization.
+///
+class TimerWheel {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using key_t = std::string;
+
+private:
+    static constexpr size_t SLOT_BITS{6};
+    static constexpr size_t SLOT_COUNT{size_t{1} << SLOT_BITS};
+    static constexpr size_t SLOT_MASK{SLOT_COUNT - 1};
+    static constexpr size_t LEVEL_COUNT{4};
+
+    struct Timer {
+        key_t key;              ///< Key identifying the timer.
+        uint64_t expiry{0};     ///< Tick the timer expires on.
+        size_t level{0};        ///< Wheel level the timer currently lives in.
+        size_t slot{0};         ///< Slot of the wheel level the timer currently lives in.
+    };
+
+    using slot_t = std::list<Timer>;
+
+public:
+    using handle_t = slot_t::iterator;
+
+public:
+    TimerWheel() = delete;
+    TimerWheel(TimerWheel const &) = delete;
+    TimerWheel(TimerWheel &&) noexcept = default;
+
+    /// @brief Constructs a wheel that advances in steps of \c resolution starting at \c start.
+    ///
+    /// @param resolution Granularity of the wheel. Deadlines are rounded up to the next tick.
+    /// @param start Time point the wheel starts counting ticks from.
+    explicit TimerWheel(std::chrono::milliseconds resolution, clock_t::time_point start = clock_t::now());
+
+    virtual ~TimerWheel() = default;
+
+    TimerWheel& operator=(TimerWheel const &) = delete;
+    TimerWheel& operator=(TimerWheel &&) noexcept = default;
+
+    /// @brief Arms a timer identified by \c key that expires at \c deadline.
+    ///
+    /// @return Handle that can be used to cancel the timer.
+    ///
+    /// @param key Key identifying the timer; returned by \c advance once the timer expires.
+    /// @param deadline Time point the timer expires at.
+    handle_t arm(key_t key, clock_t::time_point deadline);
+
+    /// @brief Cancels the timer referenced by \c handle.
+    ///
+    /// @param handle Handle returned by \c arm. The handle must refer to a timer that hasn't expired yet.
+    void cancel(handle_t handle);
+
+    /// @brief Advances the wheel up to \c now.
+    ///
+    /// @return Keys of all timers that expired.
+    ///
+    /// @param now Current time.
+    std::vector<key_t> advance(clock_t::time_point now);
+
+    /// @brief Returns the tick resolution of the wheel.
+    ///
+    /// @return Tick resolution.
+    std::chrono::milliseconds resolution() const;
+
+    /// @brief Returns the number of armed timers.
+    ///
+    /// @return Number of armed timers.
+    size_t size() const;
+
+    /// @brief Returns \c true if there aren't any armed timers.
+    ///
+    /// @return \c true if there aren't any armed timers.
+    bool empty() const;
+
+private:
+    /// @brief Converts \c time to a tick count.
+    ///
+    /// @return Number of ticks elapsed between the start of the wheel and \c time, rounded up.
+    ///
+    /// @param time Time point to convert.
+    uint64_t to_tick(clock_t::time_point time) const;
+
+    /// @brief Places the timer referenced by \c handle, currently owned by \c from, into the slot matching its expiry.
+    ///
+    /// @param from Slot currently holding the timer.
+    /// @param handle Timer to place.
+    void place(slot_t &from, handle_t handle);
+
+    /// @brief Re-places every timer in \c level's slot for the current tick into finer grained wheels.
+    ///
+    /// @return Slot index that was cascaded.
+    ///
+    /// @param level Wheel level to cascade.
+    size_t cascade(size_t level);
+
+    std::chrono::milliseconds resolution_;      ///< Tick resolution.
+    clock_t::time_point start_;                 ///< Time point of tick 0.
+    uint64_t current_tick_{0};                  ///< Last tick processed.
+    size_t count_{0};                           ///< Number of armed timers.
+
+    std::array<std::array<slot_t, SLOT_COUNT>, LEVEL_COUNT> wheels_;   ///< Wheel levels, finest first.
+    slot_t staging_;                                                   ///< Scratch slot used while placing timers.
+};
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef UTIL_TOKEN_BUCKET_HPP
+#define UTIL_TOKEN_BUCKET_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace cpp_ami::util {
+
+///
+/// @class TokenBucket
+///
+/// @brief Token bucket rate limiter refilling at a fixed rate up to a burst capacity.
+///
+/// The bucket is tracked as the time it will next be full rather than as a fractional token count, so refills are
+/// computed in clock ticks and don't accumulate rounding errors however long the bucket runs: over any window the
+/// number of tokens handed out never exceeds the burst plus the rate times the window.
+///
+/// This object is not thread-safe; callers are expected to provide their own synchronization.
+///
+class TokenBucket {
+public:
+    using clock_t = std::chrono::steady_clock;
+
+public:
+    TokenBucket() = delete;
+    TokenBucket(TokenBucket const &) = default;
+    TokenBucket(TokenBucket &&) noexcept = default;
+
+    /// @brief Constructs a full bucket.
+    ///
+    /// @param rate Number of tokens added per second; must be positive.
+    /// @param burst Maximum number of tokens the bucket holds; must be at least 1.
+    /// @param now Time the bucket starts at.
+    ///
+    /// An std::invalid_argument exception is raised if \c rate isn't positive or \c burst is 0.
+    TokenBucket(double rate, size_t burst, clock_t::time_point now = clock_t::now());
+
+    virtual ~TokenBucket() = default;
+
+    TokenBucket& operator=(TokenBucket const &) = default;
+    TokenBucket& operator=(TokenBucket &&) noexcept = default;
+
+    /// @brief Takes a token from the bucket if one is available.
+    ///
+    /// @return \c true if a token was taken.
+    ///
+    /// @param now Current time.
+    bool try_acquire(clock_t::time_point now = clock_t::now());
+
+    /// @brief Returns the amount of time until a token is available.
+    ///
+    /// @return Time until the next token; zero if a token is available now.
+    ///
+    /// @param now Current time.
+    clock_t::duration wait_time(clock_t::time_point now = clock_t::now()) const;
+
+    /// @brief Returns the number of tokens available.
+    ///
+    /// @return Number of whole tokens in the bucket.
+    ///
+    /// @param now Current time.
+    size_t available(clock_t::time_point now = clock_t::now()) const;
+
+    /// @brief Changes the refill rate and capacity. Tokens already in the bucket are kept, up to the new capacity.
+    ///
+    /// @param rate Number of tokens added per second; must be positive.
+    /// @param burst Maximum number of tokens the bucket holds; must be at least 1.
+    /// @param now Current time.
+    ///
+    /// An std::invalid_argument exception is raised, and the bucket left unchanged, if \c rate isn't positive or
+    /// \c burst is 0.
+    void set_rate(double rate, size_t burst, clock_t::time_point now = clock_t::now());
+
+private:
+    clock_t::duration interval_;        ///< Time it takes to add a single token.
+    size_t burst_;                      ///< Maximum number of tokens the bucket holds.
+    clock_t::time_point full_;          ///< Time the bucket is full again if no more tokens are taken.
+};
+
+}
+
+#endif
@@ -0,0 +1,782 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "Proxy.hpp"
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/action/Login.hpp"
+#include "c++ami/CppAmiDefs.h"
+#include "c++ami/net/SocketPoller.hpp"
+#include "c++ami/reaction/EventList.hpp"
+#include "c++ami/util/ScopeGuard.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <iterator>
+#include <fmt/core.h>
+#include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+using namespace cpp_ami::proxy;
+
+namespace {
+
+/// @brief Amount of time an OriginateResponse is routed back to the client that sent the Originate.
+constexpr auto ORIGINATION_TTL = std::chrono::minutes(10);
+
+/// @brief Event sent to the clients once the upstream session closes.
+constexpr std::string_view SHUTDOWN_EVENT{
+    "Event: Shutdown\r\nPrivilege: system,all\r\nShutdown: Uncleanly\r\nRestart: True\r\n\r\n" };
+
+/// @brief Event sent to the clients once the upstream session is back.
+constexpr std::string_view FULLY_BOOTED_EVENT{
+    "Event: FullyBooted\r\nPrivilege: system,all\r\nStatus: Fully Booted\r\n\r\n" };
+
+/// @brief Returns \c value in lower case.
+std::string to_lower(std::string_view value)
+{
+    std::string result(value);
+    std::ranges::transform(result, result.begin(), [](unsigned char c) -> char { return std::tolower(c); });
+    return result;
+}
+
+/// @brief Returns a response to a client request carrying \c action_id.
+std::string format_response(std::optional<std::string> const &action_id, std::string_view status,
+    std::string_view details)
+{
+    return fmt::format("Response: {}{}{}{}{}", status, cpp_ami::EOR,
+        action_id ? fmt::format("ActionID: {}{}", action_id.value(), cpp_ami::EOR) : std::string(), details,
+        cpp_ami::EOR);
+}
+
+/// @brief Returns \c true if \c value is one of the ways AMI spells yes.
+bool is_true(std::optional<std::string> const &value)
+{
+    auto const lower = to_lower(value.value_or(""));
+    return lower == "yes" || lower == "true" || lower == "y" || lower == "t" || lower == "1" || lower == "on";
+}
+
+}
+
+Proxy::Proxy(Options const &options, std::shared_ptr<net::SocketPoller> poller, std::shared_ptr<DispatchGroup> group)
+    : options_(options)
+    , poller_(std::move(poller))
+    , group_(std::move(group))
+{
+    upstream_ = connect();
+    greeting_ = upstream_->get_ami_version() + EOR;
+
+    listen_fd_ = listen(options_.listen);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ == -1) {
+        ::close(listen_fd_);
+        throw std::runtime_error(fmt::format("Error opening eventfd: {}", strerror(errno)));
+    }
+
+    thread_run_ = true;
+    thread_ = std::thread(&Proxy::work_thread, this);
+    pthread_setname_np(thread_.native_handle(), "ami_proxy");
+}
+
+Proxy::~Proxy()
+{
+    thread_run_ = false;
+    wake();
+    thread_.join();
+
+    // Response handlers refer to this object; close the outstanding requests and wait for their handlers to finish
+    std::vector<action::Action> forwarded;
+    {
+        std::unique_lock const lock(clients_mutex_);
+        for (auto const &[_, action] : forwarded_) {
+            forwarded.push_back(action);
+        }
+    }
+    close_forwarded(*upstream_, forwarded);
+    upstream_.reset();
+
+    for (auto const &[_, client] : clients_) {
+        ::close(client.fd);
+    }
+    ::close(listen_fd_);
+    ::close(wake_fd_);
+    if (options_.listen.starts_with("unix:")) {
+        ::unlink(options_.listen.substr(5).c_str());
+    }
+}
+
+bool Proxy::is_connected() const
+{
+    std::shared_lock const lock(upstream_mutex_);
+    return upstream_->is_connected();
+}
+
+void Proxy::reconnect()
+{
+    if (!upstream_lost_.exchange(true)) {
+        notify(SHUTDOWN_EVENT);
+    }
+
+    // Logging in may take a while; the clients are serviced meanwhile and their actions rejected
+    auto upstream = connect();
+
+    // Every action forwarded over the closed session was sent under the shared lock, so none is sent after this
+    std::vector<action::Action> forwarded;
+    {
+        std::unique_lock const upstream_lock(upstream_mutex_);
+        std::swap(upstream_, upstream);
+
+        std::unique_lock const lock(clients_mutex_);
+        for (auto const &[_, action] : forwarded_) {
+            forwarded.push_back(action);
+        }
+        originations_.clear();
+        greeting_ = upstream_->get_ami_version() + EOR;
+    }
+    close_forwarded(*upstream, forwarded);
+    upstream.reset();
+
+    upstream_lost_ = false;
+    notify(FULLY_BOOTED_EVENT);
+}
+
+bool Proxy::is_listening() const
+{
+    return thread_run_;
+}
+
+size_t Proxy::get_clients() const
+{
+    std::unique_lock const lock(clients_mutex_);
+    return clients_.size();
+}
+
+void Proxy::work_thread()
+{
+    std::vector<pollfd> fds;
+    std::vector<uint64_t> ids;
+
+    while (thread_run_) {
+        fds.assign({ pollfd{ .fd = wake_fd_, .events = POLLIN, .revents = 0 },
+            pollfd{ .fd = listen_fd_, .events = POLLIN, .revents = 0 } });
+        ids.clear();
+        {
+            std::unique_lock const lock(clients_mutex_);
+            for (auto it = clients_.begin(); it != clients_.end(); ) {
+                auto &client = it->second;
+                write_client(client);
+                if (client.closing && client.output.empty()) {
+                    ::close(client.fd);
+                    it = clients_.erase(it);
+                    continue;
+                }
+                auto const events = static_cast<short>(client.output.empty() ? POLLIN : POLLIN | POLLOUT);
+                fds.push_back(pollfd{ .fd = client.fd, .events = events, .revents = 0 });
+                ids.push_back(it->first);
+                ++it;
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // The clients can't be serviced anymore; drop them rather than leave them hanging
+            fmt::print(stderr, "Proxy: error polling clients on {}: {}\n", options_.listen, strerror(errno));
+            std::unique_lock const lock(clients_mutex_);
+            for (auto const &[_, client] : clients_) {
+                ::close(client.fd);
+            }
+            clients_.clear();
+            thread_run_ = false;
+            return;
+        }
+
+        if (fds[0].revents != 0) {
+            uint64_t count = 0;
+            [[maybe_unused]] auto const ret = ::read(wake_fd_, &count, sizeof(count));
+        }
+        if (fds[1].revents != 0) {
+            accept_clients();
+        }
+        for (size_t i = 2; i < fds.size(); ++i) {
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                read_client(ids[i - 2]);
+            }
+        }
+    }
+}
+
+void Proxy::accept_clients()
+{
+    while (true) {
+        auto const fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            return;
+        }
+
+        // Clients expect the AMI banner before anything else
+        std::unique_lock const lock(clients_mutex_);
+        auto &client = clients_[next_client_++];
+        client.fd = fd;
+        client.output = greeting_;
+    }
+}
+
+void Proxy::read_client(uint64_t id)
+{
+    std::vector<std::string> requests;
+    {
+        std::unique_lock const lock(clients_mutex_);
+        auto const it = clients_.find(id);
+        if (it == clients_.end()) {
+            return;
+        }
+        auto &client = it->second;
+
+        char buf[MAX_BUF_SIZE];
+        auto const received = recv(client.fd, buf, sizeof(buf), 0);
+        if (received <= 0) {
+            if (received == -1 && (errno == EAGAIN || errno == EINTR)) {
+                return;
+            }
+            ::close(client.fd);
+            clients_.erase(it);
+            return;
+        }
+        client.input.append(buf, received);
+
+        // Requests are handled outside of the lock; forwarding one may complete it right away
+        for (auto eom = client.input.find(EOM); eom != std::string::npos; eom = client.input.find(EOM)) {
+            requests.push_back(client.input.substr(0, eom + EOM.length()));
+            client.input.erase(0, eom + EOM.length());
+        }
+
+        // A request that never ends would otherwise be buffered for good
+        if (client.input.size() > options_.max_input) {
+            ::close(client.fd);
+            clients_.erase(it);
+            return;
+        }
+    }
+
+    for (auto &request : requests) {
+        handle_request(id, std::move(request));
+    }
+}
+
+void Proxy::write_client(Client &client)
+{
+    while (!client.output.empty()) {
+        auto const sent = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent == -1) {
+            if (errno != EAGAIN && errno != EINTR) {
+                client.output.clear();
+                client.closing = true;
+            }
+            return;
+        }
+        client.output.erase(0, sent);
+    }
+}
+
+void Proxy::handle_request(uint64_t id, std::string request)
+{
+    util::KeyValDict const message(std::move(request));
+    auto const action = to_lower(message.get_value("Action").value_or(""));
+    auto const action_id = message.get_value("ActionID");
+
+    auto const response = [&action_id](std::string_view status, std::string_view details) -> std::string {
+        return format_response(action_id, status, details);
+    };
+
+    // Session-level actions concern the client's session with the proxy, not the upstream session
+    if (action.empty()) {
+        reply(id, response("Error", fmt::format("Message: Missing action in request{}", EOR)));
+        return;
+    }
+    if (action == "login") {
+        login(id, message);
+        return;
+    }
+    if (action == "logoff") {
+        reply(id, response("Goodbye", fmt::format("Message: Thanks for all the fish.{}", EOR)), true);
+        return;
+    }
+    if (action == "challenge") {
+        reply(id, response("Error", fmt::format("Message: Challenge authentication isn't supported{}", EOR)));
+        return;
+    }
+
+    std::optional<std::string> user;
+    {
+        std::unique_lock const lock(clients_mutex_);
+        if (auto const it = clients_.find(id); it != clients_.end()) {
+            user = it->second.user;
+        }
+    }
+    if (!user) {
+        reply(id, response("Error", fmt::format("Message: Permission denied{}", EOR)));
+        return;
+    }
+
+    if (action == "events") {
+        auto const mask = message.get_value("EventMask").value_or("off");
+        bool enabled = false;
+        {
+            std::unique_lock const lock(clients_mutex_);
+            if (auto const it = clients_.find(id); it != clients_.end()) {
+                set_event_mask(it->second, mask);
+                enabled = it->second.all_events || !it->second.event_classes.empty();
+            }
+        }
+        reply(id, response("Success", fmt::format("Events: {}{}", enabled ? "On" : "Off", EOR)));
+    }
+    else if (action == "filter") {
+        add_filter(id, message);
+    }
+    else if (action == "waitevent") {
+        // Waiting upstream would hold up the session every client shares
+        reply(id, response("Error", fmt::format("Message: WaitEvent isn't supported through the proxy{}", EOR)));
+    }
+    else if (auto const &actions = options_.users.at(user.value()).actions;
+        !actions.contains("*") && !actions.contains(action)) {
+        reply(id, response("Error", fmt::format("Message: Permission denied{}", EOR)));
+    }
+    else {
+        forward(id, message, action_id);
+    }
+}
+
+void Proxy::login(uint64_t id, util::KeyValDict const &request)
+{
+    auto const response = [action_id = request.get_value("ActionID")](std::string_view status,
+        std::string_view details) -> std::string {
+        return format_response(action_id, status, details);
+    };
+
+    auto const username = request.get_value("Username").value_or("");
+    auto const user = options_.users.find(username);
+    if (user == options_.users.end() || request.get_value("Secret") != user->second.secret) {
+        // As the AMI server does, a failed login ends the session
+        reply(id, response("Error", fmt::format("Message: Authentication failed{}", EOR)), true);
+        return;
+    }
+
+    {
+        std::unique_lock const lock(clients_mutex_);
+        if (auto const it = clients_.find(id); it != clients_.end()) {
+            it->second.user = username;
+            set_event_mask(it->second, request.get_value("Events").value_or("on"));
+        }
+    }
+    reply(id, response("Success", fmt::format("Message: Authentication accepted{}", EOR)));
+}
+
+void Proxy::add_filter(uint64_t id, util::KeyValDict const &request)
+{
+    auto const response = [action_id = request.get_value("ActionID")](std::string_view status,
+        std::string_view details) -> std::string {
+        return format_response(action_id, status, details);
+    };
+
+    if (to_lower(request.get_value("Operation").value_or("Add")) != "add") {
+        reply(id, response("Error", fmt::format("Message: Unknown operation{}", EOR)));
+        return;
+    }
+
+    // A leading ! excludes the events matching the rest of the filter; filters are POSIX extended regular expressions
+    // matched against the whole event, as the AMI server does
+    auto filter = request.get_value("Filter").value_or("");
+    auto const exclude = filter.starts_with('!');
+    if (exclude) {
+        filter.erase(0, 1);
+    }
+    std::regex expression;
+    try {
+        expression.assign(filter, std::regex::extended | std::regex::nosubs);
+    }
+    catch (std::regex_error const &) {
+        reply(id, response("Error", fmt::format("Message: Filter Not Added{}", EOR)));
+        return;
+    }
+
+    {
+        std::unique_lock const lock(clients_mutex_);
+        if (auto const it = clients_.find(id); it != clients_.end()) {
+            (exclude ? it->second.exclude_filters : it->second.include_filters).push_back(std::move(expression));
+        }
+    }
+    reply(id, response("Success", fmt::format("Message: Filter Added Successfully{}", EOR)));
+}
+
+void Proxy::forward(uint64_t id, util::KeyValDict const &request, std::optional<std::string> const &action_id)
+{
+    // The action is sent in the order the client wrote it, under an ActionID of the proxy's own
+    std::vector<std::string> keys;
+    std::ranges::copy_if(request.get_keys(), std::back_inserter(keys), [](std::string const &key) -> bool {
+        return key != "Action" && key != "ActionID";
+    });
+    action::Action action(request.get_value("Action").value(), keys);
+    for (auto const &key : keys) {
+        action[key] = request[key];
+    }
+    auto const upstream_id = action.get_action_id();
+    auto const name = to_lower(action.get_action());
+
+    // Held until the action is sent so that the session can't be replaced in between
+    std::shared_lock const upstream_lock(upstream_mutex_);
+    if (!upstream_->is_connected()) {
+        reply(id, format_response(action_id, "Error", fmt::format("Message: Upstream session unavailable{}", EOR)));
+        return;
+    }
+
+    // The outcome of an asynchronous Originate arrives as an event after the response; route it back as well
+    {
+        std::unique_lock const lock(clients_mutex_);
+        forwarded_.emplace(upstream_id, action);
+
+        if (name == "originate" && is_true(request.get_value("Async"))) {
+            auto const now = clock_t::now();
+            std::erase_if(originations_, [now](auto const &entry) -> bool {
+                return now - entry.second.sent > ORIGINATION_TTL;
+            });
+            originations_.insert_or_assign(upstream_id,
+                Origination{ .client = id, .action_id = action_id, .sent = now });
+        }
+    }
+
+    upstream_->async_invoke(action,
+        [this, id, upstream_id, action_id, command = name == "command"](Connection::reaction_ptr_t reaction,
+            std::exception_ptr err) -> void {
+            if (reaction && !err) {
+                reply(id, rewrite(serialize(*reaction, command), upstream_id, action_id));
+                retire(upstream_id);
+                return;
+            }
+
+            std::string error("Request cancelled");
+            try {
+                if (err) {
+                    std::rethrow_exception(err);
+                }
+            }
+            catch (std::exception const &e) {
+                error = e.what();
+            }
+            reply(id, format_response(action_id, "Error", fmt::format("Message: {}{}", error, EOR)));
+            retire(upstream_id);
+        },
+        options_.timeout);
+}
+
+void Proxy::reply(uint64_t id, std::string_view message, bool close)
+{
+    {
+        std::unique_lock const lock(clients_mutex_);
+        auto const it = clients_.find(id);
+        if (it == clients_.end()) {
+            return;
+        }
+        queue(it->second, message);
+        it->second.closing = it->second.closing || close;
+    }
+    wake();
+}
+
+void Proxy::notify(std::string_view message)
+{
+    {
+        std::unique_lock const lock(clients_mutex_);
+        for (auto &[_, client] : clients_) {
+            if (client.user) {
+                queue(client, message);
+            }
+        }
+    }
+    wake();
+}
+
+std::unique_ptr<cpp_ami::Connection> Proxy::connect()
+{
+    auto upstream = std::make_unique<Connection>(options_.hostname, options_.port, poller_, group_);
+    upstream->add_batch_callback([this](Connection::event_batch_t events) -> void { dispatch_handler(events); });
+
+    action::Login login(options_.username, options_.secret);
+    login["Events"] = "on";
+    auto const reaction = upstream->invoke(login, options_.timeout);
+    if (!reaction || !reaction->is_success()) {
+        throw std::runtime_error(fmt::format("Proxy: login to {}:{} failed; {}", options_.hostname, options_.port,
+            reaction ? reaction->to_string() : "request closed"));
+    }
+    return upstream;
+}
+
+void Proxy::close_forwarded(Connection &upstream, std::vector<action::Action> const &actions)
+{
+    for (auto const &action : actions) {
+        upstream.cancel(action);
+    }
+
+    std::unique_lock lock(clients_mutex_);
+    forwarded_cv_.wait(lock, [this, &actions]() -> bool {
+        return std::ranges::none_of(actions, [this](action::Action const &action) -> bool {
+            return forwarded_.contains(action.get_action_id());
+        });
+    });
+}
+
+void Proxy::retire(std::string const &upstream_id)
+{
+    std::unique_lock const lock(clients_mutex_);
+    forwarded_.erase(upstream_id);
+
+    // Notified with the lock held; the destructor may be waiting for this handler to release the object
+    forwarded_cv_.notify_all();
+}
+
+void Proxy::queue(Client &client, std::string_view data) const
+{
+    if (client.closing) {
+        return;
+    }
+
+    // A client that doesn't keep up is dropped; holding everything for it would only delay the inevitable
+    if (client.output.size() + data.size() > options_.max_output) {
+        client.output.clear();
+        client.closing = true;
+        return;
+    }
+    client.output.append(data);
+}
+
+void Proxy::dispatch_handler(Connection::event_batch_t events)
+{
+    {
+        std::unique_lock const lock(clients_mutex_);
+        for (auto const *const event : events) {
+            if (auto const action_id = event->get_value("ActionID")) {
+                if (auto const it = originations_.find(action_id.value()); it != originations_.end()) {
+                    if (auto const client = clients_.find(it->second.client); client != clients_.end()) {
+                        queue(client->second, rewrite(event->to_string(), it->first, it->second.action_id));
+                    }
+                    if (event->get_value("Event") == "OriginateResponse") {
+                        originations_.erase(it);
+                    }
+                    continue;
+                }
+            }
+
+            // Serialized once however many clients receive it
+            std::string message;
+            for (auto &[_, client] : clients_) {
+                if (!client.user || !wants(client, *event)) {
+                    continue;
+                }
+                if (message.empty()) {
+                    message = event->to_string();
+                }
+                if (passes(client, message)) {
+                    queue(client, message);
+                }
+            }
+        }
+    }
+    wake();
+}
+
+void Proxy::wake() const
+{
+    uint64_t const one = 1;
+    [[maybe_unused]] auto const ret = ::write(wake_fd_, &one, sizeof(one));
+}
+
+void Proxy::set_event_mask(Client &client, std::string_view mask)
+{
+    client.all_events = false;
+    client.event_classes.clear();
+
+    auto const lower = to_lower(mask);
+    if (lower == "on" || lower == "yes" || lower == "true" || lower == "all") {
+        client.all_events = true;
+        return;
+    }
+    if (lower == "off" || lower == "no" || lower == "false") {
+        return;
+    }
+
+    std::string_view classes(lower);
+    while (!classes.empty()) {
+        auto const comma = classes.find(',');
+        auto cls = classes.substr(0, comma);
+        classes.remove_prefix(comma == std::string_view::npos ? classes.length() : comma + 1);
+
+        while (!cls.empty() && std::isspace(static_cast<unsigned char>(cls.front()))) {
+            cls.remove_prefix(1);
+        }
+        while (!cls.empty() && std::isspace(static_cast<unsigned char>(cls.back()))) {
+            cls.remove_suffix(1);
+        }
+        if (cls == "all") {
+            client.all_events = true;
+        }
+        else if (!cls.empty()) {
+            client.event_classes.emplace(cls);
+        }
+    }
+}
+
+bool Proxy::wants(Client const &client, util::KeyValDict const &event)
+{
+    if (client.all_events) {
+        return true;
+    }
+    if (client.event_classes.empty()) {
+        return false;
+    }
+
+    // Privilege lists the classes of the event followed by "all"
+    auto const privilege = event.get_value("Privilege");
+    if (!privilege) {
+        return false;
+    }
+    std::string_view classes(privilege.value());
+    while (!classes.empty()) {
+        auto const comma = classes.find(',');
+        auto const cls = classes.substr(0, comma);
+        classes.remove_prefix(comma == std::string_view::npos ? classes.length() : comma + 1);
+        if (cls != "all" && client.event_classes.contains(to_lower(cls))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Proxy::passes(Client const &client, std::string const &message)
+{
+    auto const matches = [&message](std::regex const &filter) -> bool { return std::regex_search(message, filter); };
+    if (!client.include_filters.empty() && std::ranges::none_of(client.include_filters, matches)) {
+        return false;
+    }
+    return std::ranges::none_of(client.exclude_filters, matches);
+}
+
+std::string Proxy::rewrite(std::string message, std::string const &from, std::optional<std::string> const &to)
+{
+    auto const upstream_line = fmt::format("ActionID: {}{}", from, EOR);
+    auto const client_line = to ? fmt::format("ActionID: {}{}", to.value(), EOR) : std::string();
+    for (auto pos = message.find(upstream_line); pos != std::string::npos;
+        pos = message.find(upstream_line, pos + client_line.length())) {
+        message.replace(pos, upstream_line.length(), client_line);
+    }
+    return message;
+}
+
+std::string Proxy::serialize(reaction::Reaction const &reaction, bool command)
+{
+    // Other responses are parsed into key/value pairs that serialize back the way they were received
+    auto const *const list = dynamic_cast<reaction::EventList const *>(&reaction);
+    if (!command || !list) {
+        return reaction.to_string();
+    }
+
+    // The output was streamed as CommandOutput items, one Output value per line; put the single response back together
+    auto const &head = list->get_head();
+    auto const legacy = head.get_value("Response") == "Follows";
+    std::string message;
+    for (auto const &key : head.get_keys()) {
+        if (key != "EventList") {
+            message += fmt::format("{}{}{}{}", key, SEP, head[key], EOR);
+        }
+    }
+    for (size_t i = 0; i < list->event_count(); ++i) {
+        auto const output = list->get_event(i).get_value("Output");
+        if (!output) {
+            continue;
+        }
+        std::string_view lines(output.value());
+        while (true) {
+            auto const eol = lines.find('\n');
+            auto const line = lines.substr(0, eol);
+            message += legacy ? fmt::format("{}\n", line) : fmt::format("Output: {}{}", line, EOR);
+            if (eol == std::string_view::npos) {
+                break;
+            }
+            lines.remove_prefix(eol + 1);
+        }
+    }
+    return message + (legacy ? "--END COMMAND--" + EOM : EOR);
+}
+
+int Proxy::listen(std::string const &endpoint)
+{
+    int fd = -1;
+    util::ScopeGuard fd_scope([&fd]() -> void {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    });
+
+    if (endpoint.starts_with("unix:")) {
+        auto const path = endpoint.substr(5);
+        sockaddr_un addr{ .sun_family = AF_UNIX, .sun_path = {} };
+        if (path.empty() || path.length() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error(fmt::format("Invalid socket path {}", path));
+        }
+        path.copy(addr.sun_path, path.length());
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd == -1) {
+            throw std::runtime_error(fmt::format("Error opening socket: {}", strerror(errno)));
+        }
+        // A stale socket left behind by a previous run would make bind fail
+        ::unlink(path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr const *>(&addr), sizeof(addr)) == -1) {
+            throw std::runtime_error(fmt::format("Unable to bind {}: {}", path, strerror(errno)));
+        }
+        // Only the user running the proxy may connect; nobody can before the socket listens
+        if (chmod(path.c_str(), S_IRUSR | S_IWUSR) == -1) {
+            throw std::runtime_error(fmt::format("Unable to restrict {}: {}", path, strerror(errno)));
+        }
+    }
+    else {
+        auto const colon = endpoint.rfind(':');
+        auto const host = colon == std::string::npos ? std::string("127.0.0.1") : endpoint.substr(0, colon);
+        auto const port = colon == std::string::npos ? endpoint : endpoint.substr(colon + 1);
+
+        addrinfo hints{};
+        hints.ai_flags = AI_PASSIVE;
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *res{};
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || res == nullptr) {
+            throw std::runtime_error(fmt::format("Invalid endpoint {}", endpoint));
+        }
+        util::ScopeGuard addrinfo_scope([res]() -> void { freeaddrinfo(res); });
+
+        fd = socket(res->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd == -1) {
+            throw std::runtime_error(fmt::format("Error opening socket: {}", strerror(errno)));
+        }
+        constexpr int reuse_on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse_on, sizeof(reuse_on));
+        if (bind(fd, res->ai_addr, res->ai_addrlen) == -1) {
+            throw std::runtime_error(fmt::format("Unable to bind {}: {}", endpoint, strerror(errno)));
+        }
+    }
+
+    if (::listen(fd, SOMAXCONN) == -1) {
+        throw std::runtime_error(fmt::format("Unable to listen on {}: {}", endpoint, strerror(errno)));
+    }
+    return std::exchange(fd, -1);
+}
@@ -0,0 +1,319 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef PROXY_PROXY_HPP
+#define PROXY_PROXY_HPP
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/DispatchGroup.hpp"
+#include "c++ami/reaction/Reaction.hpp"
+#include "c++ami/util/KeyValDict.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cpp_ami::net {
+class SocketPoller;
+}
+
+namespace cpp_ami::proxy {
+
+///
+/// @class Proxy
+///
+/// @brief Multiplexes many downstream AMI clients onto one upstream AMI session.
+///
+/// The proxy logs in to the upstream AMI server once, with events enabled, and listens for downstream clients on a
+/// local TCP or Unix socket; a Unix socket is only accessible to the user running the proxy. Clients speak plain AMI
+/// to the proxy:
+///
+/// - Clients log in with the credentials of one of \c Options::users; until then every action but \c Login and
+///   \c Logoff is denied. A failed login closes the session. Challenge/response authentication isn't supported.
+/// - \c Events, \c Filter and \c Logoff are answered by the proxy itself: \c Login and \c Events set the event classes
+///   the client receives and \c Filter adds a filter on them, as the AMI server would. \c WaitEvent would block the
+///   session every client shares and is rejected.
+/// - Every other action the user is allowed to send is forwarded upstream under an ActionID of the proxy's own, so that
+///   actions of different clients can't collide. The response is relayed the way the AMI server sent it, rewritten
+///   back to the client's ActionID.
+/// - Each upstream event is serialized once and written to every logged in client whose event mask covers its
+///   \c Privilege and whose filters let it through. The OriginateResponse of an asynchronous \c Originate only goes to
+///   the client that sent it.
+///
+/// Upstream the proxy is an ordinary \c Connection; downstream clients are serviced by a single thread. A client that
+/// falls more than \c Options::max_output bytes behind, or sends a request larger than \c Options::max_input bytes, is
+/// disconnected rather than buffered without bound. When the upstream session drops, \c reconnect logs in again; the
+/// clients stay connected and are told with a \c Shutdown event once the session is lost and a \c FullyBooted event
+/// once it is back.
+///
+class Proxy {
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    ///
+    /// @struct User
+    ///
+    /// @brief Credentials and permissions of a client user.
+    ///
+    struct User {
+        std::string secret;                             ///< Secret the user logs in with.
+        std::unordered_set<std::string> actions;        ///< Actions the user may send upstream, in lower case; "*" allows every action.
+    };
+
+    ///
+    /// @struct Options
+    ///
+    /// @brief Upstream server, downstream endpoint and client users of a proxy.
+    ///
+    struct Options {
+        std::string listen;                                             ///< Endpoint clients connect to: unix:<path> or [<host>:]<port>; the host defaults to 127.0.0.1.
+        std::unordered_map<std::string, User> users;                    ///< Users clients log in as, keyed by username.
+        std::string hostname;                                           ///< Hostname of the upstream AMI server.
+        uint16_t port{ 5038 };                                          ///< Port of the upstream AMI server.
+        std::string username;                                           ///< Username to log in upstream with.
+        std::string secret;                                             ///< Secret to log in upstream with.
+        std::chrono::milliseconds timeout{ std::chrono::seconds(30) };  ///< Amount of time the upstream server has to answer a forwarded action.
+        size_t max_output{ 16 * 1024 * 1024 };                          ///< Number of bytes queued for a client before it is disconnected.
+        size_t max_input{ 64 * 1024 };                                  ///< Number of bytes of an unfinished request a client is disconnected at.
+    };
+
+public:
+    Proxy() = delete;
+    Proxy(Proxy const &) = delete;
+    Proxy(Proxy &&) noexcept = delete;
+
+    /// @brief Logs in to the upstream AMI server, starts listening for clients and starts the client thread.
+    ///
+    /// @param options Upstream server and downstream endpoint.
+    /// @param poller Poller reading the upstream socket.
+    /// @param group Dispatch group dispatching upstream events.
+    ///
+    /// An exception is raised if the upstream login fails or the endpoint can't be listened on.
+    Proxy(Options const &options, std::shared_ptr<net::SocketPoller> poller, std::shared_ptr<DispatchGroup> group);
+
+    /// @brief Disconnects every client and the upstream session.
+    virtual ~Proxy();
+
+    Proxy& operator=(Proxy const &) = delete;
+    Proxy& operator=(Proxy &&) noexcept = delete;
+
+    /// @brief Returns \c true until the upstream AMI server closes the session.
+    ///
+    /// @return \c true if the upstream session is open.
+    bool is_connected() const;
+
+    /// @brief Replaces a closed upstream session with a new one. The first attempt after the session closed tells the
+    ///        clients with a \c Shutdown event; actions still outstanding on the closed session are answered with an
+    ///        error. Once logged in again, the clients are sent a \c FullyBooted event.
+    ///
+    /// An exception is raised if the upstream server can't be connected to or the login fails; the attempt may be
+    /// repeated.
+    void reconnect();
+
+    /// @brief Returns \c true while the proxy services its clients. Clients are no longer serviced once polling their
+    ///        sockets fails.
+    ///
+    /// @return \c true if the client thread is running.
+    bool is_listening() const;
+
+    /// @brief Returns the number of connected clients.
+    ///
+    /// @return Number of clients.
+    size_t get_clients() const;
+
+    /// @brief Replaces the upstream ActionID \c from in \c message with \c to, or drops it if \c to is empty.
+    ///
+    /// @return Rewritten message.
+    ///
+    /// @param message Upstream message.
+    /// @param from ActionID used upstream.
+    /// @param to ActionID the client sent, if any.
+    static std::string rewrite(std::string message, std::string const &from, std::optional<std::string> const &to);
+
+    /// @brief Returns \c reaction in the format the AMI server sent it.
+    ///
+    /// @return Upstream message.
+    ///
+    /// @param reaction Reaction to a forwarded action.
+    /// @param command Flag indicating that the action was a \c Command, whose output the parser turns into an
+    ///        EventList of \c CommandOutput items.
+    static std::string serialize(reaction::Reaction const &reaction, bool command);
+
+private:
+    ///
+    /// @struct Client
+    ///
+    /// @brief Downstream client.
+    ///
+    struct Client {
+        int fd{ -1 };                                   ///< Client socket.
+        std::string input;                              ///< Bytes read but not parsed into requests yet.
+        std::string output;                             ///< Bytes waiting to be written.
+        std::optional<std::string> user;                ///< User the client logged in as, if any.
+        bool all_events{ true };                        ///< Flag indicating that the client receives every event.
+        std::unordered_set<std::string> event_classes;  ///< Event classes the client receives, unless \c all_events.
+        std::vector<std::regex> include_filters;        ///< Filters an event must match one of, if any.
+        std::vector<std::regex> exclude_filters;        ///< Filters an event must match none of.
+        bool closing{ false };                          ///< Flag to close the client once \c output is written.
+    };
+
+    ///
+    /// @struct Origination
+    ///
+    /// @brief Asynchronous Originate forwarded upstream whose OriginateResponse is still to come.
+    ///
+    struct Origination {
+        uint64_t client{ 0 };                           ///< Client that sent the action.
+        std::optional<std::string> action_id;           ///< ActionID the client sent, if any.
+        clock_t::time_point sent;                       ///< Time the action was forwarded.
+    };
+
+    /// @brief Client thread for this object.
+    void work_thread();
+
+    /// @brief Accepts every pending client connection.
+    void accept_clients();
+
+    /// @brief Reads from client \c id and handles every complete request read.
+    ///
+    /// @param id ID of the client.
+    void read_client(uint64_t id);
+
+    /// @brief Writes as much of the output of \c client as the socket takes. Caller must hold \c clients_mutex_.
+    ///
+    /// @param client Client to write to.
+    static void write_client(Client &client);
+
+    /// @brief Handles a request of client \c id.
+    ///
+    /// @param id ID of the client.
+    /// @param request Request message.
+    void handle_request(uint64_t id, std::string request);
+
+    /// @brief Logs client \c id in with the credentials in \c request, or closes it if they don't match a user.
+    ///
+    /// @param id ID of the client.
+    /// @param request Login request.
+    void login(uint64_t id, util::KeyValDict const &request);
+
+    /// @brief Adds the filter in \c request to the events client \c id receives.
+    ///
+    /// @param id ID of the client.
+    /// @param request Filter request.
+    void add_filter(uint64_t id, util::KeyValDict const &request);
+
+    /// @brief Forwards \c request of client \c id upstream and routes the response back to it.
+    ///
+    /// @param id ID of the client.
+    /// @param request Request message.
+    /// @param action_id ActionID the client sent, if any.
+    void forward(uint64_t id, util::KeyValDict const &request, std::optional<std::string> const &action_id);
+
+    /// @brief Queues \c message for client \c id and wakes the client thread.
+    ///
+    /// @param id ID of the client.
+    /// @param message Message to write.
+    /// @param close Flag to disconnect the client once the message is written.
+    void reply(uint64_t id, std::string_view message, bool close = false);
+
+    /// @brief Queues \c message for every logged in client and wakes the client thread.
+    ///
+    /// @param message Message to write.
+    void notify(std::string_view message);
+
+    /// @brief Connects and logs in to the upstream AMI server.
+    ///
+    /// @return Upstream session.
+    std::unique_ptr<Connection> connect();
+
+    /// @brief Cancels the forwarded \c actions outstanding on \c upstream and waits for their responses to be routed.
+    ///
+    /// @param upstream Upstream session the actions were sent over.
+    /// @param actions Forwarded actions.
+    void close_forwarded(Connection &upstream, std::vector<action::Action> const &actions);
+
+    /// @brief Forgets the forwarded action \c upstream_id once its response has been routed.
+    ///
+    /// @param upstream_id ActionID used upstream.
+    void retire(std::string const &upstream_id);
+
+    /// @brief Queues \c data for \c client. Caller must hold \c clients_mutex_.
+    ///
+    /// @param client Client to write to.
+    /// @param data Data to write.
+    void queue(Client &client, std::string_view data) const;
+
+    /// @brief Writes the upstream events in \c events to the clients that want them.
+    ///
+    /// @param events Batch of events.
+    void dispatch_handler(Connection::event_batch_t events);
+
+    /// @brief Wakes the client thread so that it writes queued output.
+    void wake() const;
+
+    /// @brief Sets the event classes \c client receives from an \c Events or \c EventMask value.
+    ///
+    /// @param client Client.
+    /// @param mask Event mask, e.g. on, off or a comma-separated list such as call,agent.
+    static void set_event_mask(Client &client, std::string_view mask);
+
+    /// @brief Returns \c true if \c client receives \c event.
+    ///
+    /// @return \c true if the event mask of the client covers the \c Privilege of the event.
+    ///
+    /// @param client Client.
+    /// @param event Upstream event.
+    static bool wants(Client const &client, util::KeyValDict const &event);
+
+    /// @brief Returns \c true if the filters of \c client let \c message through.
+    ///
+    /// @return \c true if \c message matches an include filter, or there are none, and no exclude filter.
+    ///
+    /// @param client Client.
+    /// @param message Serialized upstream event.
+    static bool passes(Client const &client, std::string const &message);
+
+    /// @brief Opens a listening socket on \c endpoint.
+    ///
+    /// @return Socket file descriptor.
+    ///
+    /// @param endpoint unix:<path> or [<host>:]<port>.
+    static int listen(std::string const &endpoint);
+
+    Options options_;                                       ///< Upstream server, downstream endpoint and client users.
+    std::shared_ptr<net::SocketPoller> poller_;             ///< Poller reading the upstream socket.
+    std::shared_ptr<DispatchGroup> group_;                  ///< Dispatch group dispatching upstream events.
+    std::unique_ptr<Connection> upstream_;                  ///< Upstream AMI session.
+    mutable std::shared_mutex upstream_mutex_;              ///< Mutex to keep the upstream session from being replaced while in use.
+    std::atomic<bool> upstream_lost_{ false };              ///< Flag indicating that the clients were told the upstream session closed.
+    std::string greeting_;                                  ///< Banner sent to clients when they connect. Guarded by \c clients_mutex_.
+
+    int listen_fd_{ -1 };                                   ///< Listening socket.
+    int wake_fd_{ -1 };                                     ///< Event file descriptor used to wake the client thread.
+
+    std::unordered_map<uint64_t, Client> clients_;          ///< Clients keyed by ID.
+    uint64_t next_client_{ 0 };                             ///< ID of the next client.
+    std::unordered_map<std::string, Origination> originations_;    ///< Asynchronous originations keyed by upstream ActionID.
+    std::unordered_map<std::string, action::Action> forwarded_;    ///< Actions forwarded upstream and not answered yet, keyed by upstream ActionID.
+    std::condition_variable forwarded_cv_;                  ///< Condition variable used to wait for forwarded actions to be answered.
+    mutable std::mutex clients_mutex_;                      ///< Mutex to control access to the clients, originations and forwarded actions.
+
+    std::thread thread_;                                    ///< Handle to client thread.
+    std::atomic<bool> thread_run_{ false };                 ///< Flag to stop the client thread; cleared once it stops.
+};
+
+}
+
+#endif
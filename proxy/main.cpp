@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "Proxy.hpp"
+
+#include "c++ami/DispatchGroup.hpp"
+#include "c++ami/net/SocketPoller.hpp"
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <exception>
+#include <fmt/core.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using users_t = std::unordered_map<std::string, cpp_ami::proxy::Proxy::User>;
+
+/// @brief Reads the client users from \c path: one user per line as <username> <secret> [<action>,...], where * allows
+///        every action. Empty lines and lines starting with # are skipped.
+users_t load_users(std::string const &path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to read users from {}", path));
+    }
+
+    users_t users;
+    std::string line;
+    for (size_t number = 1; std::getline(file, line); ++number) {
+        std::istringstream fields(line);
+        std::string username;
+        std::string secret;
+        std::string actions;
+        if (!(fields >> username) || username.starts_with('#')) {
+            continue;
+        }
+        if (!(fields >> secret)) {
+            throw std::runtime_error(fmt::format("{}:{}: missing secret for user {}", path, number, username));
+        }
+        fields >> actions;
+
+        auto &user = users[username];
+        user.secret = secret;
+        std::ranges::transform(actions, actions.begin(), [](unsigned char c) -> char { return std::tolower(c); });
+        for (std::istringstream list(actions); std::getline(list, line, ',');) {
+            if (!line.empty()) {
+                user.actions.insert(line);
+            }
+        }
+    }
+    return users;
+}
+
+/// @brief Parses the proxy options of one upstream server from \c args.
+cpp_ami::proxy::Proxy::Options parse_options(char **args, users_t const &users)
+{
+    cpp_ami::proxy::Proxy::Options options;
+    options.listen = args[0];
+    options.users = users;
+    options.username = args[2];
+    options.secret = args[3];
+
+    std::string const server(args[1]);
+    auto const colon = server.rfind(':');
+    options.hostname = server.substr(0, colon);
+    if (colon != std::string::npos) {
+        options.port = static_cast<uint16_t>(std::stoul(server.substr(colon + 1)));
+    }
+    return options;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 7 || std::string_view(argv[1]) != "-u" || (argc - 3) % 4 != 0) {
+        fmt::print(stderr, "usage: {} -u <users> <listen> <host>[:<port>] <username> <secret> "
+            "[<listen> <host>[:<port>] ...]\n"
+            "  <users> lists the client users, one per line: <username> <secret> [<action>,...|*]\n"
+            "  <listen> is unix:<path>, accessible to the current user only, or [<host>:]<port>\n", argv[0]);
+        return 2;
+    }
+
+    // Clients vanish without notice; a write to a closed socket must not take the proxy down
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    // Every upstream session shares the poller and dispatch threads; the proxies are destroyed first
+    auto const poller = std::make_shared<cpp_ami::net::SocketPoller>();
+    auto const group = std::make_shared<cpp_ami::DispatchGroup>();
+    std::vector<std::pair<cpp_ami::proxy::Proxy::Options, std::unique_ptr<cpp_ami::proxy::Proxy>>> proxies;
+
+    try {
+        auto const users = load_users(argv[2]);
+        for (int i = 3; i < argc; i += 4) {
+            auto options = parse_options(argv + i, users);
+            proxies.emplace_back(options, std::make_unique<cpp_ami::proxy::Proxy>(options, poller, group));
+            fmt::print("Proxying {}:{} on {}\n", options.hostname, options.port, options.listen);
+        }
+    }
+    catch (std::exception const &e) {
+        fmt::print(stderr, "{}\n", e.what());
+        return 1;
+    }
+
+    // An upstream server that goes away only affects the clients of its own proxy; keep trying to log in again
+    timespec const interval{ .tv_sec = 1, .tv_nsec = 0 };
+    while (sigtimedwait(&signals, nullptr, &interval) == -1) {
+        for (auto const &[options, proxy] : proxies) {
+            if (!proxy->is_listening()) {
+                fmt::print(stderr, "No longer listening on {}\n", options.listen);
+                return 1;
+            }
+            if (proxy->is_connected()) {
+                continue;
+            }
+            try {
+                proxy->reconnect();
+                fmt::print("Reconnected to {}:{}\n", options.hostname, options.port);
+            }
+            catch (std::exception const &e) {
+                fmt::print(stderr, "Upstream session to {}:{} closed; {}\n", options.hostname, options.port,
+                    e.what());
+            }
+        }
+    }
+    return 0;
+}
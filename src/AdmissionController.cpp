@@ -0,0 +1,227 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/AdmissionController.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <pthread.h>
+#include <utility>
+
+using namespace cpp_ami;
+
+AdmissionController::AdmissionController(write_t write, fail_t fail, size_t max_in_flight)
+    : write_(std::move(write))
+    , fail_(std::move(fail))
+    , max_in_flight_(max_in_flight)
+{
+}
+
+AdmissionController::~AdmissionController()
+{
+    close();
+}
+
+void AdmissionController::set_max_in_flight(size_t max_in_flight)
+{
+    std::unique_lock lock(mutex_);
+    max_in_flight_ = max_in_flight;
+    auto admitted = pump();
+
+    // Actions still waiting for the writer thread go first
+    if (!outbox_.empty()) {
+        enqueue(std::move(admitted));
+        return;
+    }
+    lock.unlock();
+
+    write(admitted);
+}
+
+void AdmissionController::submit(std::vector<Request> requests)
+{
+    std::vector<Request> admitted;
+    {
+        std::unique_lock const lock(mutex_);
+
+        for (auto &request : requests) {
+            // Request was retired (timed out) before it made it here; don't send it
+            if (orphaned_.erase(request.action_id) > 0) {
+                continue;
+            }
+
+            // Don't let a new action overtake actions that are already waiting in the same or a more urgent lane
+            auto const lane_idx = static_cast<size_t>(request.priority);
+            assert(lane_idx < LANE_COUNT);
+            auto waiting = false;
+            for (size_t idx = 0; idx <= lane_idx; ++idx) {
+                waiting = waiting || !lanes_[idx].empty();
+            }
+
+            if (!waiting && has_capacity()) {
+                in_flight_.insert(request.action_id);
+                admitted.push_back(std::move(request));
+                ++admitted_;
+                continue;
+            }
+
+            auto &lane = lanes_[lane_idx];
+            auto const action_id = request.action_id;
+            lane.push_back(std::move(request));
+            queued_.emplace(action_id, std::prev(lane.end()));
+            ++deferred_;
+        }
+
+        // Don't overtake actions that were admitted earlier but are still waiting for the writer thread
+        if (!outbox_.empty()) {
+            enqueue(std::move(admitted));
+            return;
+        }
+    }
+
+    write(admitted);
+}
+
+void AdmissionController::release(std::string const &action_id)
+{
+    std::unique_lock lock(mutex_);
+
+    // Action retired while still waiting in a lane; it was never sent so it doesn't free up a slot
+    if (auto const it = queued_.find(action_id); it != queued_.end()) {
+        lanes_[static_cast<size_t>(it->second->priority)].erase(it->second);
+        queued_.erase(it);
+        return;
+    }
+
+    // Action retired before it was submitted; remember it so that submit drops it. Only the most recent are kept, an
+    // action that is never submitted at all would otherwise be remembered forever
+    if (in_flight_.erase(action_id) == 0) {
+        if (orphaned_.insert(action_id).second) {
+            orphan_order_.push_back(action_id);
+        }
+        if (orphan_order_.size() > MAX_ORPHANED) {
+            orphaned_.erase(orphan_order_.front());
+            orphan_order_.pop_front();
+        }
+        return;
+    }
+
+    // Retirements are reported on the dispatcher's response thread; leave the writing to the writer thread
+    enqueue(pump());
+}
+
+void AdmissionController::flush()
+{
+    std::unique_lock lock(mutex_);
+    outbox_cv_.wait(lock, [this]() -> bool { return (outbox_.empty() && !writing_) || closed_; });
+}
+
+void AdmissionController::close()
+{
+    {
+        std::unique_lock const lock(mutex_);
+        closed_ = true;
+        outbox_cv_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+AdmissionController::Metrics AdmissionController::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+
+    Metrics metrics{
+        .max_in_flight = max_in_flight_,
+        .in_flight = in_flight_.size(),
+        .admitted = admitted_,
+        .deferred = deferred_,
+        .orphaned = orphaned_.size(),
+    };
+    for (size_t idx = 0; idx < LANE_COUNT; ++idx) {
+        metrics.queued[idx] = lanes_[idx].size();
+    }
+    return metrics;
+}
+
+bool AdmissionController::has_capacity() const
+{
+    return max_in_flight_ == 0 || in_flight_.size() < max_in_flight_;
+}
+
+std::vector<AdmissionController::Request> AdmissionController::pump()
+{
+    std::vector<Request> admitted;
+    for (auto &lane : lanes_) {
+        while (!lane.empty() && has_capacity()) {
+            auto &request = lane.front();
+            queued_.erase(request.action_id);
+            in_flight_.insert(request.action_id);
+            admitted.push_back(std::move(request));
+            lane.pop_front();
+        }
+    }
+    return admitted;
+}
+
+void AdmissionController::write(std::vector<Request> const &requests) const
+{
+    if (requests.empty()) {
+        return;
+    }
+
+    try {
+        if (requests.size() == 1) {
+            write_(requests.front().buf);
+        }
+        else {
+            // Pipeline everything that was admitted together into a single write
+            std::string buf;
+            for (auto const &request : requests) {
+                buf += request.buf;
+            }
+            write_(buf);
+        }
+    }
+    catch (...) {
+        auto const err = std::current_exception();
+        for (auto const &request : requests) {
+            fail_(request.action_id, err);
+        }
+    }
+}
+
+void AdmissionController::enqueue(std::vector<Request> requests)
+{
+    if (requests.empty() || closed_) {
+        return;
+    }
+
+    outbox_.insert(outbox_.end(), std::make_move_iterator(requests.begin()), std::make_move_iterator(requests.end()));
+    if (!thread_.joinable()) {
+        thread_ = std::thread(&AdmissionController::work_thread, this);
+        pthread_setname_np(thread_.native_handle(), "ami_admission");
+    }
+    outbox_cv_.notify_all();
+}
+
+void AdmissionController::work_thread()
+{
+    std::unique_lock lock(mutex_);
+    while (true) {
+        outbox_cv_.wait(lock, [this]() -> bool { return !outbox_.empty() || closed_; });
+        if (closed_) {
+            return;
+        }
+
+        // Write outside of the lock; a failed write retires its actions, which comes back through release
+        auto const requests = std::exchange(outbox_, {});
+        writing_ = true;
+        lock.unlock();
+        write(requests);
+        lock.lock();
+        writing_ = false;
+        outbox_cv_.notify_all();
+    }
+}
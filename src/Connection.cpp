@@ -4,46 +4,98 @@
 #include "c++ami/Connection.hpp"
 
 #include "c++ami/action/Action.hpp"
+#include "c++ami/net/SocketPoller.hpp"
 #include "c++ami/net/SocketReader.hpp"
 #include "c++ami/net/SocketWriter.hpp"
 #include "c++ami/net/TcpSocket.hpp"
 #include "c++ami/StreamParser.hpp"
 #include <fmt/core.h>
+#include <stdexcept>
+#include <unordered_set>
 
 using namespace cpp_ami;
 
 Connection::Connection(std::string_view hostname, uint16_t port)
+    : Connection(hostname, port, nullptr, nullptr)
 {
-    auto sock = std::make_shared<net::TcpSocket>(hostname, port);
+}
+
+Connection::Connection(std::string_view hostname, uint16_t port, std::shared_ptr<net::SocketPoller> poller,
+    std::shared_ptr<DispatchGroup> group)
+    : poller_(std::move(poller))
+    , socket_(std::make_shared<net::TcpSocket>(hostname, port))
+{
+    admission_ = std::make_unique<AdmissionController>(
+        [this](std::string const &buf) -> void {
+            writer_->write(buf);
+        },
+        [this](std::string const &action_id, std::exception_ptr const &err) -> void {
+            dispatcher_->set_exception_on_pipe(action_id, err);
+        },
+        0);
 
     dispatcher_ = std::make_unique<EventDispatcher>(
-        [this](EventDispatcher::event_ptr_t dict) -> void {
-            dispatch_handler(std::move(dict));
-        });
+        [this](EventDispatcher::event_batch_t events) -> void {
+            dispatch_handler(events);
+        },
+        [this](std::string const &action_id) -> void {
+            admission_->release(action_id);
+        },
+        std::move(group));
 
+    // Only one thread ever feeds a polled socket to the parser, so it is parsed right there
     stream_parser_ = std::make_unique<StreamParser>(
         [this](std::string ami_version) -> void {
             ami_version_ = std::move(ami_version);
         },
         [this](std::string event) -> void {
             dispatcher_->add_event(std::move(event));
-        });
+        },
+        !poller_);
 
-    reader_ = std::make_unique<net::SocketReader>(sock,
-        [this](std::string buf) -> void {
-            stream_parser_->add_buf(std::move(buf));
-    });
+    writer_ = std::make_unique<net::SocketWriter>(socket_);
 
-    writer_ = std::make_unique<net::SocketWriter>(sock);
+    if (poller_) {
+        poller_->add(socket_,
+            [this](std::string buf) -> void {
+                stream_parser_->add_buf(std::move(buf));
+            },
+            [this]() -> void {
+                connected_ = false;
+            });
+    }
+    else {
+        reader_ = std::make_unique<net::SocketReader>(socket_,
+            [this](std::string buf) -> void {
+                stream_parser_->add_buf(std::move(buf));
+        });
+    }
 }
 
 Connection::~Connection()
 {
-    // Make sure objects get deleted in correct order
+    // Make sure objects get deleted in correct order; requests retired while the dispatcher shuts down may still
+    // admit queued actions, so the writer and admission controller go last
+    if (poller_) {
+        poller_->remove(*socket_);
+    }
     reader_.reset();
-    writer_.reset();
     stream_parser_.reset();
+
+    // Nothing is written once the session goes; requests admitted while the dispatcher closes the rest are dropped
+    admission_->close();
+
+    // Subscribers hold on to events recycled through the dispatcher's pool; drain them before the dispatcher goes
+    decltype(subscribers_) subscribers;
+    {
+        std::unique_lock const lock(callbacks_mutex_);
+        std::swap(subscribers_, subscribers);
+    }
+    subscribers.clear();
+
     dispatcher_.reset();
+    writer_.reset();
+    admission_.reset();
 }
 
 std::string Connection::get_ami_version() const
@@ -51,12 +103,52 @@ std::string Connection::get_ami_version() const
     return ami_version_;
 }
 
-void Connection::dispatch_handler(EventDispatcher::event_ptr_t dict)
+bool Connection::is_connected() const
 {
-    std::unique_lock const lock(callbacks_mutex_);
-    for (auto const &[_, callback] : callbacks_) {
-        callback(dict.get());
+    return connected_;
+}
+
+void Connection::dispatch_handler(EventDispatcher::event_batch_t events)
+{
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::unique_lock const lock(callbacks_mutex_);
+        for (auto const &dict : events) {
+            for (auto const &[_, callback] : callbacks_) {
+                callback(dict.get());
+            }
+        }
+
+        if (!batch_callbacks_.empty()) {
+            batch_.clear();
+            for (auto const &dict : events) {
+                batch_.push_back(dict.get());
+            }
+            for (auto const &[_, callback] : batch_callbacks_) {
+                callback(batch_);
+            }
+        }
+
+        subscribers.reserve(subscribers_.size());
+        for (auto const &[_, subscriber] : subscribers_) {
+            subscribers.push_back(subscriber);
+        }
+    }
+
+    if (subscribers.empty()) {
+        return;
     }
+
+    // Subscribers are fed outside of the lock; a blocking subscriber that is full may hold up the dispatcher, but it
+    // won't hold up adding or removing callbacks
+    shared_batch_.clear();
+    for (auto &dict : events) {
+        shared_batch_.emplace_back(std::move(dict));
+    }
+    for (auto const &subscriber : subscribers) {
+        subscriber->push(shared_batch_);
+    }
+    shared_batch_.clear();
 }
 
 Connection::event_callback_key_t Connection::add_callback(event_callback_t callback)
@@ -67,10 +159,51 @@ Connection::event_callback_key_t Connection::add_callback(event_callback_t callb
     return id;
 }
 
-void Connection::remove_callback(event_callback_key_t const &key)
+Connection::event_callback_key_t Connection::add_batch_callback(event_batch_callback_t callback)
 {
+    auto const id = action::Action::create_uuid();
     std::unique_lock const lock(callbacks_mutex_);
-    callbacks_.erase(key);
+    batch_callbacks_.emplace(id, std::move(callback));
+    return id;
+}
+
+Connection::event_callback_key_t Connection::add_subscriber(event_callback_t callback, Subscriber::Options options)
+{
+    auto const id = action::Action::create_uuid();
+    auto subscriber = std::make_shared<Subscriber>(std::move(callback), std::move(options));
+    std::unique_lock const lock(callbacks_mutex_);
+    subscribers_.emplace(id, std::move(subscriber));
+    return id;
+}
+
+std::optional<Subscriber::Metrics> Connection::get_subscriber_metrics(event_callback_key_t const &id) const
+{
+    std::shared_ptr<Subscriber> subscriber;
+    {
+        std::unique_lock const lock(callbacks_mutex_);
+        auto const it = subscribers_.find(id);
+        if (it == subscribers_.end()) {
+            return std::nullopt;
+        }
+        subscriber = it->second;
+    }
+    return subscriber->get_metrics();
+}
+
+void Connection::remove_callback(event_callback_key_t const &key)
+{
+    std::shared_ptr<Subscriber> subscriber;
+    {
+        std::unique_lock const lock(callbacks_mutex_);
+        callbacks_.erase(key);
+        batch_callbacks_.erase(key);
+        if (auto const it = subscribers_.find(key); it != subscribers_.end()) {
+            subscriber = std::move(it->second);
+            subscribers_.erase(it);
+        }
+    }
+
+    // Subscriber drains its queue and stops its thread once the last reference goes, outside of the lock
 }
 
 void Connection::async_invoke(action::Action const &action) const
@@ -78,12 +211,36 @@ void Connection::async_invoke(action::Action const &action) const
     writer_->write(action.to_string());
 }
 
+void Connection::async_invoke(action::Action const &action, completion_handler_t handler,
+    std::chrono::milliseconds const &timeout) const
+{
+    // A request already outstanding under the same ActionID has the handler invoked with the error instead
+    if (!dispatcher_->add_completion_handler(action.get_action_id(), std::move(handler), timeout,
+        action.get_completion_event())) {
+        return;
+    }
+
+    // Send action to AMI; the handler is invoked by the dispatcher once the reaction is complete. If the action can't
+    // be sent then the error is handed to the handler rather than leaving the request pending.
+    submit(action);
+}
+
+void Connection::async_invoke(action::Action const &action, list_item_handler_t item_handler,
+    completion_handler_t handler, std::chrono::milliseconds const &timeout) const
+{
+    if (dispatcher_->add_streaming_handler(action.get_action_id(), std::move(item_handler), std::move(handler),
+        timeout)) {
+        submit(action);
+    }
+}
+
 Connection::reaction_ptr_t Connection::invoke(action::Action const &action) const
 {
-    auto reaction = dispatcher_->get_event_pipe(action.get_action_id());
+    auto reaction = dispatcher_->get_event_pipe(action.get_action_id(), EventDispatcher::timeout_t::zero(),
+        action.get_completion_event());
 
     // Send action to AMI; this will kick off creation of reaction pipe result
-    writer_->write(action.to_string());
+    submit(action);
 
     // Wait for and return event
     return reaction.get();
@@ -91,21 +248,111 @@ Connection::reaction_ptr_t Connection::invoke(action::Action const &action) cons
 
 Connection::reaction_ptr_t Connection::invoke(action::Action const &action, std::chrono::milliseconds const &timeout) const
 {
-    auto reaction = dispatcher_->get_event_pipe(action.get_action_id());
+    // The dispatcher owns the deadline; if the response isn't complete before timeout lapses the dispatcher pokes a
+    // timeout exception into the promise, causing future::get() to raise the exception. This also frees any partially
+    // built EventList rather than leaving it behind in the dispatcher.
+    auto reaction = dispatcher_->get_event_pipe(action.get_action_id(), timeout, action.get_completion_event());
 
     // Send action to AMI; this will kick off creation of reaction pipe result
-    writer_->write(action.to_string());
+    submit(action);
 
-    // If response isn't complete before timeout then raise an exception, however we can't raise an exception here
-    // otherwise the future will freak out causing an additional exceptions to be raised at the time of program
-    // termination (an std::broken_promise exception when the application terminates and
-    // promise::set_value()/future::get() wasn't invoked). In order to avoid that poke the exception into the promise,
-    // this will cause future::get() to raise the exception resulting in only one exception being raised.
-    std::runtime_error const err(fmt::format("Event timeout: Timeout waiting for event; ActionID={}", action.get_action_id()));
-    if (auto const status = reaction.wait_for(timeout); status == std::future_status::timeout) {
-        dispatcher_->set_exception_on_pipe(action.get_action_id(), std::make_exception_ptr(err));
-    }
+    // Wait for and return event
+    return reaction.get();
+}
+
+Connection::reaction_ptr_t Connection::invoke(action::Action const &action, list_item_handler_t item_handler,
+    std::chrono::milliseconds const &timeout) const
+{
+    EventDispatcher::pipe_t pipe;
+    auto reaction = pipe.get_future();
+    async_invoke(action, std::move(item_handler),
+        [&pipe](reaction_ptr_t list, std::exception_ptr err) -> void {
+            if (err) {
+                pipe.set_exception(err);
+            }
+            else {
+                pipe.set_value(std::move(list));
+            }
+        },
+        timeout);
 
-    // Return event
+    // Wait for the list to complete; the items have all been streamed by then
     return reaction.get();
 }
+
+std::vector<std::future<Connection::reaction_ptr_t>> Connection::invoke_many(std::span<action::Action const> actions,
+    std::chrono::milliseconds const &timeout) const
+{
+    // Reactions are correlated by ActionID; a repeated ID would leave one of the futures without a reaction
+    std::unordered_set<std::string> action_ids;
+    for (auto const &action : actions) {
+        if (!action_ids.insert(action.get_action_id()).second) {
+            throw std::runtime_error(fmt::format("Duplicate ActionID {} in batch", action.get_action_id()));
+        }
+    }
+
+    std::vector<std::future<reaction_ptr_t>> reactions;
+    reactions.reserve(actions.size());
+
+    // Register every reaction pipe and serialize every action
+    std::vector<AdmissionController::Request> requests;
+    requests.reserve(actions.size());
+    try {
+        for (auto const &action : actions) {
+            reactions.push_back(dispatcher_->get_event_pipe(action.get_action_id(), timeout,
+                action.get_completion_event()));
+            requests.push_back({ action.get_action_id(), action.get_priority(), action.to_string() });
+        }
+    }
+    catch (...) {
+        // An ActionID already outstanding fails the batch; none of it has been sent
+        for (auto const &request : requests) {
+            dispatcher_->withdraw_pipe(request.action_id);
+        }
+        throw;
+    }
+
+    // Everything that can be admitted is sent to AMI in a single write; if that fails every pipe is closed with the
+    // error
+    admission_->submit(std::move(requests));
+
+    return reactions;
+}
+
+InvokeAwaitable Connection::invoke_async(action::Action const &action, executor_t executor,
+    std::chrono::milliseconds const &timeout, std::stop_token stop_token) const
+{
+    return InvokeAwaitable(*this, action, std::move(executor), timeout, std::move(stop_token));
+}
+
+void Connection::cancel(action::Action const &action) const
+{
+    dispatcher_->set_null_on_pipe(action.get_action_id());
+}
+
+void Connection::set_conflation(std::unordered_set<std::string> event_types, std::chrono::milliseconds const &window)
+{
+    dispatcher_->set_conflation(std::move(event_types), window);
+}
+
+event::EventConflater::Metrics Connection::get_conflation_metrics() const
+{
+    return dispatcher_->get_conflation_metrics();
+}
+
+void Connection::set_max_in_flight(size_t max_in_flight)
+{
+    admission_->set_max_in_flight(max_in_flight);
+}
+
+AdmissionController::Metrics Connection::get_admission_metrics() const
+{
+    return admission_->get_metrics();
+}
+
+void Connection::submit(action::Action const &action) const
+{
+    std::vector<AdmissionController::Request> requests;
+    requests.push_back({ action.get_action_id(), action.get_priority(), action.to_string() });
+    admission_->submit(std::move(requests));
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/ConnectionPool.hpp"
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/action/Ping.hpp"
+#include "c++ami/net/SocketPoller.hpp"
+#include <fmt/core.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <utility>
+
+using namespace cpp_ami;
+
+ConnectionPool::ConnectionPool()
+    : ConnectionPool(Options{})
+{
+}
+
+ConnectionPool::ConnectionPool(Options const &options)
+    : options_(options)
+    , poller_(std::make_shared<net::SocketPoller>())
+    , group_(std::make_shared<DispatchGroup>())
+{
+    if (options_.health_interval > std::chrono::milliseconds::zero()) {
+        thread_ = std::thread(&ConnectionPool::work_thread, this);
+        pthread_setname_np(thread_.native_handle(), "ami_health");
+    }
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    if (thread_.joinable()) {
+        {
+            std::unique_lock const lock(thread_mutex_);
+            run_ = false;
+        }
+        thread_cv_.notify_one();
+        thread_.join();
+    }
+
+    // Members must be gone before the poller and dispatch group they share. Connections still referenced elsewhere
+    // outlive the pool, so they must stop calling back into it first
+    decltype(members_) members;
+    {
+        std::unique_lock const lock(members_mutex_);
+        std::swap(members_, members);
+    }
+    for (auto const &[_, member] : members) {
+        member.connection->remove_callback(member.callback_key);
+    }
+    members.clear();
+}
+
+std::shared_ptr<Connection> ConnectionPool::add_server(server_id_t const &id, std::string_view hostname, uint16_t port)
+{
+    {
+        std::unique_lock const lock(members_mutex_);
+        if (members_.contains(id)) {
+            throw std::runtime_error(fmt::format("ConnectionPool: server {} is already in the pool", id));
+        }
+    }
+
+    // Connecting may take a while; don't hold up the rest of the pool meanwhile
+    auto connection = std::make_shared<Connection>(hostname, port, poller_, group_);
+    auto const callback_key = connection->add_batch_callback([this, id](Connection::event_batch_t events) -> void {
+        dispatch_handler(id, events);
+    });
+
+    std::unique_lock const lock(members_mutex_);
+    auto const [it, inserted] = members_.try_emplace(id,
+        Member{ .connection = connection, .health = std::make_shared<HealthState>(), .callback_key = callback_key });
+    if (!inserted) {
+        connection->remove_callback(callback_key);
+        throw std::runtime_error(fmt::format("ConnectionPool: server {} is already in the pool", id));
+    }
+    return connection;
+}
+
+void ConnectionPool::remove_server(server_id_t const &id)
+{
+    Member member;
+    {
+        std::unique_lock const lock(members_mutex_);
+        auto const it = members_.find(id);
+        if (it == members_.end()) {
+            return;
+        }
+        member = std::move(it->second);
+        members_.erase(it);
+    }
+
+    // A reference held elsewhere keeps the connection, and so its callbacks, around after it leaves the pool
+    member.connection->remove_callback(member.callback_key);
+
+    // Shutting the connection down waits on the shared threads; don't hold the members lock meanwhile. Calls in
+    // progress hold references of their own, in which case the last of them closes the connection
+    member.connection.reset();
+}
+
+std::shared_ptr<Connection> ConnectionPool::get(server_id_t const &id) const
+{
+    std::unique_lock const lock(members_mutex_);
+    auto const it = members_.find(id);
+    if (it == members_.end()) {
+        throw std::runtime_error(fmt::format("ConnectionPool: server {} is not in the pool", id));
+    }
+    return it->second.connection;
+}
+
+std::vector<ConnectionPool::server_id_t> ConnectionPool::get_servers() const
+{
+    std::vector<server_id_t> servers;
+    std::unique_lock const lock(members_mutex_);
+    servers.reserve(members_.size());
+    for (auto const &[id, _] : members_) {
+        servers.push_back(id);
+    }
+    return servers;
+}
+
+ConnectionPool::reaction_ptr_t ConnectionPool::invoke(server_id_t const &id, action::Action const &action,
+    std::chrono::milliseconds const &timeout) const
+{
+    // The reference keeps the connection open should the server be removed while waiting
+    return get(id)->invoke(action, timeout);
+}
+
+void ConnectionPool::async_invoke(server_id_t const &id, action::Action const &action, completion_handler_t handler,
+    std::chrono::milliseconds const &timeout) const
+{
+    get(id)->async_invoke(action, std::move(handler), timeout);
+}
+
+ConnectionPool::event_callback_key_t ConnectionPool::add_callback(event_callback_t callback)
+{
+    auto const id = action::Action::create_uuid();
+    std::unique_lock const lock(callbacks_mutex_);
+    callbacks_.emplace(id, std::move(callback));
+    return id;
+}
+
+void ConnectionPool::remove_callback(event_callback_key_t const &id)
+{
+    std::unique_lock const lock(callbacks_mutex_);
+    callbacks_.erase(id);
+}
+
+std::optional<ConnectionPool::Health> ConnectionPool::get_health(server_id_t const &id) const
+{
+    std::shared_ptr<HealthState> state;
+    bool connected = false;
+    {
+        std::unique_lock const lock(members_mutex_);
+        auto const it = members_.find(id);
+        if (it == members_.end()) {
+            return std::nullopt;
+        }
+        state = it->second.health;
+        connected = it->second.connection->is_connected();
+    }
+
+    std::unique_lock const lock(state->mutex);
+    auto health = state->health;
+    health.connected = connected;
+    health.healthy = health.healthy && connected;
+    return health;
+}
+
+void ConnectionPool::check_health()
+{
+    // Servers are pinged outside of the members lock so that adding or removing a server doesn't wait on them
+    std::vector<std::pair<std::shared_ptr<Connection>, std::shared_ptr<HealthState>>> members;
+    {
+        std::unique_lock const lock(members_mutex_);
+        members.reserve(members_.size());
+        for (auto const &[_, member] : members_) {
+            members.emplace_back(member.connection, member.health);
+        }
+    }
+
+    for (auto const &[connection, state] : members) {
+        {
+            std::unique_lock const health_lock(state->mutex);
+            state->health.connected = connection->is_connected();
+            if (!state->health.connected) {
+                state->health.healthy = false;
+                continue;
+            }
+            if (std::exchange(state->pinging, true)) {
+                continue;
+            }
+        }
+
+        // The handler may run right away if the ping can't be sent, so the health lock isn't held here
+        auto const sent = clock_t::now();
+        connection->async_invoke(action::Ping(),
+            [state, sent](reaction_ptr_t reaction, std::exception_ptr err) -> void {
+                std::unique_lock const health_lock(state->mutex);
+                state->pinging = false;
+                if (!err && reaction && reaction->is_success()) {
+                    auto const now = clock_t::now();
+                    state->health.healthy = true;
+                    state->health.rtt = now - sent;
+                    state->health.last_reply = now;
+                    state->health.failures = 0;
+                }
+                else {
+                    state->health.healthy = false;
+                    ++state->health.failures;
+                }
+            },
+            options_.health_timeout);
+    }
+}
+
+void ConnectionPool::dispatch_handler(server_id_t const &id, Connection::event_batch_t events)
+{
+    std::unique_lock const lock(callbacks_mutex_);
+    for (auto const *const event : events) {
+        for (auto const &[_, callback] : callbacks_) {
+            callback(id, event);
+        }
+    }
+}
+
+void ConnectionPool::work_thread()
+{
+    std::unique_lock lock(thread_mutex_);
+    while (!thread_cv_.wait_for(lock, options_.health_interval, [this]() -> bool { return !run_; })) {
+        lock.unlock();
+        check_health();
+        lock.lock();
+    }
+}
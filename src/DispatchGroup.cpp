@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/DispatchGroup.hpp"
+
+#include "c++ami/EventDispatcher.hpp"
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <pthread.h>
+
+using namespace cpp_ami;
+
+DispatchGroup::DispatchGroup()
+{
+    auto &events = state(Lane::events);
+    events.thread = std::thread(&DispatchGroup::work_thread, this, Lane::events);
+    pthread_setname_np(events.thread.native_handle(), "ami_dispatcher");
+
+    auto &responses = state(Lane::responses);
+    responses.thread = std::thread(&DispatchGroup::work_thread, this, Lane::responses);
+    pthread_setname_np(responses.thread.native_handle(), "ami_responder");
+}
+
+DispatchGroup::~DispatchGroup()
+{
+    {
+        std::unique_lock const lock(mutex_);
+        assert(members_.empty());
+        run_ = false;
+        for (auto &lane : lanes_) {
+            lane.cv.notify_one();
+        }
+    }
+
+    for (auto &lane : lanes_) {
+        lane.thread.join();
+    }
+}
+
+size_t DispatchGroup::size() const
+{
+    std::unique_lock const lock(mutex_);
+    return members_.size();
+}
+
+void DispatchGroup::add(EventDispatcher *dispatcher)
+{
+    std::unique_lock const lock(mutex_);
+    members_.insert(dispatcher);
+}
+
+void DispatchGroup::remove(EventDispatcher *dispatcher)
+{
+    std::unique_lock lock(mutex_);
+    members_.erase(dispatcher);
+    for (auto &lane : lanes_) {
+        if (lane.queued.erase(dispatcher) > 0) {
+            std::erase(lane.ready, dispatcher);
+        }
+    }
+
+    idle_cv_.wait(lock, [this, dispatcher]() -> bool {
+        return std::ranges::none_of(lanes_, [dispatcher](auto const &lane) -> bool { return lane.busy == dispatcher; });
+    });
+}
+
+void DispatchGroup::wake(EventDispatcher *dispatcher, Lane lane)
+{
+    std::unique_lock const lock(mutex_);
+    // Woken while being removed; the member drains itself
+    if (!members_.contains(dispatcher)) {
+        return;
+    }
+
+    auto &st = state(lane);
+    if (st.queued.insert(dispatcher).second) {
+        st.ready.push_back(dispatcher);
+    }
+    st.cv.notify_one();
+}
+
+void DispatchGroup::work_thread(Lane lane)
+{
+    using clock_t = std::chrono::steady_clock;
+
+    auto &st = state(lane);
+    auto const is_due = [lane](EventDispatcher const *dispatcher, clock_t::time_point now) -> bool {
+        if (lane == Lane::events) {
+            auto const deadline = dispatcher->conflater_.next_deadline();
+            return deadline && deadline.value() <= now;
+        }
+        return dispatcher->timers_armed_;
+    };
+
+    std::unique_lock lock(mutex_);
+    while (run_) {
+        if (!st.ready.empty()) {
+            auto *const dispatcher = st.ready.front();
+            st.ready.pop_front();
+            st.queued.erase(dispatcher);
+            service(lock, dispatcher, lane);
+            continue;
+        }
+
+        // Sleep until the earliest deadline of any member; the response lane sweeps the members with requests
+        // outstanding once per tick of their timer wheels, regardless of how often responses wake it up
+        std::optional<clock_t::time_point> deadline;
+        for (auto const *const dispatcher : members_) {
+            std::optional<clock_t::time_point> next;
+            if (lane == Lane::events) {
+                next = dispatcher->conflater_.next_deadline();
+            }
+            else if (dispatcher->timers_armed_) {
+                next = st.swept + dispatcher->timers_.resolution();
+            }
+            if (next && (!deadline || next.value() < deadline.value())) {
+                deadline = next;
+            }
+        }
+
+        auto const has_work = [this, &st]() -> bool { return !run_ || !st.ready.empty(); };
+        if (deadline) {
+            st.cv.wait_until(lock, deadline.value(), has_work);
+        }
+        else {
+            st.cv.wait(lock, has_work);
+        }
+
+        auto const now = clock_t::now();
+        if (!run_ || !deadline || now < deadline.value()) {
+            continue;
+        }
+
+        st.swept = now;
+        for (auto *const dispatcher : members_) {
+            if (is_due(dispatcher, now) && st.queued.insert(dispatcher).second) {
+                st.ready.push_back(dispatcher);
+            }
+        }
+    }
+}
+
+void DispatchGroup::service(std::unique_lock<std::mutex> &lock, EventDispatcher *dispatcher, Lane lane)
+{
+    auto &st = state(lane);
+    st.busy = dispatcher;
+    lock.unlock();
+
+    if (lane == Lane::events) {
+        dispatcher->service_events();
+    }
+    else {
+        dispatcher->service_responses();
+    }
+
+    lock.lock();
+    st.busy = nullptr;
+    idle_cv_.notify_all();
+}
+
+DispatchGroup::LaneState& DispatchGroup::state(Lane lane)
+{
+    return lanes_[static_cast<size_t>(lane)];
+}
@@ -5,134 +5,366 @@
 
 #include "c++ami/reaction/Event.hpp"
 #include "c++ami/reaction/EventList.hpp"
+#include <algorithm>
 #include <cassert>
+#include <fmt/core.h>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
 
 using namespace cpp_ami;
 
-EventDispatcher::EventDispatcher(event_callback_t callback)
-    : dispatch_(std::move(callback))
+namespace {
+
+/// @brief Scans a raw AMI message for the value of its ActionID key without parsing the whole message.
+///
+/// @return Action ID carried by \c event_buf; empty if the message doesn't carry one.
+///
+/// @param event_buf String containing an AMI string event.
+std::string_view find_action_id(std::string_view event_buf)
 {
+    static constexpr std::string_view key("ActionID: ");
+
+    for (size_t line_beg = 0; line_beg < event_buf.length(); ) {
+        auto line_end = event_buf.find('\n', line_beg);
+        if (line_end == std::string_view::npos) {
+            line_end = event_buf.length();
+        }
+
+        if (event_buf.compare(line_beg, key.length(), key) == 0) {
+            auto const val_beg = line_beg + key.length();
+            auto val_end = line_end;
+            if (val_end > val_beg && event_buf[val_end - 1] == '\r') {
+                --val_end;
+            }
+            return event_buf.substr(val_beg, val_end - val_beg);
+        }
+
+        line_beg = line_end + 1;
+    }
+
+    return {};
+}
+
+}
+
+EventDispatcher::EventDispatcher(event_callback_t callback, retired_callback_t retired,
+    std::shared_ptr<DispatchGroup> group)
+    : group_(std::move(group))
+    , dispatch_(std::move(callback))
+{
+    if (retired) {
+        retired_ = std::move(retired);
+    }
+
     events_.reserve(100);
+    responses_.reserve(100);
+    event_bufs_.reserve(events_.capacity());
+    batch_.reserve(events_.capacity());
+    response_bufs_.reserve(responses_.capacity());
 
-    start_work_thread();
+    if (group_) {
+        group_->add(this);
+    }
+    else {
+        start_work_thread();
+    }
 }
 
 EventDispatcher::~EventDispatcher()
 {
-    stop_work_thread();
+    if (group_) {
+        // Once removed the group's threads no longer touch this object; drain the lanes the same way the threads do
+        group_->remove(this);
+        finish_responses();
+        finish_events();
+    }
+    else {
+        stop_work_thread();
+    }
 
     cleanup_object();
 }
 
 void EventDispatcher::cleanup_object()
 {
-    std::scoped_lock const lock(promise_map_mutex_, event_map_mutex_);
+    std::vector<std::pair<std::string, Pending>> retired;
+    {
+        std::scoped_lock const lock(pending_map_mutex_, event_map_mutex_);
+
+        assert(pending_map_.empty());
+        while (!pending_map_.empty()) {
+            auto action_id = pending_map_.begin()->first;
+            auto pending = retire(action_id);
+            retired.emplace_back(std::move(action_id), std::move(*pending));
+        }
+
+        assert(event_map_.empty());
+    }
 
     // Not sure what to do here; sending nullptr's out on pipes to avoid std::broken_promise exception
     // on terminate
-    assert(promise_map_.empty());
-    for (auto &[_, pipe] : promise_map_) {
-        pipe.set_value(nullptr);
+    for (auto &[action_id, pending] : retired) {
+        complete(action_id, pending, nullptr, nullptr);
     }
-
-    assert(event_map_.empty());
 }
 
 void EventDispatcher::start_work_thread()
 {
     thread_run_ = true;
     thread_ = std::thread(&EventDispatcher::work_thread, this);
+    responder_ = std::thread(&EventDispatcher::response_thread, this);
 
     std::string_view thread_name("ami_dispatcher");
     assert(thread_name.length() <= 16);
     pthread_setname_np(thread_.native_handle(), thread_name.data());
+
+    std::string_view responder_name("ami_responder");
+    assert(responder_name.length() <= 16);
+    pthread_setname_np(responder_.native_handle(), responder_name.data());
 }
 
 void EventDispatcher::stop_work_thread()
 {
     thread_run_ = false;
-    thread_cv_.notify_one();
 
+    // Stop the response lane first; whatever it drains on the way out that turns out to be a notification is handed to
+    // the work thread, which drains it in turn
+    {
+        std::unique_lock const lock(responses_mutex_);
+        responder_cv_.notify_one();
+    }
+    assert(responder_.joinable());
+    responder_.join();
+
+    {
+        std::unique_lock const lock(events_mutex_);
+        thread_cv_.notify_one();
+    }
     assert(thread_.joinable());
     thread_.join();
 }
 
 void EventDispatcher::work_thread()
 {
-    decltype(events_) events;
-    events.reserve(events_.capacity());
-
     while (thread_run_) {
-        std::unique_lock lock(events_mutex_);
-        thread_cv_.wait(lock, [this]() -> bool { return !thread_run_ || !events_.empty(); });;
-        std::swap(events_, events);
-        lock.unlock();
+        {
+            std::unique_lock lock(events_mutex_);
+            auto const has_events = [this]() -> bool { return !thread_run_ || !events_.empty() || !strays_.empty(); };
+            // Wake up in time to release events held back by the conflater
+            if (auto const deadline = conflater_.next_deadline()) {
+                thread_cv_.wait_until(lock, deadline.value(), has_events);
+            }
+            else {
+                thread_cv_.wait(lock, has_events);
+            }
+        }
+
+        service_events();
+    }
 
-        for (auto event_buf : events) {
-            dispatch_event(std::move(event_buf));
+    finish_events();
+}
+
+void EventDispatcher::response_thread()
+{
+    while (thread_run_) {
+        {
+            std::unique_lock lock(responses_mutex_);
+            // Only wake up periodically while there are deadlines to service
+            if (timers_armed_) {
+                responder_cv_.wait_for(lock, timers_.resolution(),
+                    [this]() -> bool { return !thread_run_ || !responses_.empty(); });
+            }
+            else {
+                responder_cv_.wait(lock,
+                    [this]() -> bool { return !thread_run_ || !responses_.empty() || timers_armed_; });
+            }
         }
-        events.clear();
+
+        service_responses();
+    }
+
+    finish_responses();
+}
+
+void EventDispatcher::service_events()
+{
+    {
+        std::unique_lock const lock(events_mutex_);
+        std::swap(events_, event_bufs_);
+        std::move(strays_.begin(), strays_.end(), std::back_inserter(batch_));
+        strays_.clear();
     }
 
-    // Finish building events
+    dispatch_events(event_bufs_, batch_);
+}
+
+void EventDispatcher::finish_events()
+{
+    // Finish building events; nothing is held back past shutdown
     std::unique_lock const lock(events_mutex_);
-    for (auto event_buf : events_) {
-        dispatch_event(std::move(event_buf));
+    std::move(strays_.begin(), strays_.end(), std::back_inserter(batch_));
+    strays_.clear();
+    dispatch_events(events_, batch_);
+    conflater_.flush(batch_);
+    if (!batch_.empty()) {
+        dispatch_(batch_);
+        batch_.clear();
     }
-    events_.clear();
 }
 
-void EventDispatcher::dispatch_event(std::string event_buf)
+void EventDispatcher::service_responses()
 {
-    util::KeyValDict dict(std::move(event_buf));
-    if (auto const action_id = dict.get_value("ActionID"); !action_id || !dispatch_event(action_id.value(), dict)) {
-        // Event is either missing the action ID or isn't in response to an AMI action; dispatch a regular
-        // event
-        dispatch_(std::make_unique<event::Event const>(std::move(dict)));
+    {
+        std::unique_lock const lock(responses_mutex_);
+        std::swap(responses_, response_bufs_);
     }
+
+    dispatch_responses(response_bufs_, response_strays_);
+
+    expire_timers();
 }
 
-bool EventDispatcher::dispatch_event(std::string const &action_id, util::KeyValDict &dict)
+void EventDispatcher::finish_responses()
 {
-    std::scoped_lock const lock (promise_map_mutex_, event_map_mutex_);
+    // Finish building responses
+    std::unique_lock const lock(responses_mutex_);
+    dispatch_responses(responses_, response_strays_);
+}
 
-    // Grab pipe for variable return
-    auto const p_it = promise_map_.find(action_id);
-    // Nothing is waiting for the Event; let normal dispatch handler handle this
-    if (p_it == promise_map_.end()) {
-        return false;
+void EventDispatcher::notify_events()
+{
+    if (group_) {
+        group_->wake(this, DispatchGroup::Lane::events);
+    }
+    else {
+        thread_cv_.notify_one();
+    }
+}
+
+void EventDispatcher::notify_responses()
+{
+    if (group_) {
+        group_->wake(this, DispatchGroup::Lane::responses);
+    }
+    else {
+        responder_cv_.notify_one();
+    }
+}
+
+void EventDispatcher::dispatch_events(std::vector<std::string> &event_bufs, std::vector<event_ptr_t> &batch)
+{
+    for (auto &event_buf : event_bufs) {
+        if (auto event = dispatch_event(std::move(event_buf))) {
+            batch.push_back(std::move(event));
+        }
     }
-    auto &pipe = p_it->second;
+    event_bufs.clear();
 
-    // Grab iterator for EventList associated with action_id
-    auto const e_it = event_map_.find(action_id);
+    conflater_.process(batch, event::EventConflater::clock_t::now());
 
-    // Event is (currently?) not part of an EventList
-    if (e_it == event_map_.end()) {
-        // Event does not start an EventList; immediately return Event and clear pipe
-        if (!dict.has_key("EventList")) {
-            pipe.set_value(std::make_unique<reaction::Event const>(std::move(dict)));
-            promise_map_.erase(p_it);
+    if (!batch.empty()) {
+        dispatch_(batch);
+        batch.clear();
+    }
+}
+
+void EventDispatcher::dispatch_responses(std::vector<std::string> &event_bufs, std::vector<event_ptr_t> &strays)
+{
+    for (auto &event_buf : event_bufs) {
+        if (auto event = dispatch_event(std::move(event_buf))) {
+            strays.push_back(std::move(event));
+        }
+    }
+    event_bufs.clear();
+
+    // The request was retired between framing and dispatch (timed out or closed); the message is dispatched as a
+    // regular notification event by the work thread so that notification callbacks only ever run on one thread
+    if (!strays.empty()) {
+        std::unique_lock const lock(events_mutex_);
+        std::move(strays.begin(), strays.end(), std::back_inserter(strays_));
+        notify_events();
+        strays.clear();
+    }
+}
+
+EventDispatcher::event_ptr_t EventDispatcher::dispatch_event(std::string event_buf)
+{
+    // Parse the message into a recycled event; if the message turns out to be a response its contents are moved into
+    // the reaction and the emptied event goes back to the pool
+    auto event = event_pool_.acquire(std::move(event_buf));
+    if (auto const action_id = event->get_value("ActionID"); action_id && dispatch_event(action_id.value(), *event)) {
+        return nullptr;
+    }
+
+    // Event is either missing the action ID or isn't in response to an AMI action; dispatch a regular event
+    return event;
+}
+
+bool EventDispatcher::dispatch_event(std::string const &action_id, util::KeyValDict &dict)
+{
+    std::optional<Pending> retired;
+    reaction_ptr_t reaction;
+    std::shared_ptr<list_item_handler_t const> item_handler;
+    {
+        std::scoped_lock const lock (pending_map_mutex_, event_map_mutex_);
+
+        // Nothing is waiting for the Event; let normal dispatch handler handle this
+        auto const p_it = pending_map_.find(action_id);
+        if (p_it == pending_map_.end()) {
+            return false;
         }
-        // Event creates EventList; create new EventList and check AMI status
-        else if (auto event_list = std::make_unique<reaction::EventList>(std::move(dict)); event_list->is_success()) {
-            event_map_.emplace(action_id, std::move(event_list));
+
+        // Grab iterator for EventList associated with action_id
+        auto const e_it = event_map_.find(action_id);
+
+        // Request is completed by a later event (e.g. OriginateResponse); the response merely acknowledges it unless
+        // the action was rejected
+        if (auto const &completion_event = p_it->second.completion_event; !completion_event.empty()) {
+            if (dict.get_value("Event") == completion_event || dict.get_value("Response") == "Error") {
+                reaction = std::make_unique<reaction::Event const>(std::move(dict));
+            }
         }
-        // EventList creation failed; immediately return EventList and clear pipe
-        else {
-            pipe.set_value(std::move(event_list));
-            promise_map_.erase(p_it);
+        // Event is (currently?) not part of an EventList
+        else if (e_it == event_map_.end()) {
+            // Event does not start an EventList; immediately return Event
+            if (!dict.has_key("EventList")) {
+                reaction = std::make_unique<reaction::Event const>(std::move(dict));
+            }
+            // Event creates EventList; create new EventList and check AMI status
+            else if (auto event_list = std::make_unique<reaction::EventList>(std::move(dict)); event_list->is_success()) {
+                event_map_.emplace(action_id, std::move(event_list));
+            }
+            // EventList creation failed; immediately return EventList
+            else {
+                reaction = std::move(event_list);
+            }
+        }
+        // Event is an item of a streamed EventList; hand it off to the item handler rather than buffering it
+        else if (p_it->second.items && !reaction::EventList::is_list_complete(dict)) {
+            item_handler = p_it->second.items;
         }
-        return true;
+        // Event is part of an EventList; grab working EventList and append Event
+        else if (auto &event_list = e_it->second; event_list->add_event(std::move(dict))) {
+            // EventList is complete; return EventList
+            reaction = std::move(event_list);
+        }
+
+        // Reaction is complete; clear pipe and cached EventList
+        if (reaction) {
+            retired = retire(action_id);
+        }
+    }
+
+    // Stream the item outside of the locks; the handler is kept alive even if the request is retired meanwhile
+    if (item_handler) {
+        (*item_handler)(event::Event(std::move(dict)));
     }
 
-    // Event is part of an EventList; grab working EventList and append Event
-    if (auto &event_list = e_it->second; event_list->add_event(std::move(dict))) {
-        // EventList is complete; return EventList
-        pipe.set_value(std::move(event_list));
-        // Clear pipe and cached EventList
-        promise_map_.erase(p_it);
-        event_map_.erase(e_it);
+    // Complete the request outside of the locks; completion handlers are free to invoke new actions
+    if (retired) {
+        complete(action_id, *retired, std::move(reaction), nullptr);
     }
 
     return true;
@@ -140,48 +372,227 @@ bool EventDispatcher::dispatch_event(std::string const &action_id, util::KeyValD
 
 void EventDispatcher::add_event(std::string event)
 {
-    std::unique_lock const lock(events_mutex_);
-    events_.push_back(std::move(event));
-    thread_cv_.notify_one();
+    // Classify the message as it is framed: anything answering an outstanding request skips the notification queue so
+    // that responses never wait behind a burst of notification events
+    auto is_response = false;
+    if (auto const action_id = find_action_id(event); !action_id.empty()) {
+        std::unique_lock const lock(pending_map_mutex_);
+        is_response = pending_map_.contains(std::string(action_id));
+    }
+
+    if (is_response) {
+        std::unique_lock const lock(responses_mutex_);
+        responses_.push_back(std::move(event));
+        notify_responses();
+    }
+    else {
+        std::unique_lock const lock(events_mutex_);
+        events_.push_back(std::move(event));
+        notify_events();
+    }
 }
 
-std::future<EventDispatcher::reaction_ptr_t> EventDispatcher::get_event_pipe(std::string const &action_id)
+std::future<EventDispatcher::reaction_ptr_t> EventDispatcher::get_event_pipe(std::string const &action_id,
+    timeout_t timeout, std::string completion_event)
 {
     // Create new promise/future pair for event return
     pipe_t promise;
     auto future = promise.get_future();
 
     // Add promise for return event
-    std::unique_lock const lock(promise_map_mutex_);
-    promise_map_.emplace(action_id, std::move(promise));
+    Pending pending{
+        .sink = std::move(promise),
+        .timer = std::nullopt,
+        .items = nullptr,
+        .completion_event = std::move(completion_event) };
+    if (!add_pending(action_id, pending, timeout)) {
+        throw std::runtime_error(fmt::format("Duplicate ActionID {}", action_id));
+    }
 
     return future;
 }
 
+bool EventDispatcher::add_completion_handler(std::string const &action_id, completion_handler_t handler,
+    timeout_t timeout, std::string completion_event)
+{
+    assert(handler);
+    Pending pending{
+        .sink = std::move(handler),
+        .timer = std::nullopt,
+        .items = nullptr,
+        .completion_event = std::move(completion_event) };
+    return add_pending(action_id, pending, timeout) || reject(action_id, pending);
+}
+
+bool EventDispatcher::add_streaming_handler(std::string const &action_id, list_item_handler_t item_handler,
+    completion_handler_t handler, timeout_t timeout)
+{
+    assert(item_handler && handler);
+    Pending pending{
+        .sink = std::move(handler),
+        .timer = std::nullopt,
+        .items = std::make_shared<list_item_handler_t const>(std::move(item_handler)),
+        .completion_event = {} };
+    return add_pending(action_id, pending, timeout) || reject(action_id, pending);
+}
+
 void EventDispatcher::set_exception_on_pipe(std::string const &action_id, std::exception_ptr const &err)
 {
-    std::scoped_lock const lock(promise_map_mutex_, event_map_mutex_);
+    std::optional<Pending> retired;
+    {
+        std::scoped_lock const lock(pending_map_mutex_, event_map_mutex_);
+        retired = retire(action_id);
+    }
 
     // Invoke set_exception on the promise end of the pipe so that this end of the pipe can be closed
-    if (auto const it = promise_map_.find(action_id); it != promise_map_.end()) {
-        it->second.set_exception(err);
-        promise_map_.erase(it);
+    if (retired) {
+        complete(action_id, *retired, nullptr, err);
     }
-
-    // Clear the working reaction
-    event_map_.erase(action_id);
 }
 
 void EventDispatcher::set_null_on_pipe(std::string const &action_id)
 {
-    std::scoped_lock const lock(promise_map_mutex_, event_map_mutex_);
+    std::optional<Pending> retired;
+    {
+        std::scoped_lock const lock(pending_map_mutex_, event_map_mutex_);
+        retired = retire(action_id);
+    }
 
     // Invoke set_value on the promise end of the pipe so that this end of the pipe can be closed
-    if (auto const it = promise_map_.find(action_id); it != promise_map_.end()) {
-        it->second.set_value(nullptr);
-        promise_map_.erase(it);
+    if (retired) {
+        complete(action_id, *retired, nullptr, nullptr);
+    }
+}
+
+void EventDispatcher::withdraw_pipe(std::string const &action_id)
+{
+    std::optional<Pending> retired;
+    {
+        std::scoped_lock const lock(pending_map_mutex_, event_map_mutex_);
+        retired = retire(action_id);
+    }
+
+    if (retired) {
+        std::get<pipe_t>(retired->sink).set_value(nullptr);
+    }
+}
+
+void EventDispatcher::set_conflation(std::unordered_set<std::string> event_types, timeout_t window)
+{
+    conflater_.configure(std::move(event_types), window);
+
+    // Let the work thread pick up the new configuration (or release held back events) right away
+    std::unique_lock const lock(events_mutex_);
+    notify_events();
+}
+
+event::EventConflater::Metrics EventDispatcher::get_conflation_metrics() const
+{
+    return conflater_.get_metrics();
+}
+
+bool EventDispatcher::add_pending(std::string const &action_id, Pending &pending, timeout_t timeout)
+{
+    std::unique_lock lock(pending_map_mutex_);
+
+    // The response to a second request under the same ID would be handed to whichever came first
+    if (pending_map_.contains(action_id)) {
+        return false;
+    }
+
+    auto wake_thread = false;
+    if (timeout > timeout_t::zero()) {
+        pending.timer = timers_.arm(action_id, util::TimerWheel::clock_t::now() + timeout);
+        wake_thread = !timers_armed_.exchange(true);
+    }
+    pending_map_.emplace(action_id, std::move(pending));
+    lock.unlock();
+
+    // First deadline armed; wake the response thread so that it starts servicing the timer wheel
+    if (wake_thread) {
+        std::unique_lock const responses_lock(responses_mutex_);
+        notify_responses();
+    }
+    return true;
+}
+
+bool EventDispatcher::reject(std::string const &action_id, Pending &pending)
+{
+    // Never outstanding, so the owner isn't told that it retired
+    std::get<completion_handler_t>(pending.sink)(nullptr,
+        std::make_exception_ptr(std::runtime_error(fmt::format("Duplicate ActionID {}", action_id))));
+    return false;
+}
+
+std::optional<EventDispatcher::Pending> EventDispatcher::retire(std::string const &action_id)
+{
+    std::optional<Pending> retired;
+    if (auto const it = pending_map_.find(action_id); it != pending_map_.end()) {
+        disarm(it->second);
+        retired = std::move(it->second);
+        pending_map_.erase(it);
     }
 
     // Clear the working reaction
     event_map_.erase(action_id);
+
+    return retired;
+}
+
+void EventDispatcher::complete(std::string const &action_id, Pending &pending, reaction_ptr_t reaction,
+    std::exception_ptr const &err)
+{
+    // Let the owner know that the request is no longer outstanding before delivering the result
+    retired_(action_id);
+
+    if (auto *const pipe = std::get_if<pipe_t>(&pending.sink)) {
+        if (err) {
+            pipe->set_exception(err);
+        }
+        else {
+            pipe->set_value(std::move(reaction));
+        }
+    }
+    else {
+        std::get<completion_handler_t>(pending.sink)(std::move(reaction), err);
+    }
+}
+
+void EventDispatcher::disarm(Pending &pending)
+{
+    if (pending.timer) {
+        timers_.cancel(*pending.timer);
+        pending.timer.reset();
+    }
+}
+
+void EventDispatcher::expire_timers()
+{
+    if (!timers_armed_) {
+        return;
+    }
+
+    std::vector<std::pair<std::string, Pending>> expired;
+    {
+        std::scoped_lock const lock(pending_map_mutex_, event_map_mutex_);
+
+        for (auto &action_id : timers_.advance(util::TimerWheel::clock_t::now())) {
+            // The timer has already been removed from the wheel; drop the handle rather than disarming it
+            if (auto const it = pending_map_.find(action_id); it != pending_map_.end()) {
+                it->second.timer.reset();
+            }
+
+            // Retiring the request also frees the partially built EventList
+            if (auto retired = retire(action_id)) {
+                expired.emplace_back(std::move(action_id), std::move(*retired));
+            }
+        }
+
+        timers_armed_ = !timers_.empty();
+    }
+
+    for (auto &[action_id, pending] : expired) {
+        std::runtime_error const err(fmt::format("Event timeout: Timeout waiting for event; ActionID={}", action_id));
+        complete(action_id, pending, nullptr, std::make_exception_ptr(err));
+    }
 }
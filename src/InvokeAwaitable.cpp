@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/InvokeAwaitable.hpp"
+
+#include "c++ami/Connection.hpp"
+#include <utility>
+
+using namespace cpp_ami;
+
+InvokeAwaitable::InvokeAwaitable(Connection const &connection, action::Action action, executor_t executor,
+    std::chrono::milliseconds timeout, std::stop_token stop_token)
+    : connection_(connection)
+    , action_(std::move(action))
+    , executor_(std::move(executor))
+    , timeout_(timeout)
+    , stop_token_(std::move(stop_token))
+{
+}
+
+bool InvokeAwaitable::await_ready() const noexcept
+{
+    return stop_token_.stop_requested();
+}
+
+bool InvokeAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    handle_ = handle;
+
+    connection_.async_invoke(action_,
+        [this](reaction_ptr_t reaction, std::exception_ptr err) -> void {
+            complete(std::move(reaction), std::move(err));
+        },
+        timeout_);
+
+    // Register for cancellation once the request exists in the dispatcher. If stop was requested in the meantime the
+    // callback runs right away and completes the request on this thread.
+    if (stop_token_.stop_possible()) {
+        stop_callback_.emplace(stop_token_, [this]() -> void { connection_.cancel(action_); });
+    }
+
+    // If the reaction arrived while the action was being sent then don't suspend; complete() left resuming to us
+    return !ready_.exchange(true);
+}
+
+InvokeAwaitable::reaction_ptr_t InvokeAwaitable::await_resume()
+{
+    stop_callback_.reset();
+
+    if (err_) {
+        std::rethrow_exception(err_);
+    }
+    return std::move(reaction_);
+}
+
+void InvokeAwaitable::complete(reaction_ptr_t reaction, std::exception_ptr err)
+{
+    reaction_ = std::move(reaction);
+    err_ = std::move(err);
+
+    // await_suspend hasn't finished yet; it will see the flag and continue the coroutine without suspending
+    if (!ready_.exchange(true)) {
+        return;
+    }
+
+    // Resuming may destroy this object; don't touch any members afterwards
+    auto const handle = handle_;
+    if (auto executor = std::move(executor_)) {
+        executor([handle]() -> void { handle.resume(); });
+    }
+    else {
+        handle.resume();
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/OriginateEngine.hpp"
+
+#include "c++ami/Connection.hpp"
+#include <pthread.h>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami;
+
+OriginateEngine::OriginateEngine(Connection &connection, Options const &options)
+    : connection_(&connection)
+    , options_(options)
+    , bucket_(options.calls_per_second, options.burst)
+{
+    thread_ = std::thread(&OriginateEngine::work_thread, this);
+    pthread_setname_np(thread_.native_handle(), "ami_originate");
+}
+
+OriginateEngine::~OriginateEngine()
+{
+    std::vector<action::Originate> in_flight;
+    {
+        std::unique_lock const lock(mutex_);
+        run_ = false;
+    }
+    schedule_cv_.notify_one();
+    thread_.join();
+
+    {
+        std::unique_lock const lock(mutex_);
+        queue_.clear();
+        for (auto const &[_, inflight] : in_flight_) {
+            in_flight.push_back(inflight.action);
+        }
+    }
+
+    // Completion handlers refer to this object; close the outstanding requests and wait for their handlers to finish
+    for (auto const &action : in_flight) {
+        connection_->cancel(action);
+    }
+    std::unique_lock lock(mutex_);
+    completed_cv_.wait(lock, [this]() -> bool { return in_flight_.empty(); });
+}
+
+std::string OriginateEngine::submit(action::Originate originate)
+{
+    auto action_id = originate.get_action_id();
+    {
+        std::unique_lock const lock(mutex_);
+        queue_.push_back(std::move(originate));
+    }
+    schedule_cv_.notify_one();
+    return action_id;
+}
+
+std::optional<OriginateEngine::Result> OriginateEngine::next(std::chrono::milliseconds const &timeout)
+{
+    std::unique_lock lock(mutex_);
+    if (!completed_cv_.wait_for(lock, timeout, [this]() -> bool { return !completed_.empty(); })) {
+        return std::nullopt;
+    }
+
+    auto result = std::move(completed_.front());
+    completed_.pop_front();
+    return result;
+}
+
+void OriginateEngine::wait_idle()
+{
+    std::unique_lock lock(mutex_);
+    completed_cv_.wait(lock, [this]() -> bool { return queue_.empty() && in_flight_.empty(); });
+}
+
+void OriginateEngine::set_options(Options const &options)
+{
+    {
+        std::unique_lock const lock(mutex_);
+        bucket_.set_rate(options.calls_per_second, options.burst);
+        options_ = options;
+    }
+    schedule_cv_.notify_one();
+}
+
+OriginateEngine::Metrics OriginateEngine::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+    auto metrics = metrics_;
+    metrics.queued = queue_.size();
+    metrics.in_flight = in_flight_.size();
+    metrics.completed = completed_.size();
+    return metrics;
+}
+
+void OriginateEngine::work_thread()
+{
+    std::unique_lock lock(mutex_);
+    while (run_) {
+        auto const has_room = [this]() -> bool {
+            return options_.max_concurrent == 0 || in_flight_.size() < options_.max_concurrent;
+        };
+        if (queue_.empty() || !has_room()) {
+            schedule_cv_.wait(lock);
+            continue;
+        }
+
+        // Sleep until the bucket refills rather than polling it; a change of rate wakes the thread early
+        auto const now = clock_t::now();
+        if (!bucket_.try_acquire(now)) {
+            schedule_cv_.wait_until(lock, now + bucket_.wait_time(now));
+            continue;
+        }
+
+        auto action = std::move(queue_.front());
+        queue_.pop_front();
+        auto const action_id = action.get_action_id();
+        auto const timeout = options_.timeout;
+        in_flight_.emplace(action_id, Inflight{ .action = action, .sent = now });
+        ++metrics_.sent;
+        lock.unlock();
+
+        // The handler runs on the dispatcher's response thread (or right away if the action can't be sent), so it
+        // mustn't be invoked with the lock held
+        connection_->async_invoke(action,
+            [this, action_id](reaction_ptr_t reaction, std::exception_ptr err) -> void {
+                complete(action_id, std::move(reaction), err);
+            },
+            timeout);
+
+        lock.lock();
+    }
+}
+
+void OriginateEngine::complete(std::string const &action_id, reaction_ptr_t reaction, std::exception_ptr const &err)
+{
+    std::unique_lock const lock(mutex_);
+    auto const it = in_flight_.find(action_id);
+    if (it == in_flight_.end()) {
+        return;
+    }
+
+    auto const success = !err && reaction && reaction->is_success();
+    if (success) {
+        ++metrics_.succeeded;
+    }
+    else {
+        ++metrics_.failed;
+    }
+    completed_.push_back(Result{
+        .action_id = action_id,
+        .success = success,
+        .reaction = std::move(reaction),
+        .error = err,
+        .latency = clock_t::now() - it->second.sent });
+    in_flight_.erase(it);
+
+    // Notified with the lock held; the destructor may be waiting for this handler to release the object
+    schedule_cv_.notify_one();
+    completed_cv_.notify_all();
+}
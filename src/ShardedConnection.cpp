@@ -0,0 +1,300 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/ShardedConnection.hpp"
+
+#include "c++ami/action/Login.hpp"
+#include "c++ami/net/SocketPoller.hpp"
+#include "c++ami/util/ScopeGuard.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+
+using namespace cpp_ami;
+
+ShardedConnection::ShardedConnection(std::string_view hostname, uint16_t port, std::string const &username,
+    std::string const &secret, size_t sessions, std::chrono::milliseconds const &timeout)
+    : poller_(std::make_shared<net::SocketPoller>())
+    , group_(std::make_shared<DispatchGroup>())
+{
+    if (sessions == 0) {
+        throw std::out_of_range("Invalid number of sessions");
+    }
+
+    shards_.reserve(sessions);
+    for (size_t i = 0; i < sessions; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->connection = std::make_unique<Connection>(hostname, port, poller_, group_);
+
+        // The AMI server sends every event to every session that has them enabled; only the first one listens
+        action::Login login(username, secret);
+        login.set_value("Events", i == 0 ? "on" : "off");
+        auto const reaction = shard->connection->invoke(login, timeout);
+        if (!reaction || !reaction->is_success()) {
+            throw std::runtime_error(fmt::format("ShardedConnection: login of session {} failed; {}", i,
+                reaction ? reaction->to_string() : "request closed"));
+        }
+        shards_.push_back(std::move(shard));
+    }
+}
+
+ShardedConnection::~ShardedConnection()
+{
+    // Copies of hedged actions that lost their race are still waiting on their sessions; close them while the
+    // histograms they record into are around
+    std::vector<action::Action> hedges;
+    {
+        std::unique_lock const lock(hedges_mutex_);
+        for (auto const &[_, action] : hedges_) {
+            hedges.push_back(action);
+        }
+    }
+    for (auto const &action : hedges) {
+        cancel(action);
+    }
+
+    // Sessions must be gone before the poller and dispatch group they share
+    shards_.clear();
+}
+
+size_t ShardedConnection::size() const
+{
+    return shards_.size();
+}
+
+Connection& ShardedConnection::get_session(size_t index) const
+{
+    return *shards_.at(index)->connection;
+}
+
+std::vector<size_t> ShardedConnection::get_outstanding() const
+{
+    std::vector<size_t> outstanding;
+    outstanding.reserve(shards_.size());
+    for (auto const &shard : shards_) {
+        outstanding.push_back(shard->outstanding);
+    }
+    return outstanding;
+}
+
+void ShardedConnection::async_invoke(action::Action const &action) const
+{
+    // Nothing waits on the response; it reaches the event callbacks, which are all on the first session
+    shards_.front()->connection->async_invoke(action);
+}
+
+void ShardedConnection::async_invoke(action::Action const &action, completion_handler_t handler,
+    std::chrono::milliseconds const &timeout) const
+{
+    submit(acquire(), action, std::move(handler), timeout);
+}
+
+ShardedConnection::reaction_ptr_t ShardedConnection::invoke(action::Action const &action) const
+{
+    auto &shard = acquire();
+    util::ScopeGuard const release([&shard]() -> void { --shard.outstanding; });
+    return shard.connection->invoke(action);
+}
+
+ShardedConnection::reaction_ptr_t ShardedConnection::invoke(action::Action const &action,
+    std::chrono::milliseconds const &timeout) const
+{
+    auto &shard = acquire();
+    util::ScopeGuard const release([&shard]() -> void { --shard.outstanding; });
+    return shard.connection->invoke(action, timeout);
+}
+
+ShardedConnection::reaction_ptr_t ShardedConnection::invoke(action::Action const &action,
+    list_item_handler_t item_handler, std::chrono::milliseconds const &timeout) const
+{
+    auto &shard = acquire();
+    util::ScopeGuard const release([&shard]() -> void { --shard.outstanding; });
+    return shard.connection->invoke(action, std::move(item_handler), timeout);
+}
+
+ShardedConnection::reaction_ptr_t ShardedConnection::invoke_hedged(action::Action const &action,
+    std::chrono::milliseconds const &timeout) const
+{
+    ++invoked_;
+
+    auto &latencies = get_latencies(action.get_action());
+    std::chrono::microseconds delay;
+    {
+        std::unique_lock const lock(hedge_mutex_);
+        delay = hedge_policy_.initial_delay;
+        if (latencies.count() >= hedge_policy_.min_samples) {
+            delay = std::max<std::chrono::microseconds>(hedge_policy_.min_delay,
+                latencies.quantile(hedge_policy_.quantile));
+        }
+    }
+
+    auto const started = clock_t::now();
+    auto race = std::make_shared<Race>();
+    std::array<Shard *, 2> shards{};
+    auto const send = [this, &action, &race, &latencies, &shards](size_t copy, std::chrono::milliseconds timeout)
+        -> void {
+        // Each copy is timed from its own send and recorded whether it wins or not, late answers included; the
+        // histogram tracks how long a session takes to answer, not how long the winner took
+        auto const sent = clock_t::now();
+        submit(*shards[copy], action,
+            [this, race, &latencies, copy, sent, action_id = action.get_action_id()](reaction_ptr_t reaction,
+                std::exception_ptr err) -> void {
+                if (reaction && !err) {
+                    latencies.record(clock_t::now() - sent);
+                }
+
+                std::unique_lock lock(race->mutex);
+                auto const done = --race->running == 0;
+                if (!race->winner) {
+                    if (reaction && !err) {
+                        race->winner = copy;
+                        race->reaction = std::move(reaction);
+                    }
+                    else if (!race->error) {
+                        race->error = err;
+                    }
+                    race->cv.notify_all();
+                }
+                lock.unlock();
+
+                if (done) {
+                    std::unique_lock const hedges_lock(hedges_mutex_);
+                    hedges_.erase(action_id);
+                }
+            },
+            timeout);
+    };
+    auto const settled = [&race]() -> bool { return race->winner || race->running == 0; };
+
+    {
+        std::unique_lock const lock(hedges_mutex_);
+        hedges_.insert_or_assign(action.get_action_id(), action);
+    }
+    shards[0] = &acquire();
+    race->running = 1;
+    send(0, timeout);
+
+    std::unique_lock lock(race->mutex);
+    if (!race->cv.wait_for(lock, delay, settled) && shards_.size() > 1) {
+        // The second copy only gets whatever is left of the timeout, so the caller never waits longer than asked
+        auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            timeout - (clock_t::now() - started));
+        if (remaining > std::chrono::milliseconds::zero()) {
+            ++race->running;
+            lock.unlock();
+            ++hedged_;
+            shards[1] = &acquire(shards[0]);
+            send(1, remaining);
+            lock.lock();
+        }
+    }
+    race->cv.wait(lock, settled);
+
+    // The slower copy isn't cancelled: the AMI server works on it regardless, so its session stays counted as busy
+    // until it is answered or its timeout passes
+    auto const winner = race->winner;
+    auto reaction = std::move(race->reaction);
+    auto const error = race->error;
+    lock.unlock();
+
+    if (!winner) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return nullptr;
+    }
+    if (winner.value() == 1) {
+        ++hedge_wins_;
+    }
+    return reaction;
+}
+
+void ShardedConnection::set_hedge_policy(HedgePolicy const &policy)
+{
+    std::unique_lock const lock(hedge_mutex_);
+    hedge_policy_ = policy;
+    for (auto const &[_, latencies] : latencies_) {
+        latencies->set_half_life(policy.half_life);
+    }
+}
+
+ShardedConnection::HedgeMetrics ShardedConnection::get_hedge_metrics() const
+{
+    return HedgeMetrics{ .invoked = invoked_, .hedged = hedged_, .hedge_wins = hedge_wins_ };
+}
+
+void ShardedConnection::cancel(action::Action const &action) const
+{
+    // Cancelling an action that isn't outstanding on a session has no effect
+    for (auto const &shard : shards_) {
+        shard->connection->cancel(action);
+    }
+}
+
+ShardedConnection::event_callback_key_t ShardedConnection::add_callback(event_callback_t callback)
+{
+    return shards_.front()->connection->add_callback(std::move(callback));
+}
+
+ShardedConnection::event_callback_key_t ShardedConnection::add_batch_callback(event_batch_callback_t callback)
+{
+    return shards_.front()->connection->add_batch_callback(std::move(callback));
+}
+
+void ShardedConnection::remove_callback(event_callback_key_t const &id)
+{
+    shards_.front()->connection->remove_callback(id);
+}
+
+ShardedConnection::Shard& ShardedConnection::acquire(Shard const *exclude) const
+{
+    auto &shard = least_outstanding(exclude);
+    ++shard.outstanding;
+    return shard;
+}
+
+ShardedConnection::Shard& ShardedConnection::least_outstanding(Shard const *exclude) const
+{
+    assert(!shards_.empty());
+
+    // Start the search at a different session every time so that idle sessions are used in turn
+    auto const start = next_.fetch_add(1, std::memory_order_relaxed);
+    Shard *best = nullptr;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        auto *const shard = shards_[(start + i) % shards_.size()].get();
+        if (shard == exclude) {
+            continue;
+        }
+        if (!best || shard->outstanding < best->outstanding) {
+            best = shard;
+        }
+        if (best->outstanding == 0) {
+            break;
+        }
+    }
+    return best ? *best : *shards_.front();
+}
+
+void ShardedConnection::submit(Shard &shard, action::Action const &action, completion_handler_t handler,
+    std::chrono::milliseconds const &timeout) const
+{
+    shard.connection->async_invoke(action,
+        [&shard, handler = std::move(handler)](reaction_ptr_t reaction, std::exception_ptr err) -> void {
+            --shard.outstanding;
+            handler(std::move(reaction), std::move(err));
+        },
+        timeout);
+}
+
+cpp_ami::util::LatencyHistogram& ShardedConnection::get_latencies(std::string const &name) const
+{
+    std::unique_lock const lock(hedge_mutex_);
+    auto &latencies = latencies_[name];
+    if (!latencies) {
+        latencies = std::make_unique<util::LatencyHistogram>(hedge_policy_.half_life);
+    }
+    return *latencies;
+}
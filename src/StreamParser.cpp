@@ -4,26 +4,37 @@
 #include "c++ami/StreamParser.hpp"
 
 #include "c++ami/CppAmiDefs.h"
+#include <algorithm>
 #include <cassert>
+#include <string_view>
 
 using namespace cpp_ami;
 
-StreamParser::StreamParser(version_callback_t version_callback, callback_t callback)
+StreamParser::StreamParser(version_callback_t version_callback, callback_t callback, bool threaded)
     : dispatch_(std::move(callback))
     , set_ami_version_(std::move(version_callback))
 {
-    stream_chunks_.reserve(100);
+    if (threaded) {
+        stream_chunks_.reserve(100);
 
-    start_work_thread();
+        start_work_thread();
+    }
 }
 
 StreamParser::~StreamParser()
 {
-    stop_work_thread();
+    if (thread_.joinable()) {
+        stop_work_thread();
+    }
 }
 
 void StreamParser::add_buf(std::string buf)
 {
+    if (!thread_.joinable()) {
+        process_chunk(std::move(buf));
+        return;
+    }
+
     std::unique_lock const lock(stream_chunks_mutex_);
     stream_chunks_.push_back(std::move(buf));
     thread_cv_.notify_one();
@@ -90,45 +101,224 @@ void StreamParser::process_chunk(std::string stream_chunk)
         stream_chunk.erase(0, eor_loc);
     }
 
-    // Start parsing events
-    auto eom_loc{std::string::npos};
+    // Rather than always scanning from the beginning of event_buf start scanning from the chunk boundary minus an EOM
+    // back off amount, this will capture end-of-message sequences that straddle the chunk boundary. If the EOM
+    // sequence length is greater than the current event_buf length then just start scanning from the beginning of
+    // event_buf.
+    auto scan_pos = event_buf_.length() < EOM.length()
+        ? 0                                         // Beginning of event_buf
+        : event_buf_.length() - EOM.length() + 1;  // EOM length - 1 byte before the chunk boundary
+
     if (event_buf_.empty()) {
-        // Happy path; entire event_buf has been cleared of messages. Just take the contents of stream_chunk and try
-        // processing that for an event.
+        // Happy path; entire event_buf has been cleared of messages. Just take the contents of stream_chunk.
         event_buf_ = std::move(stream_chunk);
-        eom_loc = event_buf_.find(EOM, 0);
     }
     else {
-        // Not so happy path; event_buf has a partial event in it. Append stream_chunk to event_buf and try parsing.
-
-        // Rather than always scanning from the beginning of event_buf start scanning from the chunk boundary minus an
-        // EOM back off amount, this will capture end-of-message sequences that straddle the chunk boundary. If the EOM
-        // sequence length is greater than the current event_buf length then just start scanning from the beginning of
-        // event_buf.
-        auto const scan_pos_start = event_buf_.length() < EOM.length()
-            ? 0                                         // Beginning of event_buf
-            : event_buf_.length() - EOM.length() + 1;  // EOM length - 1 byte before the chunk boundary
-
+        // Not so happy path; event_buf has a partial event in it. Append stream_chunk to event_buf.
         event_buf_ += stream_chunk;
-        eom_loc = event_buf_.find(EOM, scan_pos_start);
     }
 
-    while (eom_loc != std::string::npos) {
-        // Found EOM sequence; increment eom_loc to include EOM sequence
-        eom_loc += EOM.length();
+    // Messages are dispatched from msg_beg onwards; the dispatched part of event_buf is dropped once at the end
+    size_t msg_beg = 0;
+    while (msg_beg < event_buf_.length()) {
+        if (command_) {
+            if (!stream_command(msg_beg)) {
+                break;
+            }
+            continue;
+        }
+
+        auto const eom_loc = event_buf_.find(EOM, std::max(scan_pos, msg_beg));
 
-        if (eom_loc == event_buf_.length()) {
+        // Command output can be far larger than a regular message; stream it rather than waiting for its end
+        if (start_command(msg_beg, eom_loc)) {
+            continue;
+        }
+        if (eom_loc == std::string::npos) {
+            break;
+        }
+
+        // Found EOM sequence; the message includes the EOM sequence
+        auto const msg_end = eom_loc + EOM.length();
+        if (msg_beg == 0 && msg_end == event_buf_.length()) {
             // The entirety of event_buf is an event; dispatch event_buf
             dispatch_(std::move(event_buf_));
+            event_buf_.clear();
+            return;
+        }
+
+        // event_buf contains multiple events; dispatch the first one and search for the next
+        dispatch_(event_buf_.substr(msg_beg, msg_end - msg_beg));
+        msg_beg = msg_end;
+    }
+
+    // Hand the output read so far to the caller rather than holding on to it until the response ends
+    if (command_) {
+        flush_command_output();
+    }
+    event_buf_.erase(0, msg_beg);
+}
+
+bool StreamParser::start_command(size_t &msg_beg, size_t eom_loc)
+{
+    static constexpr std::string_view RESPONSE{ "Response: " };
+    static constexpr std::string_view FOLLOWS{ "Response: Follows\r\n" };
+    static constexpr std::string_view SUCCESS{ "Response: Success\r\n" };
+    static constexpr std::string_view OUTPUT{ "Output: " };
+    static constexpr std::string_view ACTION_ID{ "ActionID: " };
+
+    std::string_view const msg(event_buf_.data() + msg_beg,
+        (eom_loc == std::string::npos ? event_buf_.length() : eom_loc + EOR.length()) - msg_beg);
+    if (!msg.starts_with(RESPONSE)) {
+        return false;
+    }
+
+    // Older AMI servers send the raw output right after the header of a Follows response; current ones send Output
+    // lines after the header of a Success response
+    auto const legacy = msg.starts_with(FOLLOWS);
+    if (!legacy && !msg.starts_with(SUCCESS)) {
+        return false;
+    }
+
+    auto const is_header = [](std::string_view line) -> bool {
+        return line.starts_with(RESPONSE) || line.starts_with(ACTION_ID) || line.starts_with("Privilege: ")
+            || line.starts_with("Message: ");
+    };
+
+    std::string_view action_id;
+    size_t pos = 0;
+    while (true) {
+        // Raw output lines may end in a bare line feed
+        auto const lf = msg.find('\n', pos);
+        // Header hasn't been read completely; try again once more data arrives
+        if (lf == std::string_view::npos) {
+            return false;
+        }
+
+        auto line = msg.substr(pos, lf - pos);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        if (legacy ? !is_header(line) : line.starts_with(OUTPUT)) {
             break;
         }
+        // Regular response without any output
+        if (line.empty()) {
+            return false;
+        }
+        if (line.starts_with(ACTION_ID)) {
+            action_id = line.substr(ACTION_ID.length());
+        }
+        pos = lf + 1;
+    }
+
+    // The response header starts the list the output is streamed in
+    auto head = std::string(msg.substr(0, pos));
+    head += "EventList: start";
+    head += EOM;
+    dispatch_(std::move(head));
+
+    command_ = CommandOutput{ .action_id = std::string(action_id), .legacy = legacy, .batch = {}, .items = 0 };
+    msg_beg += pos;
+    return true;
+}
+
+bool StreamParser::stream_command(size_t &msg_beg)
+{
+    static constexpr std::string_view OUTPUT{ "Output: " };
+    static constexpr std::string_view END_COMMAND{ "--END COMMAND--" };
+
+    assert(command_);
+    while (true) {
+        if (command_->legacy) {
+            // Raw output lines end in a bare line feed; the output ends with the marker and an empty line
+            auto const lf = event_buf_.find('\n', msg_beg);
+            if (lf == std::string::npos) {
+                return false;
+            }
+
+            std::string_view line(event_buf_.data() + msg_beg, lf - msg_beg);
+            if (line.ends_with('\r')) {
+                line.remove_suffix(1);
+            }
+            if (line.ends_with(END_COMMAND)) {
+                if (event_buf_.length() < lf + 1 + EOR.length()) {
+                    return false;
+                }
+                if (event_buf_.compare(lf + 1, EOR.length(), EOR) == 0) {
+                    // The last line of output isn't necessarily terminated before the marker
+                    line.remove_suffix(END_COMMAND.length());
+                    if (!line.empty()) {
+                        add_command_output(line);
+                    }
+                    msg_beg = lf + 1 + EOR.length();
+                    break;
+                }
+            }
+            add_command_output(line);
+            msg_beg = lf + 1;
+        }
+        else {
+            auto const eor = event_buf_.find(EOR, msg_beg);
+            if (eor == std::string::npos) {
+                return false;
+            }
 
-        // event_buf contains multiple events; parse the first one and dispatch it
-        dispatch_(event_buf_.substr(0, eom_loc));
-        // Remove dispatched event from event_buf
-        event_buf_.erase(0, eom_loc);
+            // Empty line ends the response
+            if (eor == msg_beg) {
+                msg_beg += EOR.length();
+                break;
+            }
+
+            std::string_view line(event_buf_.data() + msg_beg, eor - msg_beg);
+            if (line.starts_with(OUTPUT)) {
+                add_command_output(line.substr(OUTPUT.length()));
+            }
+            msg_beg = eor + EOR.length();
+        }
+    }
+
+    // Close the list
+    flush_command_output();
+    std::string tail("Event: CommandComplete");
+    tail += EOR;
+    if (!command_->action_id.empty()) {
+        tail += "ActionID: " + command_->action_id + EOR;
+    }
+    tail += "EventList: Complete" + EOR;
+    tail += "ListItems: " + std::to_string(command_->items) + EOM;
+    command_.reset();
+    dispatch_(std::move(tail));
+    return true;
+}
+
+void StreamParser::add_command_output(std::string_view line)
+{
+    auto &batch = command_->batch;
+    batch += "Output: ";
+    batch += line;
+    batch += EOR;
+
+    // Keep the items of very long outputs in the size of a socket read
+    if (batch.length() >= MAX_BUF_SIZE) {
+        flush_command_output();
+    }
+}
+
+void StreamParser::flush_command_output()
+{
+    if (command_->batch.empty()) {
+        return;
+    }
 
-        // Search for next event in event_buf
-        eom_loc = event_buf_.find(EOM, 0);
+    std::string item("Event: CommandOutput");
+    item += EOR;
+    if (!command_->action_id.empty()) {
+        item += "ActionID: " + command_->action_id + EOR;
     }
+    item += command_->batch;
+    item += EOR;
+    command_->batch.clear();
+    ++command_->items;
+    dispatch_(std::move(item));
 }
@@ -0,0 +1,154 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/Subscriber.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+#include <utility>
+
+using namespace cpp_ami;
+
+Subscriber::Subscriber(callback_t callback, Options options)
+    : callback_(std::move(callback))
+    , options_(std::move(options))
+{
+    assert(callback_);
+    assert(options_.capacity > 0);
+
+    if (options_.overflow == Overflow::conflate && !options_.conflate_key) {
+        // Same key as the conflation stage of the dispatcher: newer state of the same kind for the same channel. Events
+        // that don't concern a channel (e.g. PeerStatus) are left alone rather than merged with each other.
+        options_.conflate_key = [](event_t const &event) -> std::string {
+            auto const type = event.get_value("Event");
+            auto const uniqueid = event.get_value("Uniqueid");
+            if (!type || !uniqueid) {
+                return {};
+            }
+            return type.value() + '\n' + uniqueid.value();
+        };
+    }
+
+    thread_ = std::thread(&Subscriber::work_thread, this);
+
+    std::string_view const thread_name(options_.thread_name);
+    assert(thread_name.length() < 16);
+    pthread_setname_np(thread_.native_handle(), thread_name.data());
+}
+
+Subscriber::~Subscriber()
+{
+    {
+        std::unique_lock const lock(mutex_);
+        run_ = false;
+    }
+    ready_cv_.notify_one();
+    room_cv_.notify_all();
+
+    assert(thread_.joinable());
+    assert(thread_.get_id() != std::this_thread::get_id());
+    thread_.join();
+}
+
+void Subscriber::push(std::span<event_ptr_t const> events)
+{
+    if (events.empty()) {
+        return;
+    }
+
+    auto const now = clock_t::now();
+    {
+        std::unique_lock lock(mutex_);
+        for (auto const &event : events) {
+            // Blocking subscribers wait for the delivery thread to make room
+            if (options_.overflow == Overflow::block && queue_.size() >= options_.capacity) {
+                ready_cv_.notify_one();
+                room_cv_.wait(lock, [this]() -> bool { return !run_ || queue_.size() < options_.capacity; });
+            }
+            enqueue(event, now);
+        }
+    }
+    ready_cv_.notify_one();
+}
+
+Subscriber::Metrics Subscriber::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+
+    auto metrics = metrics_;
+    metrics.queued = queue_.size();
+    if (!queue_.empty()) {
+        metrics.lag = clock_t::now() - queue_.front().queued;
+    }
+    return metrics;
+}
+
+void Subscriber::work_thread()
+{
+    std::unique_lock lock(mutex_);
+    while (true) {
+        ready_cv_.wait(lock, [this]() -> bool { return !run_ || !queue_.empty(); });
+
+        // Deliver whatever is left before stopping
+        if (queue_.empty()) {
+            break;
+        }
+
+        // Deliver one event at a time so that newer events can still be conflated into the ones left in the queue
+        auto const event = std::move(queue_.front().event);
+        metrics_.max_lag = std::max<std::chrono::nanoseconds>(metrics_.max_lag, clock_t::now() - queue_.front().queued);
+        pop_front();
+        lock.unlock();
+        room_cv_.notify_one();
+
+        callback_(event.get());
+
+        lock.lock();
+        ++metrics_.delivered;
+    }
+}
+
+void Subscriber::enqueue(event_ptr_t const &event, clock_t::time_point now)
+{
+    std::string key;
+    if (options_.overflow == Overflow::conflate) {
+        key = options_.conflate_key(*event);
+    }
+
+    if (queue_.size() >= options_.capacity) {
+        // Newer state for something that is still waiting to be delivered; overwrite it in place so that the event
+        // keeps its position (and age) in the queue
+        if (auto const it = key.empty() ? keys_.end() : keys_.find(key); it != keys_.end()) {
+            queue_[it->second - head_seq_].event = event;
+            ++metrics_.conflated;
+            return;
+        }
+
+        ++metrics_.dropped;
+        // Conflating subscribers care about the latest state; make room by discarding the oldest event
+        if (options_.overflow != Overflow::conflate) {
+            return;
+        }
+        pop_front();
+    }
+
+    if (!key.empty()) {
+        keys_.insert_or_assign(key, head_seq_ + queue_.size());
+    }
+    queue_.push_back(Entry{ .event = event, .key = std::move(key), .queued = now });
+    metrics_.high_water = std::max(metrics_.high_water, queue_.size());
+}
+
+void Subscriber::pop_front()
+{
+    assert(!queue_.empty());
+    // Only forget the key if no newer event with the same key is queued behind this one
+    if (auto const &key = queue_.front().key; !key.empty()) {
+        if (auto const it = keys_.find(key); it != keys_.end() && it->second == head_seq_) {
+            keys_.erase(it);
+        }
+    }
+    queue_.pop_front();
+    ++head_seq_;
+}
@@ -5,6 +5,7 @@
 
 #include "c++ami/CppAmiDefs.h"
 #include <cassert>
+#include <utility>
 #include <uuid/uuid.h>
 
 using namespace cpp_ami::action;
@@ -39,6 +40,26 @@ std::string Action::get_action_id() const
     return action_id_;
 }
 
+Action::Priority Action::get_priority() const
+{
+    return priority_;
+}
+
+void Action::set_priority(Priority priority)
+{
+    priority_ = priority;
+}
+
+std::string const& Action::get_completion_event() const
+{
+    return completion_event_;
+}
+
+void Action::set_completion_event(std::string event)
+{
+    completion_event_ = std::move(event);
+}
+
 std::string Action::to_string() const
 {
     static std::string action_key{"Action"};
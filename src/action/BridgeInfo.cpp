@@ -0,0 +1,12 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/BridgeInfo.hpp"
+
+using namespace cpp_ami::action;
+
+BridgeInfo::BridgeInfo(std::string bridge_uniqueid)
+    : Action("BridgeInfo", { "BridgeUniqueid" })
+{
+    set_value("BridgeUniqueid", std::move(bridge_uniqueid));
+}
@@ -0,0 +1,11 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/BridgeList.hpp"
+
+using namespace cpp_ami::action;
+
+BridgeList::BridgeList()
+    : Action("BridgeList", { "BridgeType" })
+{
+}
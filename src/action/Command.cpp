@@ -0,0 +1,12 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/Command.hpp"
+
+using namespace cpp_ami::action;
+
+Command::Command(std::string command)
+    : Action("Command", { "Command" })
+{
+    set_value("Command", std::move(command));
+}
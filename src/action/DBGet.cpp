@@ -0,0 +1,13 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/DBGet.hpp"
+
+using namespace cpp_ami::action;
+
+DBGet::DBGet(std::string family, std::string key)
+    : Action("DBGet", { "Family", "Key" })
+{
+    set_value("Family", std::move(family));
+    set_value("Key", std::move(key));
+}
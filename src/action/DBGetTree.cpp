@@ -0,0 +1,12 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/DBGetTree.hpp"
+
+using namespace cpp_ami::action;
+
+DBGetTree::DBGetTree(std::string family)
+    : Action("DBGetTree", { "Family", "Key" })
+{
+    set_value("Family", std::move(family));
+}
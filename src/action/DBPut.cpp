@@ -0,0 +1,14 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/DBPut.hpp"
+
+using namespace cpp_ami::action;
+
+DBPut::DBPut(std::string family, std::string key, std::string val)
+    : Action("DBPut", { "Family", "Key", "Val" })
+{
+    set_value("Family", std::move(family));
+    set_value("Key", std::move(key));
+    set_value("Val", std::move(val));
+}
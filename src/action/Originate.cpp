@@ -0,0 +1,17 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/Originate.hpp"
+
+using namespace cpp_ami::action;
+
+Originate::Originate(std::string channel)
+    : Action("Originate", { "Channel", "Exten", "Context", "Priority", "Application", "Data", "Timeout", "CallerID",
+        "Variable", "Account", "EarlyMedia", "Async", "Codecs", "ChannelId", "OtherChannelId" })
+{
+    set_value("Channel", std::move(channel));
+
+    // The response only says that the call was queued; the outcome is reported by OriginateResponse
+    set_value("Async", "true");
+    set_completion_event("OriginateResponse");
+}
@@ -0,0 +1,11 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/action/QueueSummary.hpp"
+
+using namespace cpp_ami::action;
+
+QueueSummary::QueueSummary()
+    : Action("QueueSummary", { "Queue" })
+{
+}
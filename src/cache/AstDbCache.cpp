@@ -0,0 +1,320 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/AstDbCache.hpp"
+
+#include "c++ami/action/DBDel.hpp"
+#include "c++ami/action/DBGet.hpp"
+#include "c++ami/action/DBGetTree.hpp"
+#include "c++ami/action/DBPut.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/reaction/Event.hpp"
+#include <cassert>
+#include <fmt/core.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami::cache;
+
+namespace {
+
+/// @brief Returns \c true if \c reaction is the error the AMI server reports for a key or family that doesn't exist.
+bool is_not_found(cpp_ami::Connection::reaction_ptr_t const &reaction)
+{
+    auto const *const response = dynamic_cast<cpp_ami::reaction::Event const *>(reaction.get());
+    return response && response->get_value("Message").value_or("").find("not found") != std::string::npos;
+}
+
+}
+
+AstDbCache::AstDbCache(Connection &connection, std::chrono::milliseconds const &timeout, size_t max_batch)
+    : connection_(&connection)
+    , timeout_(timeout)
+    , max_batch_(max_batch)
+{
+    assert(max_batch_ > 0);
+
+    thread_ = std::thread(&AstDbCache::work_thread, this);
+    pthread_setname_np(thread_.native_handle(), "ami_astdb");
+}
+
+AstDbCache::~AstDbCache()
+{
+    if (thread_.joinable()) {
+        {
+            std::unique_lock const lock(mutex_);
+            run_ = false;
+        }
+        write_cv_.notify_one();
+        thread_.join();
+    }
+}
+
+AstDbCache::value_t AstDbCache::get(std::string const &family, std::string const &key)
+{
+    auto const cache_key = entry_key(family, key);
+
+    std::promise<value_t> promise;
+    std::shared_future<value_t> result;
+    {
+        std::unique_lock const lock(mutex_);
+        if (auto const it = entries_.find(cache_key); it != entries_.end()) {
+            ++metrics_.hits;
+            return it->second;
+        }
+        if (!connection_) {
+            throw std::runtime_error("AstDbCache: cache is not attached to a connection");
+        }
+
+        // Someone is already reading the key; wait for their result rather than reading it again
+        ++metrics_.misses;
+        if (auto const it = inflight_.find(cache_key); it != inflight_.end()) {
+            result = it->second.result;
+        }
+        else {
+            inflight_.emplace(cache_key, Inflight{ .result = promise.get_future().share() });
+        }
+    }
+
+    if (result.valid()) {
+        return result.get();
+    }
+
+    value_t value;
+    std::exception_ptr err;
+    try {
+        value = fetch(family, key);
+    }
+    catch (...) {
+        err = std::current_exception();
+    }
+
+    {
+        std::unique_lock const lock(mutex_);
+        // A value read while the key was being written may predate the write; hand it to the waiting lookups but
+        // don't cache it
+        if (auto const it = inflight_.find(cache_key); it != inflight_.end()) {
+            if (!err && !it->second.stale) {
+                entries_.insert_or_assign(cache_key, value);
+            }
+            inflight_.erase(it);
+        }
+    }
+
+    if (err) {
+        promise.set_exception(err);
+        std::rethrow_exception(err);
+    }
+    promise.set_value(value);
+    return value;
+}
+
+void AstDbCache::warm(std::string const &family)
+{
+    if (!connection_) {
+        throw std::runtime_error("AstDbCache: cache is not attached to a connection");
+    }
+
+    // Keys are streamed into the cache as they are listed rather than buffering the whole family
+    action::DBGetTree const action(family);
+    auto const reaction = connection_->invoke(action, [this](event::Event const &item) -> void { load(item); },
+        timeout_);
+    if (!reaction || (!reaction->is_success() && !is_not_found(reaction))) {
+        throw std::runtime_error(fmt::format("AstDbCache: DBGetTree failed for {}; {}", family,
+            reaction ? reaction->to_string() : "request closed"));
+    }
+}
+
+void AstDbCache::put(std::string const &family, std::string const &key, std::string value)
+{
+    enqueue(Write{ .family = family, .key = key, .value = std::move(value) });
+}
+
+void AstDbCache::del(std::string const &family, std::string const &key)
+{
+    enqueue(Write{ .family = family, .key = key, .value = std::nullopt });
+}
+
+void AstDbCache::flush()
+{
+    std::unique_lock lock(mutex_);
+    auto const target = queued_;
+    flushed_cv_.wait(lock, [this, target]() -> bool { return completed_ >= target; });
+}
+
+void AstDbCache::invalidate(std::string const &family)
+{
+    auto const prefix = family.empty() ? std::string() : family + '/';
+    auto const matches = [&prefix](std::string const &cache_key) -> bool { return cache_key.starts_with(prefix); };
+
+    std::unique_lock const lock(mutex_);
+    // Keys with a queued write hold the value the database is about to have
+    std::erase_if(entries_, [this, &matches](auto const &entry) -> bool {
+        return matches(entry.first) && !pending_.contains(entry.first);
+    });
+    for (auto &[cache_key, inflight] : inflight_) {
+        if (matches(cache_key)) {
+            inflight.stale = true;
+        }
+    }
+}
+
+void AstDbCache::load(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (type != "DBGetResponse" && type != "DBGetTreeResponse") {
+        return;
+    }
+
+    auto key = event.get_value("Key");
+    if (!key) {
+        return;
+    }
+
+    // DBGetTreeResponse reports the full path of the key, e.g. /family/subfamily/key
+    std::string cache_key;
+    if (key->starts_with('/')) {
+        cache_key = key->substr(1);
+    }
+    else if (auto const family = event.get_value("Family")) {
+        cache_key = entry_key(family.value(), key.value());
+    }
+    else {
+        return;
+    }
+
+    std::unique_lock const lock(mutex_);
+    if (!pending_.contains(cache_key)) {
+        entries_.insert_or_assign(std::move(cache_key), event.get_value("Val").value_or(std::string()));
+    }
+}
+
+AstDbCache::Metrics AstDbCache::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+    auto metrics = metrics_;
+    metrics.pending = pending_.size();
+    metrics.entries = entries_.size();
+    return metrics;
+}
+
+AstDbCache::value_t AstDbCache::fetch(std::string const &family, std::string const &key) const
+{
+    assert(connection_);
+
+    value_t value;
+    action::DBGet const action(family, key);
+    auto const reaction = connection_->invoke(action, [&value](event::Event const &item) -> void {
+        if (item.get_value("Event") == "DBGetResponse") {
+            value = item.get_value("Val").value_or(std::string());
+        }
+    }, timeout_);
+
+    // A key that doesn't exist is reported as an error
+    if (reaction && !reaction->is_success() && is_not_found(reaction)) {
+        return std::nullopt;
+    }
+    if (!reaction || !reaction->is_success()) {
+        throw std::runtime_error(fmt::format("AstDbCache: DBGet failed for {}/{}; {}", family, key,
+            reaction ? reaction->to_string() : "request closed"));
+    }
+    return value;
+}
+
+void AstDbCache::enqueue(Write write)
+{
+    auto cache_key = entry_key(write.family, write.key);
+    {
+        std::unique_lock const lock(mutex_);
+        entries_.insert_or_assign(cache_key, write.value);
+        if (auto const it = inflight_.find(cache_key); it != inflight_.end()) {
+            it->second.stale = true;
+        }
+        if (!connection_) {
+            return;
+        }
+
+        ++queued_;
+        ++metrics_.writes;
+        // Only the newest value of a key needs to reach the database; the superseded write is done as far as
+        // flush is concerned
+        if (auto const it = pending_.find(cache_key); it != pending_.end()) {
+            it->second = std::move(write);
+            ++metrics_.coalesced;
+            ++completed_;
+            return;
+        }
+        pending_.emplace(cache_key, std::move(write));
+        write_order_.push_back(std::move(cache_key));
+    }
+    write_cv_.notify_one();
+}
+
+void AstDbCache::work_thread()
+{
+    std::unique_lock lock(mutex_);
+    while (true) {
+        write_cv_.wait(lock, [this]() -> bool { return !run_ || !write_order_.empty(); });
+        // Queued writes are still sent when the cache is destroyed
+        if (write_order_.empty()) {
+            break;
+        }
+
+        std::vector<std::string> keys;
+        std::vector<action::Action> actions;
+        while (!write_order_.empty() && actions.size() < max_batch_) {
+            auto node = pending_.extract(write_order_.front());
+            write_order_.pop_front();
+
+            auto &write = node.mapped();
+            if (write.value) {
+                actions.emplace_back(action::DBPut(std::move(write.family), std::move(write.key),
+                    std::move(write.value.value())));
+            }
+            else {
+                actions.emplace_back(action::DBDel(std::move(write.family), std::move(write.key)));
+            }
+            keys.push_back(std::move(node.key()));
+        }
+        lock.unlock();
+
+        // The whole batch goes out in a single write; the AMI server works through it without a round trip per key
+        std::vector<bool> written(actions.size(), false);
+        try {
+            auto reactions = connection_->invoke_many(actions, timeout_);
+            for (size_t i = 0; i < reactions.size(); ++i) {
+                try {
+                    auto const reaction = reactions[i].get();
+                    written[i] = reaction && (reaction->is_success() || is_not_found(reaction));
+                }
+                catch (...) {
+                    // Timed out or lost; counted as a failure below
+                }
+            }
+        }
+        catch (...) {
+            // Nothing was sent; counted as failures below
+        }
+
+        lock.lock();
+        ++metrics_.batches;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            // Read the key back on its next lookup rather than serving a value the database doesn't have
+            if (!written[i]) {
+                ++metrics_.failures;
+                if (!pending_.contains(keys[i])) {
+                    entries_.erase(keys[i]);
+                }
+            }
+        }
+        completed_ += keys.size();
+        flushed_cv_.notify_all();
+    }
+}
+
+std::string AstDbCache::entry_key(std::string const &family, std::string const &key)
+{
+    return family + '/' + key;
+}
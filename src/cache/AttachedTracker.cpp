@@ -0,0 +1,115 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/AttachedTracker.hpp"
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/util/ScopeGuard.hpp"
+#include <fmt/core.h>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+using namespace cpp_ami::cache;
+
+AttachedTracker::AttachedTracker(std::string name)
+    : name_(std::move(name))
+{
+}
+
+AttachedTracker::~AttachedTracker()
+{
+    detach();
+}
+
+void AttachedTracker::refresh(std::chrono::milliseconds const &timeout)
+{
+    // Raises if the tracker is detached
+    connection();
+
+    {
+        std::unique_lock const lock(mutex_);
+        refreshing_ = true;
+        listed_.clear();
+        reported_.clear();
+        begin_refresh();
+    }
+    util::ScopeGuard const refreshing([this]() -> void {
+        std::unique_lock const lock(mutex_);
+        refreshing_ = false;
+        listed_.clear();
+        reported_.clear();
+    });
+
+    synchronize(timeout);
+}
+
+void AttachedTracker::attach(Connection &connection, std::chrono::milliseconds const &timeout)
+{
+    connection_ = &connection;
+    callback_key_ = connection_->add_callback([this](util::KeyValDict const *event) -> void { apply(*event); });
+
+    try {
+        refresh(timeout);
+    }
+    catch (...) {
+        detach();
+        throw;
+    }
+}
+
+void AttachedTracker::detach()
+{
+    if (connection_ && callback_key_) {
+        connection_->remove_callback(callback_key_.value());
+    }
+    connection_ = nullptr;
+    callback_key_.reset();
+}
+
+cpp_ami::Connection& AttachedTracker::connection() const
+{
+    if (!connection_) {
+        throw std::runtime_error(fmt::format("{}: not attached to a connection", name_));
+    }
+    return *connection_;
+}
+
+void AttachedTracker::fetch(action::Action const &action, std::chrono::milliseconds const &timeout)
+{
+    // Stream the items into the tracker as they are listed rather than buffering a potentially huge list
+    auto const reaction = connection().invoke(action, [this](event::Event const &item) -> void { load(item); },
+        timeout);
+    if (!reaction || !reaction->is_success()) {
+        throw std::runtime_error(fmt::format("{}: {} failed; {}", name_, action.get_action(),
+            reaction ? reaction->to_string() : "request closed"));
+    }
+}
+
+void AttachedTracker::begin_refresh()
+{
+}
+
+bool AttachedTracker::list(std::string const &key)
+{
+    if (!refreshing_) {
+        return true;
+    }
+
+    // Events received since the refresh started are newer than the listed state
+    listed_.insert(key);
+    return !reported_.contains(key);
+}
+
+void AttachedTracker::report(std::string const &key)
+{
+    if (refreshing_) {
+        reported_.insert(key);
+    }
+}
+
+bool AttachedTracker::seen(std::string const &key) const
+{
+    return listed_.contains(key) || reported_.contains(key);
+}
@@ -0,0 +1,339 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/BridgeTracker.hpp"
+
+#include "c++ami/action/BridgeInfo.hpp"
+#include "c++ami/action/BridgeList.hpp"
+#include "c++ami/Connection.hpp"
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+using namespace cpp_ami::cache;
+
+namespace {
+
+/// Event fields describing a bridge and the members they are stored in.
+std::array<std::pair<char const *, std::string BridgeTracker::Bridge::*>, 4> const BRIDGE_FIELDS{ {
+    { "BridgeType", &BridgeTracker::Bridge::type },
+    { "BridgeTechnology", &BridgeTracker::Bridge::technology },
+    { "BridgeCreator", &BridgeTracker::Bridge::creator },
+    { "BridgeName", &BridgeTracker::Bridge::name },
+} };
+
+/// @brief Returns the refresh bookkeeping key of bridge \c bridge.
+std::string bridge_key(std::string const &bridge)
+{
+    return 'b' + bridge;
+}
+
+/// @brief Returns the refresh bookkeeping key of the channel with unique ID \c uniqueid.
+std::string channel_key(std::string const &uniqueid)
+{
+    return 'c' + uniqueid;
+}
+
+}
+
+BridgeTracker::BridgeTracker()
+    : AttachedTracker("BridgeTracker")
+{
+}
+
+BridgeTracker::BridgeTracker(Connection &connection, std::chrono::milliseconds const &timeout)
+    : BridgeTracker()
+{
+    attach(connection, timeout);
+}
+
+BridgeTracker::~BridgeTracker()
+{
+    detach();
+}
+
+void BridgeTracker::synchronize(std::chrono::milliseconds const &timeout)
+{
+    fetch(action::BridgeList(), timeout);
+
+    std::vector<std::string> listed;
+    {
+        std::shared_lock const lock(mutex_);
+        for (auto const &[bridge, _] : bridges_) {
+            if (seen(bridge_key(bridge))) {
+                listed.push_back(bridge);
+            }
+        }
+    }
+
+    // BridgeInfo lists the participants of a single bridge; keep every request in flight at once rather than waiting
+    // out a round trip per bridge
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    auto remaining = listed.size();
+    std::exception_ptr error;
+    for (auto const &bridge : listed) {
+        connection().async_invoke(action::BridgeInfo(bridge),
+            [this, bridge](event::Event const &item) -> void { load_participant(bridge, item); },
+            [&](Connection::reaction_ptr_t reaction, std::exception_ptr const &err) -> void {
+                std::unique_lock const lock(done_mutex);
+                // A bridge destroyed since it was listed answers with an error; its BridgeDestroy takes care of it
+                if (!error && (err || !reaction)) {
+                    error = err ? err : std::make_exception_ptr(
+                        std::runtime_error("BridgeTracker: BridgeInfo failed; request closed"));
+                }
+                if (--remaining == 0) {
+                    done_cv.notify_all();
+                }
+            },
+            timeout);
+    }
+    {
+        std::unique_lock lock(done_mutex);
+        done_cv.wait(lock, [&remaining]() -> bool { return remaining == 0; });
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    // Drop whatever went away without this tracker seeing it leave
+    std::unique_lock const lock(mutex_);
+    std::vector<std::string> stale;
+    for (auto const &[bridge, _] : bridges_) {
+        if (!seen(bridge_key(bridge))) {
+            stale.push_back(bridge);
+        }
+    }
+    for (auto const &bridge : stale) {
+        destroy(bridge);
+    }
+
+    std::vector<std::pair<std::string, std::string>> unbridged;
+    for (auto const &[uniqueid, bridge] : channels_) {
+        if (!seen(channel_key(uniqueid))) {
+            unbridged.emplace_back(bridge, uniqueid);
+        }
+    }
+    for (auto const &[bridge, uniqueid] : unbridged) {
+        leave(bridge, uniqueid);
+    }
+}
+
+void BridgeTracker::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (!type) {
+        return;
+    }
+
+    if (type == "BridgeMerge") {
+        auto const to = event.get_value("ToBridgeUniqueid");
+        auto const from = event.get_value("FromBridgeUniqueid");
+        if (!to || !from) {
+            return;
+        }
+
+        std::unique_lock const lock(mutex_);
+        report(bridge_key(to.value()));
+        report(bridge_key(from.value()));
+        if (auto const it = bridges_.find(from.value()); it != bridges_.end()) {
+            // Hold on to the source bridge; entering the channels into the target empties it
+            auto const source = it->second;
+            for (auto const &participant : source->participants) {
+                report(channel_key(participant.uniqueid));
+                enter(to.value(), participant, nullptr);
+            }
+        }
+        return;
+    }
+
+    auto const bridge = event.get_value("BridgeUniqueid");
+    if (!bridge) {
+        return;
+    }
+
+    if (type == "BridgeCreate") {
+        std::unique_lock const lock(mutex_);
+        report(bridge_key(bridge.value()));
+        auto copy = edit(bridge.value());
+        update(*copy, event);
+        bridges_.insert_or_assign(bridge.value(), std::move(copy));
+    }
+    else if (type == "BridgeDestroy") {
+        std::unique_lock const lock(mutex_);
+        report(bridge_key(bridge.value()));
+        destroy(bridge.value());
+    }
+    else if (type == "BridgeEnter" || type == "BridgeLeave") {
+        auto const uniqueid = event.get_value("Uniqueid");
+        if (!uniqueid) {
+            return;
+        }
+
+        std::unique_lock const lock(mutex_);
+        report(channel_key(uniqueid.value()));
+        if (type == "BridgeEnter") {
+            report(bridge_key(bridge.value()));
+            enter(bridge.value(), Participant{
+                .uniqueid = uniqueid.value(),
+                .channel = event.get_value("Channel").value_or(std::string()) }, &event);
+        }
+        else {
+            leave(bridge.value(), uniqueid.value());
+        }
+    }
+}
+
+void BridgeTracker::load(util::KeyValDict const &event)
+{
+    auto const bridge = event.get_value("BridgeUniqueid");
+    if (event.get_value("Event") != "BridgeListItem" || !bridge) {
+        return;
+    }
+
+    std::unique_lock const lock(mutex_);
+    if (list(bridge_key(bridge.value()))) {
+        auto copy = edit(bridge.value());
+        update(*copy, event);
+        bridges_.insert_or_assign(bridge.value(), std::move(copy));
+    }
+}
+
+void BridgeTracker::load_participant(std::string const &bridge, util::KeyValDict const &item)
+{
+    auto const uniqueid = item.get_value("Uniqueid");
+    if (item.get_value("Event") != "BridgeInfoChannel" || !uniqueid) {
+        return;
+    }
+
+    std::unique_lock const lock(mutex_);
+    // A bridge destroyed since it was listed isn't revived by its participants
+    if (!list(channel_key(uniqueid.value())) || !bridges_.contains(bridge)) {
+        return;
+    }
+    enter(bridge, Participant{
+        .uniqueid = uniqueid.value(),
+        .channel = item.get_value("Channel").value_or(std::string()) }, nullptr);
+}
+
+BridgeTracker::bridge_ptr_t BridgeTracker::find(std::string const &bridge) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = bridges_.find(bridge); it != bridges_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+BridgeTracker::bridge_ptr_t BridgeTracker::bridge_of(std::string const &uniqueid) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = channels_.find(uniqueid); it != channels_.end()) {
+        return bridges_.at(it->second);
+    }
+    return nullptr;
+}
+
+std::vector<BridgeTracker::Participant> BridgeTracker::peers(std::string const &uniqueid) const
+{
+    auto const bridge = bridge_of(uniqueid);
+    if (!bridge) {
+        return {};
+    }
+
+    std::vector<Participant> peers;
+    peers.reserve(bridge->participants.size());
+    for (auto const &participant : bridge->participants) {
+        if (participant.uniqueid != uniqueid) {
+            peers.push_back(participant);
+        }
+    }
+    return peers;
+}
+
+std::vector<BridgeTracker::bridge_ptr_t> BridgeTracker::snapshot() const
+{
+    std::vector<bridge_ptr_t> bridges;
+
+    std::shared_lock const lock(mutex_);
+    bridges.reserve(bridges_.size());
+    for (auto const &[_, bridge] : bridges_) {
+        bridges.push_back(bridge);
+    }
+    return bridges;
+}
+
+std::shared_ptr<BridgeTracker::Bridge> BridgeTracker::edit(std::string const &bridge) const
+{
+    // Copy-on-write; readers holding the previous snapshot keep seeing a consistent bridge
+    if (auto const it = bridges_.find(bridge); it != bridges_.end()) {
+        return std::make_shared<Bridge>(*it->second);
+    }
+    auto created = std::make_shared<Bridge>();
+    created->uniqueid = bridge;
+    return created;
+}
+
+void BridgeTracker::enter(std::string const &bridge, Participant participant, util::KeyValDict const *event)
+{
+    // A channel is in one bridge at a time; entering a bridge implies leaving the previous one
+    if (auto const it = channels_.find(participant.uniqueid); it != channels_.end() && it->second != bridge) {
+        leave(it->second, participant.uniqueid);
+    }
+
+    auto copy = edit(bridge);
+    if (event) {
+        update(*copy, *event);
+    }
+    std::erase_if(copy->participants, [&participant](Participant const &current) -> bool {
+        return current.uniqueid == participant.uniqueid;
+    });
+    channels_.insert_or_assign(participant.uniqueid, bridge);
+    copy->participants.push_back(std::move(participant));
+    bridges_.insert_or_assign(bridge, std::move(copy));
+}
+
+void BridgeTracker::leave(std::string const &bridge, std::string const &uniqueid)
+{
+    if (auto const it = channels_.find(uniqueid); it != channels_.end() && it->second == bridge) {
+        channels_.erase(it);
+    }
+
+    auto const it = bridges_.find(bridge);
+    if (it == bridges_.end()) {
+        return;
+    }
+    auto copy = std::make_shared<Bridge>(*it->second);
+    if (std::erase_if(copy->participants, [&uniqueid](Participant const &current) -> bool {
+            return current.uniqueid == uniqueid;
+        }) > 0) {
+        it->second = std::move(copy);
+    }
+}
+
+void BridgeTracker::destroy(std::string const &bridge)
+{
+    auto const it = bridges_.find(bridge);
+    if (it == bridges_.end()) {
+        return;
+    }
+
+    for (auto const &participant : it->second->participants) {
+        if (auto const c_it = channels_.find(participant.uniqueid); c_it != channels_.end() && c_it->second == bridge) {
+            channels_.erase(c_it);
+        }
+    }
+    bridges_.erase(it);
+}
+
+void BridgeTracker::update(Bridge &bridge, util::KeyValDict const &event)
+{
+    for (auto const &[key, member] : BRIDGE_FIELDS) {
+        if (auto value = event.get_value(key)) {
+            bridge.*member = std::move(value.value());
+        }
+    }
+}
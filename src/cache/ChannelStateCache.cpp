@@ -0,0 +1,256 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/ChannelStateCache.hpp"
+
+#include "c++ami/action/CoreShowChannels.hpp"
+#include <array>
+#include <mutex>
+#include <utility>
+
+using namespace cpp_ami::cache;
+
+namespace {
+
+/// Event fields describing a channel and the members they are stored in. Newexten reports the application arguments
+/// as AppData, CoreShowChannel as ApplicationData.
+std::array<std::pair<char const *, std::string ChannelStateCache::Channel::*>, 16> const CHANNEL_FIELDS{ {
+    { "Linkedid", &ChannelStateCache::Channel::linkedid },
+    { "Channel", &ChannelStateCache::Channel::channel },
+    { "ChannelState", &ChannelStateCache::Channel::state },
+    { "ChannelStateDesc", &ChannelStateCache::Channel::state_desc },
+    { "CallerIDNum", &ChannelStateCache::Channel::caller_id_num },
+    { "CallerIDName", &ChannelStateCache::Channel::caller_id_name },
+    { "ConnectedLineNum", &ChannelStateCache::Channel::connected_line_num },
+    { "ConnectedLineName", &ChannelStateCache::Channel::connected_line_name },
+    { "AccountCode", &ChannelStateCache::Channel::account_code },
+    { "Context", &ChannelStateCache::Channel::context },
+    { "Exten", &ChannelStateCache::Channel::exten },
+    { "Priority", &ChannelStateCache::Channel::priority },
+    { "Application", &ChannelStateCache::Channel::application },
+    { "ApplicationData", &ChannelStateCache::Channel::application_data },
+    { "AppData", &ChannelStateCache::Channel::application_data },
+    { "BridgeId", &ChannelStateCache::Channel::bridge_id },
+} };
+
+}
+
+ChannelStateCache::ChannelStateCache()
+    : AttachedTracker("ChannelStateCache")
+{
+}
+
+ChannelStateCache::ChannelStateCache(Connection &connection, std::chrono::milliseconds const &timeout)
+    : ChannelStateCache()
+{
+    attach(connection, timeout);
+}
+
+ChannelStateCache::~ChannelStateCache()
+{
+    detach();
+}
+
+void ChannelStateCache::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    auto const uniqueid = event.get_value("Uniqueid");
+    if (!type || !uniqueid) {
+        return;
+    }
+
+    if (type == "Hangup") {
+        std::unique_lock const lock(mutex_);
+        erase(uniqueid.value());
+        // Keep the channel from being resurrected by a channel list that was generated before the hangup
+        report(uniqueid.value());
+        return;
+    }
+
+    auto const is_new = type == "Newchannel";
+    if (!is_new && type != "Newstate" && type != "Newexten" && type != "NewCallerid" && type != "NewConnectedLine" &&
+        type != "Rename" && type != "VarSet") {
+        return;
+    }
+
+    std::unique_lock const lock(mutex_);
+
+    // Copy-on-write; readers holding the previous snapshot keep seeing a consistent channel. Channel events carry the
+    // full channel snapshot so a channel missed by the bootstrap is picked up by its next event.
+    auto channel = std::make_shared<Channel>();
+    if (auto const it = channels_.find(uniqueid.value()); !is_new && it != channels_.end()) {
+        *channel = *it->second.channel;
+    }
+    channel->uniqueid = uniqueid.value();
+    update(*channel, event);
+
+    if (type == "Rename") {
+        if (auto new_name = event.get_value("Newname")) {
+            channel->channel = std::move(new_name.value());
+        }
+    }
+    else if (type == "VarSet") {
+        if (auto variable = event.get_value("Variable")) {
+            channel->variables[std::move(variable.value())] = event.get_value("Value").value_or(std::string());
+        }
+    }
+
+    store(std::move(channel));
+}
+
+void ChannelStateCache::load(util::KeyValDict const &event)
+{
+    auto const uniqueid = event.get_value("Uniqueid");
+    if (!uniqueid) {
+        return;
+    }
+
+    std::unique_lock const lock(mutex_);
+    if (!list(uniqueid.value())) {
+        return;
+    }
+
+    // Channel events stamp the channel with the current epoch; they are newer than the listed state too
+    auto const it = channels_.find(uniqueid.value());
+    if (it != channels_.end() && it->second.epoch == epoch_) {
+        return;
+    }
+
+    auto channel = std::make_shared<Channel>();
+    if (it != channels_.end()) {
+        *channel = *it->second.channel;
+    }
+    channel->uniqueid = uniqueid.value();
+    update(*channel, event);
+    store(std::move(channel));
+}
+
+ChannelStateCache::channel_ptr_t ChannelStateCache::find_by_uniqueid(std::string const &uniqueid) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = channels_.find(uniqueid); it != channels_.end()) {
+        return it->second.channel;
+    }
+    return nullptr;
+}
+
+ChannelStateCache::channel_ptr_t ChannelStateCache::find_by_channel(std::string const &channel) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = by_channel_.find(channel); it != by_channel_.end()) {
+        return channels_.at(it->second).channel;
+    }
+    return nullptr;
+}
+
+std::vector<ChannelStateCache::channel_ptr_t> ChannelStateCache::find_by_linkedid(std::string const &linkedid) const
+{
+    std::vector<channel_ptr_t> channels;
+
+    std::shared_lock const lock(mutex_);
+    if (auto const it = by_linkedid_.find(linkedid); it != by_linkedid_.end()) {
+        channels.reserve(it->second.size());
+        for (auto const &uniqueid : it->second) {
+            channels.push_back(channels_.at(uniqueid).channel);
+        }
+    }
+    return channels;
+}
+
+std::vector<ChannelStateCache::channel_ptr_t> ChannelStateCache::snapshot() const
+{
+    std::vector<channel_ptr_t> channels;
+
+    std::shared_lock const lock(mutex_);
+    channels.reserve(channels_.size());
+    for (auto const &[_, entry] : channels_) {
+        channels.push_back(entry.channel);
+    }
+    return channels;
+}
+
+size_t ChannelStateCache::size() const
+{
+    std::shared_lock const lock(mutex_);
+    return channels_.size();
+}
+
+void ChannelStateCache::synchronize(std::chrono::milliseconds const &timeout)
+{
+    fetch(action::CoreShowChannels(), timeout);
+
+    // Drop channels that went away without this cache seeing their hangup
+    std::unique_lock const lock(mutex_);
+    std::vector<std::string> stale;
+    for (auto const &[uniqueid, entry] : channels_) {
+        if (entry.epoch < epoch_) {
+            stale.push_back(uniqueid);
+        }
+    }
+    for (auto const &uniqueid : stale) {
+        erase(uniqueid);
+    }
+}
+
+void ChannelStateCache::begin_refresh()
+{
+    ++epoch_;
+}
+
+void ChannelStateCache::store(channel_ptr_t channel)
+{
+    auto const [it, inserted] = channels_.try_emplace(channel->uniqueid, Entry{ .channel = channel, .epoch = epoch_ });
+    if (!inserted) {
+        auto const &previous = *it->second.channel;
+        // Masquerades swap channel names; only drop the old name if it still refers to this channel
+        if (auto const c_it = by_channel_.find(previous.channel);
+            previous.channel != channel->channel && c_it != by_channel_.end() && c_it->second == previous.uniqueid) {
+            by_channel_.erase(c_it);
+        }
+        if (previous.linkedid != channel->linkedid) {
+            if (auto const l_it = by_linkedid_.find(previous.linkedid); l_it != by_linkedid_.end()) {
+                l_it->second.erase(previous.uniqueid);
+                if (l_it->second.empty()) {
+                    by_linkedid_.erase(l_it);
+                }
+            }
+        }
+        it->second = Entry{ .channel = channel, .epoch = epoch_ };
+    }
+
+    if (!channel->channel.empty()) {
+        by_channel_[channel->channel] = channel->uniqueid;
+    }
+    if (!channel->linkedid.empty()) {
+        by_linkedid_[channel->linkedid].insert(channel->uniqueid);
+    }
+}
+
+void ChannelStateCache::erase(std::string const &uniqueid)
+{
+    auto const it = channels_.find(uniqueid);
+    if (it == channels_.end()) {
+        return;
+    }
+
+    auto const &channel = *it->second.channel;
+    if (auto const c_it = by_channel_.find(channel.channel); c_it != by_channel_.end() && c_it->second == uniqueid) {
+        by_channel_.erase(c_it);
+    }
+    if (auto const l_it = by_linkedid_.find(channel.linkedid); l_it != by_linkedid_.end()) {
+        l_it->second.erase(uniqueid);
+        if (l_it->second.empty()) {
+            by_linkedid_.erase(l_it);
+        }
+    }
+    channels_.erase(it);
+}
+
+void ChannelStateCache::update(Channel &channel, util::KeyValDict const &event)
+{
+    for (auto const &[key, member] : CHANNEL_FIELDS) {
+        if (auto value = event.get_value(key)) {
+            channel.*member = std::move(value.value());
+        }
+    }
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/DeviceStateCache.hpp"
+
+#include "c++ami/action/DeviceStateList.hpp"
+#include "c++ami/action/ExtensionState.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/reaction/Event.hpp"
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami::cache;
+
+DeviceStateCache::DeviceStateCache()
+    : AttachedTracker("DeviceStateCache")
+{
+}
+
+DeviceStateCache::DeviceStateCache(Connection &connection, std::chrono::milliseconds const &timeout)
+    : DeviceStateCache()
+{
+    attach(connection, timeout);
+}
+
+DeviceStateCache::~DeviceStateCache()
+{
+    detach();
+}
+
+DeviceStateCache::extension_ptr_t DeviceStateCache::fetch_extension(std::string const &exten,
+    std::string const &context, std::chrono::milliseconds const &timeout)
+{
+    action::ExtensionState action;
+    action.set_value("Exten", exten);
+    action.set_value("Context", context);
+
+    auto const reaction = connection().invoke(action, timeout);
+    auto const *const response = dynamic_cast<reaction::Event const *>(reaction.get());
+    if (!response || !response->is_success()) {
+        throw std::runtime_error(fmt::format("DeviceStateCache: ExtensionState failed for {}@{}; {}", exten, context,
+            reaction ? reaction->to_string() : "request closed"));
+    }
+
+    store(Extension{
+        .exten = exten,
+        .context = context,
+        .hint = response->get_value("Hint").value_or(std::string()),
+        .status = response->get_value("Status").value_or(std::string()),
+        .status_text = response->get_value("StatusText").value_or(std::string()) });
+
+    return find_extension(exten, context);
+}
+
+void DeviceStateCache::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (type == "DeviceStateChange") {
+        if (auto device = event.get_value("Device")) {
+            store(Device{ .device = std::move(device.value()), .state = event.get_value("State").value_or("") }, false);
+        }
+    }
+    else if (type == "ExtensionStatus") {
+        auto exten = event.get_value("Exten");
+        auto context = event.get_value("Context");
+        if (exten && context) {
+            store(Extension{
+                .exten = std::move(exten.value()),
+                .context = std::move(context.value()),
+                .hint = event.get_value("Hint").value_or(std::string()),
+                .status = event.get_value("Status").value_or(std::string()),
+                .status_text = event.get_value("StatusText").value_or(std::string()) });
+        }
+    }
+}
+
+void DeviceStateCache::load(util::KeyValDict const &event)
+{
+    if (auto device = event.get_value("Device")) {
+        store(Device{ .device = std::move(device.value()), .state = event.get_value("State").value_or("") }, true);
+    }
+}
+
+DeviceStateCache::device_ptr_t DeviceStateCache::find_device(std::string const &device) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = devices_.find(device); it != devices_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+DeviceStateCache::extension_ptr_t DeviceStateCache::find_extension(std::string const &exten,
+    std::string const &context) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = extensions_.find(extension_key(exten, context)); it != extensions_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+DeviceStateCache::subscription_t DeviceStateCache::subscribe_device(std::string const &device,
+    device_listener_t listener)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    auto const id = ++next_subscription_;
+    device_listeners_[device].emplace(id, std::move(listener));
+    subscriptions_.emplace(id, device);
+    return id;
+}
+
+DeviceStateCache::subscription_t DeviceStateCache::subscribe_extension(std::string const &exten,
+    std::string const &context, extension_listener_t listener)
+{
+    auto key = extension_key(exten, context);
+
+    std::unique_lock const lock(listeners_mutex_);
+    auto const id = ++next_subscription_;
+    extension_listeners_[key].emplace(id, std::move(listener));
+    subscriptions_.emplace(id, std::move(key));
+    return id;
+}
+
+void DeviceStateCache::unsubscribe(subscription_t id)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    auto const it = subscriptions_.find(id);
+    if (it == subscriptions_.end()) {
+        return;
+    }
+
+    // Subscription IDs are unique across both kinds of listeners; whichever map holds the ID gives it up
+    if (auto const d_it = device_listeners_.find(it->second); d_it != device_listeners_.end()) {
+        d_it->second.erase(id);
+        if (d_it->second.empty()) {
+            device_listeners_.erase(d_it);
+        }
+    }
+    if (auto const e_it = extension_listeners_.find(it->second); e_it != extension_listeners_.end()) {
+        e_it->second.erase(id);
+        if (e_it->second.empty()) {
+            extension_listeners_.erase(e_it);
+        }
+    }
+    subscriptions_.erase(it);
+}
+
+void DeviceStateCache::synchronize(std::chrono::milliseconds const &timeout)
+{
+    fetch(action::DeviceStateList(), timeout);
+}
+
+void DeviceStateCache::store(Device device, bool listed)
+{
+    // Events and listed states are stored on different threads; the listeners must see the changes in the order they
+    // were made, so the change and its notification happen under the same lock
+    std::unique_lock const notify_lock(notify_mutex_);
+    auto state = std::make_shared<Device const>(std::move(device));
+    {
+        std::unique_lock const lock(mutex_);
+        if (!listed) {
+            report(state->device);
+        }
+        else if (!list(state->device)) {
+            return;
+        }
+
+        auto &current = devices_[state->device];
+        if (current && current->state == state->state) {
+            return;
+        }
+        current = state;
+    }
+
+    std::vector<device_listener_t> listeners;
+    {
+        std::unique_lock const lock(listeners_mutex_);
+        if (auto const it = device_listeners_.find(state->device); it != device_listeners_.end()) {
+            for (auto const &[_, listener] : it->second) {
+                listeners.push_back(listener);
+            }
+        }
+    }
+    for (auto const &listener : listeners) {
+        listener(*state);
+    }
+}
+
+void DeviceStateCache::store(Extension extension)
+{
+    std::unique_lock const notify_lock(notify_mutex_);
+    auto const key = extension_key(extension.exten, extension.context);
+    auto state = std::make_shared<Extension const>(std::move(extension));
+    {
+        std::unique_lock const lock(mutex_);
+        auto &current = extensions_[key];
+        if (current && current->status == state->status && current->hint == state->hint) {
+            return;
+        }
+        current = state;
+    }
+
+    std::vector<extension_listener_t> listeners;
+    {
+        std::unique_lock const lock(listeners_mutex_);
+        if (auto const it = extension_listeners_.find(key); it != extension_listeners_.end()) {
+            for (auto const &[_, listener] : it->second) {
+                listeners.push_back(listener);
+            }
+        }
+    }
+    for (auto const &listener : listeners) {
+        listener(*state);
+    }
+}
+
+std::string DeviceStateCache::extension_key(std::string const &exten, std::string const &context)
+{
+    return exten + '@' + context;
+}
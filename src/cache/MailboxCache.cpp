@@ -0,0 +1,245 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/MailboxCache.hpp"
+
+#include "c++ami/action/MailboxCount.hpp"
+#include "c++ami/action/MailboxStatus.hpp"
+#include "c++ami/action/VoicemailRefresh.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/reaction/Event.hpp"
+#include <cassert>
+#include <charconv>
+#include <fmt/core.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami::cache;
+
+namespace {
+
+/// @brief Returns the integer value of \c value, or 0 if \c value is missing or not a number.
+int to_int(std::optional<std::string> const &value)
+{
+    int result{ 0 };
+    if (value) {
+        std::from_chars(value->data(), value->data() + value->size(), result);
+    }
+    return result;
+}
+
+/// @brief Returns the response to a mailbox query, raising an exception if the query failed.
+cpp_ami::reaction::Event const &to_response(cpp_ami::Connection::reaction_ptr_t const &reaction,
+    std::string const &action, std::string const &mailbox)
+{
+    auto const *const response = dynamic_cast<cpp_ami::reaction::Event const *>(reaction.get());
+    if (!response || !response->is_success()) {
+        throw std::runtime_error(fmt::format("MailboxCache: {} failed for {}; {}", action, mailbox,
+            reaction ? reaction->to_string() : "request closed"));
+    }
+    return *response;
+}
+
+}
+
+MailboxCache::MailboxCache(fetch_t fetch)
+    : fetch_(std::move(fetch))
+{
+    assert(fetch_);
+}
+
+MailboxCache::MailboxCache(Connection &connection, std::chrono::milliseconds const &timeout)
+    : connection_(&connection)
+    , timeout_(timeout)
+    , fetch_([this](std::string const &mailbox) -> Mailbox { return fetch(mailbox); })
+{
+    callback_key_ = connection_->add_callback([this](util::KeyValDict const *event) -> void { apply(*event); });
+}
+
+MailboxCache::~MailboxCache()
+{
+    if (connection_ && callback_key_) {
+        connection_->remove_callback(callback_key_.value());
+    }
+}
+
+MailboxCache::mailbox_ptr_t MailboxCache::get(std::string const &mailbox)
+{
+    auto const key = normalize(mailbox);
+
+    std::promise<mailbox_ptr_t> promise;
+    std::shared_future<mailbox_ptr_t> result;
+    {
+        std::unique_lock const lock(mutex_);
+        if (auto const it = mailboxes_.find(key); it != mailboxes_.end()) {
+            return it->second;
+        }
+
+        // Someone is already querying the mailbox; wait for their result rather than querying it again
+        if (auto const it = inflight_.find(key); it != inflight_.end()) {
+            result = it->second.result;
+        }
+        else {
+            inflight_.emplace(key, Inflight{ .result = promise.get_future().share() });
+        }
+    }
+
+    if (result.valid()) {
+        return result.get();
+    }
+
+    mailbox_ptr_t counts;
+    std::exception_ptr err;
+    try {
+        counts = std::make_shared<Mailbox const>(fetch_(key));
+    }
+    catch (...) {
+        err = std::current_exception();
+    }
+
+    {
+        std::unique_lock const lock(mutex_);
+        // Counts reported by the query may predate an event that arrived while it was in flight; hand them to the
+        // waiting lookups but don't cache them
+        if (auto const it = inflight_.find(key); it != inflight_.end()) {
+            if (counts && !it->second.stale) {
+                mailboxes_[key] = counts;
+            }
+            inflight_.erase(it);
+        }
+    }
+
+    if (err) {
+        promise.set_exception(err);
+        std::rethrow_exception(err);
+    }
+    promise.set_value(counts);
+    return counts;
+}
+
+MailboxCache::mailbox_ptr_t MailboxCache::find(std::string const &mailbox) const
+{
+    std::unique_lock const lock(mutex_);
+    if (auto const it = mailboxes_.find(normalize(mailbox)); it != mailboxes_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+void MailboxCache::invalidate(std::string const &mailbox)
+{
+    std::unique_lock const lock(mutex_);
+    drop(normalize(mailbox));
+}
+
+void MailboxCache::resync(std::string const &mailbox)
+{
+    {
+        std::unique_lock const lock(mutex_);
+        if (mailbox.empty()) {
+            mailboxes_.clear();
+            for (auto &[_, inflight] : inflight_) {
+                inflight.stale = true;
+            }
+        }
+        else {
+            drop(normalize(mailbox));
+        }
+    }
+
+    if (!connection_) {
+        return;
+    }
+
+    // Have Asterisk re-read the mailbox from storage; any changes are published through MessageWaiting events
+    action::VoicemailRefresh action;
+    if (!mailbox.empty()) {
+        auto const key = normalize(mailbox);
+        auto const sep = key.find('@');
+        action.set_value("Mailbox", key.substr(0, sep));
+        action.set_value("Context", key.substr(sep + 1));
+    }
+    connection_->async_invoke(action, [](Connection::reaction_ptr_t, std::exception_ptr) -> void {}, timeout_);
+}
+
+void MailboxCache::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (type == "MessageWaiting") {
+        auto const mailbox = event.get_value("Mailbox");
+        if (!mailbox) {
+            return;
+        }
+
+        auto const key = normalize(mailbox.value());
+        std::unique_lock const lock(mutex_);
+
+        // Event without counts only tells us that something changed
+        auto const new_messages = event.get_value("New");
+        auto const old_messages = event.get_value("Old");
+        if (!new_messages || !old_messages) {
+            drop(key);
+            return;
+        }
+
+        if (auto const it = inflight_.find(key); it != inflight_.end()) {
+            it->second.stale = true;
+        }
+
+        // Only mailboxes someone looked up are cached; don't populate mailboxes nobody is interested in
+        if (auto const it = mailboxes_.find(key); it != mailboxes_.end()) {
+            auto counts = std::make_shared<Mailbox>(*it->second);
+            counts->new_messages = to_int(new_messages);
+            counts->old_messages = to_int(old_messages);
+            counts->waiting = event.get_value("Waiting").value_or("") == "1" || counts->new_messages > 0;
+            it->second = std::move(counts);
+        }
+    }
+    else if (type == "VoicemailPasswordChange") {
+        auto const mailbox = event.get_value("Mailbox");
+        if (!mailbox) {
+            return;
+        }
+
+        std::unique_lock const lock(mutex_);
+        drop(normalize(mailbox.value() + '@' + event.get_value("Context").value_or("default")));
+    }
+}
+
+MailboxCache::Mailbox MailboxCache::fetch(std::string const &mailbox) const
+{
+    assert(connection_);
+
+    // Both queries go out in a single write so a miss costs one round trip
+    std::vector<action::Action> const actions{ action::MailboxCount(mailbox), action::MailboxStatus(mailbox) };
+    auto reactions = connection_->invoke_many(actions, timeout_);
+
+    auto const count = reactions[0].get();
+    auto const status = reactions[1].get();
+    auto const &count_response = to_response(count, "MailboxCount", mailbox);
+    auto const &status_response = to_response(status, "MailboxStatus", mailbox);
+
+    return Mailbox{
+        .mailbox = mailbox,
+        .urgent_messages = to_int(count_response.get_value("UrgMessages")),
+        .new_messages = to_int(count_response.get_value("NewMessages")),
+        .old_messages = to_int(count_response.get_value("OldMessages")),
+        .waiting = to_int(status_response.get_value("Waiting")) != 0 };
+}
+
+void MailboxCache::drop(std::string const &mailbox)
+{
+    mailboxes_.erase(mailbox);
+    if (auto const it = inflight_.find(mailbox); it != inflight_.end()) {
+        it->second.stale = true;
+    }
+}
+
+std::string MailboxCache::normalize(std::string const &mailbox)
+{
+    if (mailbox.find('@') != std::string::npos) {
+        return mailbox;
+    }
+    return mailbox + "@default";
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/ParkingTracker.hpp"
+
+#include "c++ami/action/ParkedCalls.hpp"
+#include "c++ami/action/Parkinglots.hpp"
+#include <mutex>
+#include <utility>
+
+using namespace cpp_ami::cache;
+
+ParkingTracker::ParkingTracker()
+    : AttachedTracker("ParkingTracker")
+{
+}
+
+ParkingTracker::ParkingTracker(Connection &connection, std::chrono::milliseconds const &timeout)
+    : ParkingTracker()
+{
+    attach(connection, timeout);
+}
+
+ParkingTracker::~ParkingTracker()
+{
+    detach();
+}
+
+void ParkingTracker::synchronize(std::chrono::milliseconds const &timeout)
+{
+    // Lots first so that every listed call has its lot
+    fetch(action::Parkinglots(), timeout);
+    fetch(action::ParkedCalls(), timeout);
+
+    // Empty the slots whose call went away without this tracker seeing it leave
+    std::vector<parked_call_ptr_t> stale;
+    {
+        std::unique_lock const lock(mutex_);
+        for (auto it = slots_.begin(); it != slots_.end(); ) {
+            if (it->second.epoch < epoch_) {
+                stale.push_back(std::move(it->second.call));
+                it = slots_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+    for (auto const &call : stale) {
+        notify(call->lot, call->space, nullptr);
+    }
+}
+
+void ParkingTracker::begin_refresh()
+{
+    ++epoch_;
+}
+
+void ParkingTracker::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (!type) {
+        return;
+    }
+
+    // A swap replaces the parkee of the slot with the channel that took its place
+    if (type == "ParkedCall" || type == "ParkedCallSwap") {
+        auto call = to_parked_call(event);
+        if (!call->lot.empty() && !call->space.empty()) {
+            auto const lot = call->lot;
+            auto const space = call->space;
+            store(lot, space, std::move(call), false);
+        }
+    }
+    else if (type == "UnParkedCall" || type == "ParkedCallTimeOut" || type == "ParkedCallGiveUp") {
+        auto const lot = event.get_value("Parkinglot");
+        auto const space = event.get_value("ParkingSpace");
+        if (lot && space) {
+            store(lot.value(), space.value(), nullptr, false);
+        }
+    }
+}
+
+void ParkingTracker::load(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    if (type == "Parkinglot") {
+        auto lot = std::make_shared<Lot const>(Lot{
+            .name = event.get_value("Name").value_or(std::string()),
+            .start_space = event.get_value("StartSpace").value_or(std::string()),
+            .stop_space = event.get_value("StopSpace").value_or(std::string()),
+            .timeout = event.get_value("Timeout").value_or(std::string()) });
+
+        std::unique_lock const lock(mutex_);
+        lots_[lot->name] = std::move(lot);
+    }
+    else if (type == "ParkedCall") {
+        auto call = to_parked_call(event);
+        if (!call->lot.empty() && !call->space.empty()) {
+            auto const lot = call->lot;
+            auto const space = call->space;
+            store(lot, space, std::move(call), true);
+        }
+    }
+}
+
+ParkingTracker::parked_call_ptr_t ParkingTracker::find(std::string const &lot, std::string const &space) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = slots_.find(slot_key(lot, space)); it != slots_.end()) {
+        return it->second.call;
+    }
+    return nullptr;
+}
+
+ParkingTracker::lot_ptr_t ParkingTracker::find_lot(std::string const &lot) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = lots_.find(lot); it != lots_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::vector<ParkingTracker::parked_call_ptr_t> ParkingTracker::parked_calls(std::string const &lot) const
+{
+    std::vector<parked_call_ptr_t> calls;
+
+    std::shared_lock const lock(mutex_);
+    for (auto const &[_, slot] : slots_) {
+        if (lot.empty() || slot.call->lot == lot) {
+            calls.push_back(slot.call);
+        }
+    }
+    return calls;
+}
+
+std::vector<ParkingTracker::lot_ptr_t> ParkingTracker::lots() const
+{
+    std::vector<lot_ptr_t> lots;
+
+    std::shared_lock const lock(mutex_);
+    lots.reserve(lots_.size());
+    for (auto const &[_, lot] : lots_) {
+        lots.push_back(lot);
+    }
+    return lots;
+}
+
+ParkingTracker::subscription_t ParkingTracker::subscribe(listener_t listener)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    auto const id = ++next_subscription_;
+    listeners_.emplace(id, std::move(listener));
+    return id;
+}
+
+void ParkingTracker::unsubscribe(subscription_t id)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    listeners_.erase(id);
+}
+
+void ParkingTracker::store(std::string const &lot, std::string const &space, parked_call_ptr_t call, bool listed)
+{
+    auto const key = slot_key(lot, space);
+    {
+        std::unique_lock const lock(mutex_);
+        if (!listed) {
+            report(key);
+        }
+        else if (!list(key)) {
+            return;
+        }
+
+        if (call) {
+            slots_.insert_or_assign(key, Slot{ .call = call, .epoch = epoch_ });
+        }
+        else if (slots_.erase(key) == 0) {
+            return;
+        }
+    }
+
+    notify(lot, space, call);
+}
+
+void ParkingTracker::notify(std::string const &lot, std::string const &space, parked_call_ptr_t const &call)
+{
+    std::vector<listener_t> listeners;
+    {
+        std::unique_lock const lock(listeners_mutex_);
+        listeners.reserve(listeners_.size());
+        for (auto const &[_, listener] : listeners_) {
+            listeners.push_back(listener);
+        }
+    }
+
+    for (auto const &listener : listeners) {
+        listener(lot, space, call);
+    }
+}
+
+ParkingTracker::parked_call_ptr_t ParkingTracker::to_parked_call(util::KeyValDict const &event)
+{
+    return std::make_shared<ParkedCall const>(ParkedCall{
+        .lot = event.get_value("Parkinglot").value_or(std::string()),
+        .space = event.get_value("ParkingSpace").value_or(std::string()),
+        .channel = event.get_value("ParkeeChannel").value_or(std::string()),
+        .uniqueid = event.get_value("ParkeeUniqueid").value_or(std::string()),
+        .caller_id_num = event.get_value("ParkeeCallerIDNum").value_or(std::string()),
+        .caller_id_name = event.get_value("ParkeeCallerIDName").value_or(std::string()),
+        .parker_dial_string = event.get_value("ParkerDialString").value_or(std::string()),
+        .timeout = event.get_value("ParkingTimeout").value_or(std::string()) });
+}
+
+std::string ParkingTracker::slot_key(std::string const &lot, std::string const &space)
+{
+    return lot + '\n' + space;
+}
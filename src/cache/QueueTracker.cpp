@@ -0,0 +1,406 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/QueueTracker.hpp"
+
+#include "c++ami/action/QueueStatus.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <utility>
+
+using namespace cpp_ami::cache;
+
+namespace {
+
+/// Event fields describing a queue member and the members they are stored in. QueueMember list items name the member
+/// Name, member events MemberName; older QueueMemberPause events report the pause reason as Reason.
+std::array<std::pair<char const *, std::string QueueTracker::Member::*>, 11> const MEMBER_FIELDS{ {
+    { "Name", &QueueTracker::Member::name },
+    { "MemberName", &QueueTracker::Member::name },
+    { "StateInterface", &QueueTracker::Member::state_interface },
+    { "Membership", &QueueTracker::Member::membership },
+    { "Penalty", &QueueTracker::Member::penalty },
+    { "Status", &QueueTracker::Member::status },
+    { "Paused", &QueueTracker::Member::paused },
+    { "PausedReason", &QueueTracker::Member::paused_reason },
+    { "Reason", &QueueTracker::Member::paused_reason },
+    { "InCall", &QueueTracker::Member::in_call },
+    { "LastCall", &QueueTracker::Member::last_call },
+} };
+
+/// @brief Returns the integer value of \c value, or 0 if \c value is missing or not a number.
+int to_int(std::optional<std::string> const &value)
+{
+    int result{ 0 };
+    if (value) {
+        std::from_chars(value->data(), value->data() + value->size(), result);
+    }
+    return result;
+}
+
+/// @brief Returns the interface of the member described by \c event. QueueMember list items report it as Location.
+std::optional<std::string> to_interface(cpp_ami::util::KeyValDict const &event)
+{
+    if (auto interface = event.get_value("Interface")) {
+        return interface;
+    }
+    return event.get_value("Location");
+}
+
+/// @brief Returns \c average with \c sample folded in, weighting the previous average 3:1 the way Asterisk does.
+int fold(int average, int sample)
+{
+    return (average * 3 + sample) / 4;
+}
+
+}
+
+QueueTracker::QueueTracker()
+    : AttachedTracker("QueueTracker")
+{
+}
+
+QueueTracker::QueueTracker(Connection &connection, std::chrono::milliseconds const &timeout)
+    : QueueTracker()
+{
+    attach(connection, timeout);
+}
+
+QueueTracker::~QueueTracker()
+{
+    detach();
+}
+
+void QueueTracker::synchronize(std::chrono::milliseconds const &timeout)
+{
+    fetch(action::QueueStatus(), timeout);
+
+    // Drop whatever went away without this tracker seeing it leave
+    std::vector<std::pair<std::string, queue_ptr_t>> changes;
+    {
+        std::unique_lock const lock(mutex_);
+        for (auto it = queues_.begin(); it != queues_.end(); ) {
+            auto const &name = it->first;
+            if (!seen(entry_key(name, 'q'))) {
+                changes.emplace_back(name, nullptr);
+                it = queues_.erase(it);
+                continue;
+            }
+
+            auto queue = std::make_shared<Queue>(*it->second);
+            auto const members = std::erase_if(queue->members, [&](auto const &member) -> bool {
+                return !seen(entry_key(name, 'm', member.first));
+            });
+            auto const callers = std::erase_if(queue->callers, [&](Caller const &caller) -> bool {
+                return !seen(entry_key(name, 'c', caller.uniqueid));
+            });
+            if (members || callers) {
+                for (size_t i = 0; i < queue->callers.size(); ++i) {
+                    queue->callers[i].position = static_cast<int>(i + 1);
+                }
+                it->second = queue;
+                changes.emplace_back(name, std::move(queue));
+            }
+            ++it;
+        }
+    }
+    for (auto const &[name, queue] : changes) {
+        notify(name, queue);
+    }
+}
+
+void QueueTracker::apply(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    auto const queue = event.get_value("Queue");
+    if (!type || !queue) {
+        return;
+    }
+    auto const &name = queue.value();
+
+    if (type == "QueueMemberStatus" || type == "QueueMemberAdded" || type == "QueueMemberPause" ||
+        type == "QueueMemberRemoved") {
+        auto const interface = to_interface(event);
+        if (!interface) {
+            return;
+        }
+
+        auto const removed = type == "QueueMemberRemoved";
+        modify(name, [&](Queue &q) -> bool {
+            report(entry_key(name, 'q'));
+            report(entry_key(name, 'm', interface.value()));
+            if (removed) {
+                return q.members.erase(interface.value()) > 0;
+            }
+
+            // Member events carry the full member state; fields missing from older events keep their value
+            auto &member = q.members[interface.value()];
+            member.interface = interface.value();
+            update(member, event);
+            return true;
+        });
+    }
+    else if (type == "QueueCallerJoin" || type == "QueueCallerLeave" || type == "QueueCallerAbandon") {
+        auto const uniqueid = event.get_value("Uniqueid");
+        if (!uniqueid) {
+            return;
+        }
+
+        modify(name, [&](Queue &q) -> bool {
+            report(entry_key(name, 'q'));
+            report(entry_key(name, 'c', uniqueid.value()));
+            if (type == "QueueCallerJoin") {
+                place_caller(q, event, std::chrono::steady_clock::now());
+                return true;
+            }
+
+            // Asterisk follows QueueCallerAbandon with a QueueCallerLeave; whichever comes first removes the caller
+            auto const changed = remove_caller(q, uniqueid.value());
+            if (type == "QueueCallerAbandon") {
+                report(entry_key(name, 'p'));
+                ++q.abandoned;
+                return true;
+            }
+            return changed;
+        });
+    }
+    else if (type == "AgentConnect" || type == "AgentComplete") {
+        modify(name, [&](Queue &q) -> bool {
+            report(entry_key(name, 'q'));
+            report(entry_key(name, 'p'));
+            if (type == "AgentConnect") {
+                q.hold_time = fold(q.hold_time, to_int(event.get_value("HoldTime")));
+            }
+            else {
+                ++q.completed;
+                q.talk_time = fold(q.talk_time, to_int(event.get_value("TalkTime")));
+            }
+            return true;
+        });
+    }
+}
+
+void QueueTracker::load(util::KeyValDict const &event)
+{
+    auto const type = event.get_value("Event");
+    auto const queue = event.get_value("Queue");
+    if (!type || !queue) {
+        return;
+    }
+    auto const &name = queue.value();
+
+    if (type == "QueueParams") {
+        modify(name, [&](Queue &q) -> bool {
+            list(entry_key(name, 'q'));
+            if (!list(entry_key(name, 'p'))) {
+                return false;
+            }
+
+            q.strategy = event.get_value("Strategy").value_or(std::string());
+            q.max = event.get_value("Max").value_or(std::string());
+            q.service_level = event.get_value("ServiceLevel").value_or(std::string());
+            q.service_level_perf = event.get_value("ServicelevelPerf").value_or(std::string());
+            q.weight = event.get_value("Weight").value_or(std::string());
+            q.hold_time = to_int(event.get_value("Holdtime"));
+            q.talk_time = to_int(event.get_value("TalkTime"));
+            q.completed = to_int(event.get_value("Completed"));
+            q.abandoned = to_int(event.get_value("Abandoned"));
+            return true;
+        });
+    }
+    else if (type == "QueueMember") {
+        auto const interface = to_interface(event);
+        if (!interface) {
+            return;
+        }
+
+        modify(name, [&](Queue &q) -> bool {
+            list(entry_key(name, 'q'));
+            if (!list(entry_key(name, 'm', interface.value()))) {
+                return false;
+            }
+
+            Member member;
+            member.interface = interface.value();
+            update(member, event);
+            q.members.insert_or_assign(interface.value(), std::move(member));
+            return true;
+        });
+    }
+    else if (type == "QueueEntry") {
+        auto const uniqueid = event.get_value("Uniqueid");
+        if (!uniqueid) {
+            return;
+        }
+
+        modify(name, [&](Queue &q) -> bool {
+            list(entry_key(name, 'q'));
+            if (!list(entry_key(name, 'c', uniqueid.value()))) {
+                return false;
+            }
+
+            auto const wait = std::chrono::seconds(to_int(event.get_value("Wait")));
+            place_caller(q, event, std::chrono::steady_clock::now() - wait);
+            return true;
+        });
+    }
+}
+
+QueueTracker::queue_ptr_t QueueTracker::find(std::string const &queue) const
+{
+    std::shared_lock const lock(mutex_);
+    if (auto const it = queues_.find(queue); it != queues_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::vector<QueueTracker::queue_ptr_t> QueueTracker::snapshot() const
+{
+    std::vector<queue_ptr_t> queues;
+
+    std::shared_lock const lock(mutex_);
+    queues.reserve(queues_.size());
+    for (auto const &[_, queue] : queues_) {
+        queues.push_back(queue);
+    }
+    return queues;
+}
+
+std::optional<QueueTracker::Summary> QueueTracker::summarize(std::string const &queue) const
+{
+    auto const snapshot = find(queue);
+    if (!snapshot) {
+        return std::nullopt;
+    }
+
+    Summary summary{
+        .queue = snapshot->name,
+        .callers = static_cast<int>(snapshot->callers.size()),
+        .hold_time = snapshot->hold_time,
+        .talk_time = snapshot->talk_time };
+
+    // Same rules as app_queue: unavailable (5) and invalid (4) members aren't logged in; idle (1) and unknown (0)
+    // members that aren't paused are available
+    for (auto const &[_, member] : snapshot->members) {
+        if (member.status == "4" || member.status == "5") {
+            continue;
+        }
+        ++summary.logged_in;
+        if ((member.status == "0" || member.status == "1") && member.paused != "1") {
+            ++summary.available;
+        }
+    }
+
+    if (!snapshot->callers.empty()) {
+        auto const longest = std::min_element(snapshot->callers.begin(), snapshot->callers.end(),
+            [](Caller const &left, Caller const &right) -> bool { return left.joined < right.joined; });
+        summary.longest_hold_time = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - longest->joined);
+    }
+    return summary;
+}
+
+QueueTracker::subscription_t QueueTracker::subscribe(listener_t listener)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    auto const id = ++next_subscription_;
+    listeners_.emplace(id, std::move(listener));
+    return id;
+}
+
+void QueueTracker::unsubscribe(subscription_t id)
+{
+    std::unique_lock const lock(listeners_mutex_);
+    listeners_.erase(id);
+}
+
+void QueueTracker::modify(std::string const &queue, std::function<bool(Queue &)> const &change)
+{
+    queue_ptr_t snapshot;
+    {
+        std::unique_lock const lock(mutex_);
+
+        // Copy-on-write; readers holding the previous snapshot keep seeing a consistent queue
+        auto const it = queues_.find(queue);
+        auto copy = it != queues_.end() ? std::make_shared<Queue>(*it->second) : std::make_shared<Queue>();
+        copy->name = queue;
+        if (!change(*copy)) {
+            return;
+        }
+        queues_.insert_or_assign(queue, copy);
+        snapshot = std::move(copy);
+    }
+
+    notify(queue, snapshot);
+}
+
+void QueueTracker::notify(std::string const &queue, queue_ptr_t const &snapshot)
+{
+    std::vector<listener_t> listeners;
+    {
+        std::unique_lock const lock(listeners_mutex_);
+        listeners.reserve(listeners_.size());
+        for (auto const &[_, listener] : listeners_) {
+            listeners.push_back(listener);
+        }
+    }
+
+    for (auto const &listener : listeners) {
+        listener(queue, snapshot);
+    }
+}
+
+std::string QueueTracker::entry_key(std::string const &queue, char kind, std::string const &id)
+{
+    return queue + '\n' + kind + id;
+}
+
+void QueueTracker::place_caller(Queue &queue, util::KeyValDict const &event,
+    std::chrono::steady_clock::time_point joined)
+{
+    Caller caller{
+        .channel = event.get_value("Channel").value_or(std::string()),
+        .uniqueid = event.get_value("Uniqueid").value_or(std::string()),
+        .caller_id_num = event.get_value("CallerIDNum").value_or(std::string()),
+        .caller_id_name = event.get_value("CallerIDName").value_or(std::string()),
+        .joined = joined };
+    remove_caller(queue, caller.uniqueid);
+
+    // Callers with a higher priority join ahead of the callers already waiting
+    auto const index = std::clamp<size_t>(static_cast<size_t>(std::max(to_int(event.get_value("Position")), 1)) - 1,
+        0, queue.callers.size());
+    queue.callers.insert(queue.callers.begin() + static_cast<std::ptrdiff_t>(index), std::move(caller));
+    for (size_t i = index; i < queue.callers.size(); ++i) {
+        queue.callers[i].position = static_cast<int>(i + 1);
+    }
+}
+
+bool QueueTracker::remove_caller(Queue &queue, std::string const &uniqueid)
+{
+    auto const it = std::find_if(queue.callers.begin(), queue.callers.end(),
+        [&uniqueid](Caller const &caller) -> bool { return caller.uniqueid == uniqueid; });
+    if (it == queue.callers.end()) {
+        return false;
+    }
+
+    auto const index = static_cast<size_t>(it - queue.callers.begin());
+    queue.callers.erase(it);
+    for (size_t i = index; i < queue.callers.size(); ++i) {
+        queue.callers[i].position = static_cast<int>(i + 1);
+    }
+    return true;
+}
+
+void QueueTracker::update(Member &member, util::KeyValDict const &event)
+{
+    for (auto const &[key, field] : MEMBER_FIELDS) {
+        if (auto value = event.get_value(key)) {
+            member.*field = std::move(value.value());
+        }
+    }
+    if (auto const calls_taken = event.get_value("CallsTaken")) {
+        member.calls_taken = to_int(calls_taken);
+    }
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/cache/ReactionCache.hpp"
+
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami::cache;
+
+ReactionCache::ReactionCache(invoke_t invoke)
+    : invoke_(std::move(invoke))
+{
+    assert(invoke_);
+}
+
+ReactionCache::ReactionCache(Connection &connection, std::chrono::milliseconds const &timeout)
+    : invoke_([&connection, timeout](action::Action const &action) -> EventDispatcher::reaction_ptr_t {
+        return connection.invoke(action, timeout);
+    })
+{
+}
+
+void ReactionCache::set_ttl(std::string const &action, std::chrono::milliseconds const &ttl)
+{
+    std::unique_lock const lock(mutex_);
+    ttls_.insert_or_assign(normalize(action), ttl);
+}
+
+void ReactionCache::clear_ttl(std::string const &action)
+{
+    {
+        std::unique_lock const lock(mutex_);
+        ttls_.erase(normalize(action));
+    }
+    invalidate(action);
+}
+
+ReactionCache::reaction_ptr_t ReactionCache::invoke(action::Action const &action)
+{
+    auto const key = cache_key(action);
+
+    std::promise<reaction_ptr_t> promise;
+    std::shared_future<reaction_ptr_t> result;
+    std::optional<std::chrono::milliseconds> ttl;
+    {
+        std::unique_lock const lock(mutex_);
+        auto const ttl_it = ttls_.find(normalize(action.get_action()));
+        if (ttl_it == ttls_.end()) {
+            ++metrics_.bypassed;
+        }
+        else {
+            ttl = ttl_it->second;
+
+            auto const now = clock_t::now();
+            if (auto const it = entries_.find(key); it != entries_.end()) {
+                if (it->second.expires > now) {
+                    ++metrics_.hits;
+                    return it->second.reaction;
+                }
+                erase(it);
+            }
+
+            // Someone is already invoking an identical action; wait for their reaction rather than invoking it again
+            if (auto const it = inflight_.find(key); it != inflight_.end()) {
+                ++metrics_.coalesced;
+                result = it->second.result;
+            }
+            else {
+                ++metrics_.misses;
+                inflight_.emplace(key, Inflight{ .result = promise.get_future().share() });
+            }
+        }
+    }
+
+    if (result.valid()) {
+        return result.get();
+    }
+    if (!ttl) {
+        return invoke_(action);
+    }
+
+    reaction_ptr_t reaction;
+    std::exception_ptr err;
+    try {
+        reaction = invoke_(action);
+    }
+    catch (...) {
+        err = std::current_exception();
+    }
+
+    {
+        std::unique_lock const lock(mutex_);
+        if (auto const it = inflight_.find(key); it != inflight_.end()) {
+            auto const cacheable = reaction && reaction->is_success() && !it->second.stale;
+            if (cacheable && ttl.value() > std::chrono::milliseconds::zero()) {
+                auto const now = clock_t::now();
+                // Expired reactions of keys that aren't looked up again would otherwise stay around forever
+                sweep(now);
+                if (auto const e_it = entries_.find(key); e_it != entries_.end()) {
+                    erase(e_it);
+                }
+                auto const expires = now + ttl.value();
+                entries_.emplace(key, Entry{ .reaction = reaction, .expires = expires,
+                    .timer = expiry_.arm(key, expires) });
+            }
+            inflight_.erase(it);
+        }
+    }
+
+    if (err) {
+        promise.set_exception(err);
+        std::rethrow_exception(err);
+    }
+    promise.set_value(reaction);
+    return reaction;
+}
+
+void ReactionCache::invalidate(std::string const &action)
+{
+    std::unique_lock const lock(mutex_);
+    if (action.empty()) {
+        while (!entries_.empty()) {
+            erase(entries_.begin());
+        }
+        for (auto &[_, inflight] : inflight_) {
+            inflight.stale = true;
+        }
+        return;
+    }
+
+    // Cache keys start with the action name followed by a line break
+    auto const prefix = normalize(action) + '\n';
+    for (auto it = entries_.begin(); it != entries_.end(); ) {
+        if (it->first.starts_with(prefix)) {
+            erase(it++);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (auto &[key, inflight] : inflight_) {
+        if (key.starts_with(prefix)) {
+            inflight.stale = true;
+        }
+    }
+}
+
+ReactionCache::Metrics ReactionCache::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+    auto metrics = metrics_;
+    metrics.entries = entries_.size();
+    return metrics;
+}
+
+std::string ReactionCache::cache_key(action::Action const &action)
+{
+    // Header names are case-insensitive and their order doesn't matter to the AMI server; headers that aren't set
+    // aren't sent
+    std::vector<std::pair<std::string, std::string>> headers;
+    for (auto const &key : action.get_keys()) {
+        if (auto value = action.get_value(key)) {
+            headers.emplace_back(normalize(key), std::move(value.value()));
+        }
+    }
+    std::sort(headers.begin(), headers.end());
+
+    auto cache_key = normalize(action.get_action());
+    cache_key += '\n';
+    for (auto const &[key, value] : headers) {
+        cache_key += key;
+        cache_key += ':';
+        cache_key += value;
+        cache_key += '\n';
+    }
+    return cache_key;
+}
+
+void ReactionCache::sweep(clock_t::time_point now)
+{
+    // Only the reactions that expired since the last sweep are visited rather than every cached reaction
+    for (auto const &key : expiry_.advance(now)) {
+        entries_.erase(key);
+    }
+}
+
+void ReactionCache::erase(std::unordered_map<std::string, Entry>::iterator it)
+{
+    expiry_.cancel(it->second.timer);
+    entries_.erase(it);
+}
+
+std::string ReactionCache::normalize(std::string const &name)
+{
+    std::string normalized(name);
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+        [](unsigned char c) -> char { return static_cast<char>(std::tolower(c)); });
+    return normalized;
+}
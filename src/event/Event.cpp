@@ -9,3 +9,8 @@ Event::Event(KeyValDict dict) noexcept
     : KeyValDict(std::move(dict))
 {
 }
+
+void Event::reset(std::string event_buf)
+{
+    set_message(std::move(event_buf));
+}
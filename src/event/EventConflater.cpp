@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/event/EventConflater.hpp"
+
+#include <utility>
+
+using namespace cpp_ami::event;
+
+void EventConflater::configure(std::unordered_set<std::string> event_types, std::chrono::milliseconds window)
+{
+    std::unique_lock const lock(mutex_);
+    event_types_ = std::move(event_types);
+
+    // Deadlines are derived from the window, so held back events are released according to the new one
+    window_ = window;
+}
+
+void EventConflater::process(std::vector<event_ptr_t> &batch, clock_t::time_point now)
+{
+    std::unique_lock const lock(mutex_);
+    if (event_types_.empty() && held_.empty()) {
+        return;
+    }
+
+    scratch_.clear();
+    for (auto &event : batch) {
+        auto const uniqueid = event->get_value("Uniqueid");
+        if (!uniqueid) {
+            scratch_.push_back(std::move(event));
+            continue;
+        }
+
+        if (auto const type = event->get_value("Event"); type && event_types_.contains(type.value())) {
+            ++metrics_.conflatable;
+
+            // Newer state for a held back event; it now follows whatever else was held for the channel meanwhile
+            auto key = type.value() + '\n' + uniqueid.value();
+            if (auto const it = index_.find(key); it != index_.end()) {
+                held_.splice(held_.end(), held_, it->second);
+                it->second->event = std::move(event);
+                ++metrics_.conflated;
+                continue;
+            }
+
+            held_.push_back(Held{ .key = key, .uniqueid = uniqueid.value(), .event = std::move(event) });
+            index_.emplace(std::move(key), std::prev(held_.end()));
+
+            // The channel's deadline runs from the first event held for it, however often that is replaced
+            auto channel = channel_index_.find(uniqueid.value());
+            if (channel == channel_index_.end()) {
+                channels_.push_back(Channel{ .uniqueid = uniqueid.value(), .since = now, .held = 0 });
+                channel = channel_index_.emplace(uniqueid.value(), std::prev(channels_.end())).first;
+            }
+            ++channel->second->held;
+            continue;
+        }
+
+        // Event can't be conflated; anything held back for the same channel has to go out first
+        if (channel_index_.contains(uniqueid.value())) {
+            release_channel(uniqueid.value(), scratch_);
+        }
+        scratch_.push_back(std::move(event));
+    }
+
+    if (event_types_.empty()) {
+        while (!held_.empty()) {
+            release(held_.begin(), scratch_);
+        }
+    }
+    while (!channels_.empty() && channels_.front().since + window_ <= now) {
+        auto const uniqueid = channels_.front().uniqueid;
+        release_channel(uniqueid, scratch_);
+    }
+
+    std::swap(batch, scratch_);
+    scratch_.clear();
+}
+
+void EventConflater::flush(std::vector<event_ptr_t> &batch)
+{
+    std::unique_lock const lock(mutex_);
+    while (!held_.empty()) {
+        release(held_.begin(), batch);
+    }
+}
+
+std::optional<EventConflater::clock_t::time_point> EventConflater::next_deadline() const
+{
+    std::unique_lock const lock(mutex_);
+    if (held_.empty()) {
+        return std::nullopt;
+    }
+
+    // Conflation was disabled; whatever is held back goes out with the next batch
+    if (event_types_.empty()) {
+        return clock_t::time_point::min();
+    }
+    return channels_.front().since + window_;
+}
+
+EventConflater::Metrics EventConflater::get_metrics() const
+{
+    std::unique_lock const lock(mutex_);
+
+    auto metrics = metrics_;
+    metrics.held = held_.size();
+    return metrics;
+}
+
+void EventConflater::release(held_t::iterator it, std::vector<event_ptr_t> &batch)
+{
+    batch.push_back(std::move(it->event));
+    index_.erase(it->key);
+    auto const c_it = channel_index_.find(it->uniqueid);
+    if (c_it != channel_index_.end() && --c_it->second->held == 0) {
+        channels_.erase(c_it->second);
+        channel_index_.erase(c_it);
+    }
+    held_.erase(it);
+}
+
+void EventConflater::release_channel(std::string const &uniqueid, std::vector<event_ptr_t> &batch)
+{
+    for (auto it = held_.begin(); it != held_.end() && channel_index_.contains(uniqueid); ) {
+        auto const next = std::next(it);
+        if (it->uniqueid == uniqueid) {
+            release(it, batch);
+        }
+        it = next;
+    }
+}
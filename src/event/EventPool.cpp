@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/event/EventPool.hpp"
+
+#include <utility>
+
+using namespace cpp_ami::event;
+
+void EventPool::Deleter::operator()(Event const *event) const
+{
+    // Pooled events are always allocated as mutable Event objects by the pool
+    auto *const pooled = const_cast<Event *>(event);
+    if (pool) {
+        pool->release(pooled);
+    }
+    else {
+        delete pooled;
+    }
+}
+
+EventPool::EventPool(size_t capacity)
+    : capacity_(capacity)
+{
+    idle_.reserve(capacity_);
+}
+
+EventPool::~EventPool()
+{
+    std::unique_lock const lock(mutex_);
+    for (auto *const event : idle_) {
+        delete event;
+    }
+    idle_.clear();
+}
+
+EventPool::ptr_t EventPool::acquire(std::string event_buf)
+{
+    Event *event{ nullptr };
+    {
+        std::unique_lock const lock(mutex_);
+        if (!idle_.empty()) {
+            event = idle_.back();
+            idle_.pop_back();
+        }
+    }
+
+    // Pool is dry; allocate a new event
+    if (!event) {
+        return ptr_t(new Event(util::KeyValDict(std::move(event_buf))), Deleter{ this });
+    }
+
+    event->reset(std::move(event_buf));
+    return ptr_t(event, Deleter{ this });
+}
+
+size_t EventPool::idle_count() const
+{
+    std::unique_lock const lock(mutex_);
+    return idle_.size();
+}
+
+void EventPool::release(Event *event)
+{
+    {
+        std::unique_lock const lock(mutex_);
+        if (idle_.size() < capacity_) {
+            idle_.push_back(event);
+            return;
+        }
+    }
+
+    delete event;
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/net/SocketPoller.hpp"
+
+#include "c++ami/net/TcpSocket.hpp"
+#include <cassert>
+#include <fmt/core.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdexcept>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace cpp_ami::net;
+
+SocketPoller::SocketPoller()
+    : wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (wake_fd_ == -1) {
+        throw std::runtime_error(fmt::format("Error opening eventfd: {}", strerror(errno)));
+    }
+
+    thread_spin_ = true;
+    thread_ = std::thread(&SocketPoller::work_thread, this);
+    pthread_setname_np(thread_.native_handle(), "ami_poller");
+}
+
+SocketPoller::~SocketPoller()
+{
+    thread_spin_ = false;
+    interrupt();
+
+    assert(thread_.joinable());
+    thread_.join();
+
+    ::close(wake_fd_);
+}
+
+void SocketPoller::add(socket_ptr_t socket, handler_t callback, closed_handler_t closed)
+{
+    assert(socket);
+    {
+        std::unique_lock lock(mutex_);
+        if (failed_) {
+            // The poller thread is gone and would never read the socket
+            lock.unlock();
+            if (closed) {
+                closed();
+            }
+            return;
+        }
+        auto const fd = socket->native_handle();
+        sockets_.insert_or_assign(fd,
+            Entry{ .socket = std::move(socket), .callback = std::move(callback), .closed = std::move(closed) });
+        ++generation_;
+    }
+    interrupt();
+}
+
+void SocketPoller::remove(socket_t const &socket)
+{
+    std::unique_lock lock(mutex_);
+    if (sockets_.erase(socket.native_handle()) == 0) {
+        return;
+    }
+    auto const generation = ++generation_;
+    interrupt();
+
+    // The poller thread only invokes callbacks of the sockets it is waiting on; once it waits on the new generation the
+    // socket's callbacks have returned
+    if (std::this_thread::get_id() != thread_.get_id()) {
+        serviced_cv_.wait(lock, [this, generation]() -> bool {
+            return serviced_ >= generation || !thread_spin_ || failed_;
+        });
+    }
+}
+
+size_t SocketPoller::size() const
+{
+    std::unique_lock const lock(mutex_);
+    return sockets_.size();
+}
+
+void SocketPoller::interrupt() const
+{
+    uint64_t const one = 1;
+    [[maybe_unused]] auto const ret = ::write(wake_fd_, &one, sizeof(one));
+}
+
+void SocketPoller::work_thread()
+{
+    std::vector<pollfd> fds;
+    std::vector<Entry> entries;
+    uint64_t generation = 0;
+
+    while (thread_spin_) {
+        // Rebuild the poll set only when sockets were added or removed
+        {
+            std::unique_lock const lock(mutex_);
+            if (fds.empty() || generation != generation_) {
+                generation = generation_;
+                fds.assign(1, pollfd{ .fd = wake_fd_, .events = POLLIN, .revents = 0 });
+                entries.clear();
+                for (auto const &[fd, entry] : sockets_) {
+                    fds.push_back(pollfd{ .fd = fd, .events = POLLIN, .revents = 0 });
+                    entries.push_back(entry);
+                }
+            }
+            serviced_ = generation;
+            serviced_cv_.notify_all();
+        }
+
+        if (poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Nothing can be read anymore; tell the owners of the sockets as if their peers closed them
+            abandon();
+            break;
+        }
+
+        if (fds[0].revents != 0) {
+            uint64_t count = 0;
+            [[maybe_unused]] auto const ret = ::read(wake_fd_, &count, sizeof(count));
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+
+            auto &entry = entries[i - 1];
+            std::string buf;
+            try {
+                buf = entry.socket->read(65535, TcpSocket::timeout_t::zero());
+            }
+            catch (std::exception const &) {
+                // Treated the same as the peer closing the socket
+            }
+
+            if (!buf.empty()) {
+                entry.callback(std::move(buf));
+                continue;
+            }
+
+            // Readable without data; the peer closed the socket. Stop reading it before telling anyone so that the
+            // closed callback may remove it again
+            {
+                std::unique_lock const lock(mutex_);
+                auto const it = sockets_.find(fds[i].fd);
+                if (it == sockets_.end() || it->second.socket != entry.socket) {
+                    continue;
+                }
+                sockets_.erase(it);
+                ++generation_;
+            }
+            fds[i].fd = -1;
+            if (entry.closed) {
+                entry.closed();
+            }
+        }
+    }
+
+    std::unique_lock const lock(mutex_);
+    serviced_cv_.notify_all();
+}
+
+void SocketPoller::abandon()
+{
+    decltype(sockets_) sockets;
+    {
+        std::unique_lock const lock(mutex_);
+        failed_ = true;
+        std::swap(sockets_, sockets);
+        ++generation_;
+    }
+
+    for (auto const &[_, entry] : sockets) {
+        if (entry.closed) {
+            entry.closed();
+        }
+    }
+}
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <utility>
 
 using namespace cpp_ami::net;
 
@@ -153,3 +154,8 @@ void TcpSocket::write(std::string_view data)
         throw std::runtime_error(fmt::format("Error writing socket: {}", strerror(errno)));
     }
 }
+
+int TcpSocket::native_handle() const
+{
+    return sock_fd_;
+}
@@ -43,6 +43,12 @@ bool EventList::is_list_complete(std::string const &event_list_val)
     return event_list_val == "Complete" || event_list_val == "cancelled";
 }
 
+bool EventList::is_list_complete(util::KeyValDict const &dict)
+{
+    auto const val = dict.get_value("EventList");
+    return val && is_list_complete(*val);
+}
+
 bool EventList::add_event(event::Event event)
 {
     if (auto const val = event.get_value("EventList"); val && is_list_complete(*val)) {
@@ -81,3 +87,13 @@ cpp_ami::event::Event const& EventList::get_event(size_t event_idx) const
     assert(event_idx < events_.size());
     return events_[event_idx];
 }
+
+cpp_ami::event::Event const& EventList::get_head() const
+{
+    return head_;
+}
+
+cpp_ami::event::Event const* EventList::get_tail() const
+{
+    return tail_.get();
+}
@@ -7,5 +7,6 @@ using namespace cpp_ami::reaction;
 
 bool Reaction::is_success(std::string const &status)
 {
-    return status == "Success" || status == "Goodbye";
+    // Command responses of older AMI servers report their output as following rather than as a success
+    return status == "Success" || status == "Goodbye" || status == "Follows";
 }
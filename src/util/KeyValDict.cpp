@@ -8,10 +8,18 @@
 #include <cassert>
 #include <fmt/core.h>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 
 using namespace cpp_ami::util;
 
+KeyValDict::KeyValDict(KeyValDict const &right)
+    : ordered_keys_(right.ordered_keys_)
+    , values_(right.values_)
+    , lines_(right.lines_)
+{
+}
+
 KeyValDict::KeyValDict(std::string event_buf)
 {
     set_message(std::move(event_buf));
@@ -22,6 +30,19 @@ KeyValDict::KeyValDict(std::vector<std::string> ordered_keys)
 {
 }
 
+KeyValDict &KeyValDict::operator=(KeyValDict const &right)
+{
+    ordered_keys_ = right.ordered_keys_;
+    values_ = right.values_;
+    lines_ = right.lines_;
+    return *this;
+}
+
+std::vector<std::string> const& KeyValDict::get_keys() const
+{
+    return ordered_keys_;
+}
+
 size_t KeyValDict::count() const
 {
     return ordered_keys_.size();
@@ -74,36 +95,130 @@ void KeyValDict::set_message(std::string event_buf)
 {
     assert(!event_buf.empty());
 
-    ordered_keys_.clear();
-    values_.clear();
+    // Keep the nodes of the previous contents around so that they can be reused for the new contents
+    while (!values_.empty()) {
+        spare_.push_back(values_.extract(values_.begin()));
+    }
+    lines_.clear();
 
-    for (size_t key_beg = 0; key_beg < event_buf.length(); ) {
-        auto const key_end = event_buf.find(SEP, key_beg);
-        if (key_end == std::string::npos) {
-            break;
+    size_t key_count = 0;
+    for (size_t line_beg = 0; line_beg < event_buf.length(); ) {
+        auto line_end = event_buf.find(EOR, line_beg);
+        if (line_end == std::string::npos) {
+            line_end = event_buf.length();
+        }
+        std::string_view const line(event_buf.data() + line_beg, line_end - line_beg);
+        line_beg = line_end + EOR.length();
+
+        // Messages are parsed a line at a time; a key with an empty value may be sent without the trailing space and
+        // lines that aren't key/value pairs are skipped
+        auto const sep = line.find(':');
+        if (sep == std::string_view::npos) {
+            continue;
+        }
+        auto const key = line.substr(0, sep);
+        auto val = line.substr(sep + 1);
+        if (val.starts_with(' ')) {
+            val.remove_prefix(1);
         }
 
-        std::string_view key(event_buf.data() + key_beg, key_end - key_beg);
-        // Maintain key order
-        ordered_keys_.emplace_back(key);
-
-        // Calculate value position
-        auto const val_beg = key_end + 2;
-        auto const val_end = event_buf.find(EOR, val_beg);
-        std::string_view val(event_buf.data() + val_beg, val_end - val_beg);
         // Capture key value
-        values_.emplace(key, val);
+        std::pair<values_t::iterator, bool> result;
+        if (spare_.empty()) {
+            result = values_.emplace(key, val);
+        }
+        else {
+            auto node = std::move(spare_.back());
+            spare_.pop_back();
+            node.key().assign(key);
+            node.mapped().assign(val);
+            auto inserted = values_.insert(std::move(node));
+            result = { inserted.position, inserted.inserted };
+            // Hang on to the node of a repeated key for the next key
+            if (!inserted.inserted) {
+                spare_.push_back(std::move(inserted.node));
+            }
+        }
+
+        // Repeated keys (e.g. the Output lines of a Command response) are joined into a single value, one line each;
+        // the order of the lines is kept once a key repeats so that the message is written out the way it was read
+        if (!result.second) {
+            result.first->second += '\n';
+            result.first->second += val;
+            if (lines_.empty()) {
+                for (size_t i = 0; i < key_count; ++i) {
+                    lines_.push_back(i);
+                }
+            }
+            auto const index = std::find(ordered_keys_.begin(), ordered_keys_.begin() + key_count, key);
+            lines_.push_back(static_cast<size_t>(index - ordered_keys_.begin()));
+            continue;
+        }
+        if (!lines_.empty()) {
+            lines_.push_back(key_count);
+        }
 
-        key_beg = val_end + 2;
+        // Maintain key order; reuse the string storage of the previous keys
+        if (key_count < ordered_keys_.size()) {
+            ordered_keys_[key_count].assign(key);
+        }
+        else {
+            ordered_keys_.emplace_back(key);
+        }
+        ++key_count;
     }
+
+    ordered_keys_.resize(key_count);
 }
 
 std::string KeyValDict::to_string() const
 {
+    auto const value_of = [this](std::string const &key) -> std::string_view {
+        auto const it_val = values_.find(key);
+        return it_val != values_.end() ? std::string_view(it_val->second) : std::string_view();
+    };
+
     std::string action_string;
+    auto const append = [&action_string](std::string const &key, std::string_view value) -> void {
+        action_string += fmt::format("{}{}{}{}", key, SEP, value, EOR);
+    };
+
+    // A multi-line value is a repeated key; send it the way it was received, one line at a time
+    auto const append_lines = [&append](std::string const &key, std::string_view value) -> void {
+        for (auto eol = value.find('\n'); eol != std::string_view::npos; eol = value.find('\n')) {
+            append(key, value.substr(0, eol));
+            value.remove_prefix(eol + 1);
+        }
+        append(key, value);
+    };
+
+    if (lines_.empty()) {
+        for (auto const &key : ordered_keys_) {
+            append_lines(key, value_of(key));
+        }
+        return action_string + EOR;
+    }
+
+    // Keys repeated in the message are interleaved with the others the way they were read; each line takes the next
+    // line of the joined value and the last line of a key takes whatever is left
+    std::vector<size_t> remaining(ordered_keys_.size(), 0);
+    for (auto const index : lines_) {
+        ++remaining[index];
+    }
+    std::vector<std::string_view> values;
+    values.reserve(ordered_keys_.size());
     for (auto const &key : ordered_keys_) {
-        auto const it_val = values_.find(key);
-        action_string += fmt::format("{}{}{}{}", key, SEP, it_val != values_.end() ? it_val->second : std::string{""}, EOR);
+        values.push_back(value_of(key));
+    }
+    for (auto const index : lines_) {
+        auto &value = values[index];
+        if (--remaining[index] == 0) {
+            append_lines(ordered_keys_[index], value);
+            continue;
+        }
+        auto const eol = value.find('\n');
+        append(ordered_keys_[index], value.substr(0, eol));
+        value.remove_prefix(eol == std::string_view::npos ? value.length() : eol + 1);
     }
     return action_string + EOR;
 }
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/util/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace cpp_ami::util;
+
+LatencyHistogram::LatencyHistogram(std::chrono::nanoseconds half_life)
+{
+    set_half_life(half_life);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency)
+{
+    age();
+
+    auto const micros = std::chrono::duration_cast<duration_t>(std::max(latency, std::chrono::nanoseconds::zero()));
+    buckets_[bucket(static_cast<uint64_t>(micros.count()))].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::duration_t LatencyHistogram::quantile(double quantile) const
+{
+    auto const total = count();
+    if (total == 0) {
+        return duration_t::zero();
+    }
+
+    // Rank of the latency sought, counting from 1
+    auto const rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return duration_t(upper_bound(i));
+        }
+    }
+
+    // Recorded concurrently with the scan; the largest bucket seen is as good an answer as any
+    for (size_t i = BUCKETS; i > 0; --i) {
+        if (buckets_[i - 1].load(std::memory_order_relaxed) > 0) {
+            return duration_t(upper_bound(i - 1));
+        }
+    }
+    return duration_t::zero();
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::decay()
+{
+    shrink(1);
+}
+
+void LatencyHistogram::set_half_life(std::chrono::nanoseconds half_life)
+{
+    aged_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    half_life_.store(std::max(half_life, std::chrono::nanoseconds::zero()).count(), std::memory_order_relaxed);
+}
+
+void LatencyHistogram::age()
+{
+    auto const half_life = half_life_.load(std::memory_order_relaxed);
+    if (half_life == 0) {
+        return;
+    }
+
+    // Whoever moves the aging time forward does the halving; concurrent recorders carry on
+    auto const now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto aged = aged_.load(std::memory_order_relaxed);
+    if (now - aged < half_life) {
+        return;
+    }
+    auto const halvings = (now - aged) / half_life;
+    if (aged_.compare_exchange_strong(aged, aged + halvings * half_life, std::memory_order_relaxed)) {
+        shrink(static_cast<uint64_t>(halvings));
+    }
+}
+
+void LatencyHistogram::shrink(uint64_t halvings)
+{
+    // Only what was there when the bucket was read is removed, so concurrent increments survive
+    auto const shift = std::min<uint64_t>(halvings, 63);
+    for (auto &bucket : buckets_) {
+        auto const counted = bucket.load(std::memory_order_relaxed);
+        auto const removed = counted - (counted >> shift);
+        if (removed > 0) {
+            bucket.fetch_sub(removed, std::memory_order_relaxed);
+            count_.fetch_sub(removed, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t LatencyHistogram::bucket(uint64_t micros)
+{
+    if (micros < LINEAR_BUCKETS) {
+        return micros;
+    }
+
+    // Power of two the latency falls in, then which of its sub-buckets
+    auto const exponent = static_cast<size_t>(std::bit_width(micros) - 1);
+    auto const sub = (micros >> (exponent - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1);
+    return LINEAR_BUCKETS + (exponent - 4) * (1 << SUB_BUCKET_BITS) + sub;
+}
+
+uint64_t LatencyHistogram::upper_bound(size_t index)
+{
+    if (index < LINEAR_BUCKETS) {
+        return index;
+    }
+
+    auto const exponent = (index - LINEAR_BUCKETS) / (1 << SUB_BUCKET_BITS) + 4;
+    auto const sub = (index - LINEAR_BUCKETS) % (1 << SUB_BUCKET_BITS);
+    auto const width = uint64_t{ 1 } << (exponent - SUB_BUCKET_BITS);
+    return ((uint64_t{ 1 } << SUB_BUCKET_BITS) + sub) * width + (width - 1);
+}
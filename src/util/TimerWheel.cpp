@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/util/TimerWheel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace cpp_ami::util;
+
+TimerWheel::TimerWheel(std::chrono::milliseconds resolution, clock_t::time_point start)
+    : resolution_(resolution)
+    , start_(start)
+{
+    assert(resolution_.count() > 0);
+}
+
+TimerWheel::handle_t TimerWheel::arm(key_t key, clock_t::time_point deadline)
+{
+    // Timers can't expire on a tick that has already been processed; push them to the next tick
+    auto const expiry = std::max(to_tick(deadline), current_tick_ + 1);
+
+    staging_.push_back(Timer{ .key = std::move(key), .expiry = expiry });
+    auto handle = std::prev(staging_.end());
+    place(staging_, handle);
+    ++count_;
+
+    return handle;
+}
+
+void TimerWheel::cancel(handle_t handle)
+{
+    assert(count_ > 0);
+    wheels_[handle->level][handle->slot].erase(handle);
+    --count_;
+}
+
+std::vector<TimerWheel::key_t> TimerWheel::advance(clock_t::time_point now)
+{
+    std::vector<key_t> expired;
+    if (now < start_) {
+        return expired;
+    }
+
+    auto const target_tick = static_cast<uint64_t>((now - start_) / resolution_);
+
+    while (count_ > 0 && current_tick_ < target_tick) {
+        ++current_tick_;
+
+        // Finest wheel wrapped around; pull timers from the coarser wheels down into the finer ones
+        if ((current_tick_ & SLOT_MASK) == 0) {
+            for (size_t level = 1; level < LEVEL_COUNT && cascade(level) == 0; ++level) {
+            }
+        }
+
+        auto &slot = wheels_[0][current_tick_ & SLOT_MASK];
+        for (auto &timer : slot) {
+            expired.push_back(std::move(timer.key));
+        }
+        count_ -= slot.size();
+        slot.clear();
+    }
+
+    // Nothing left to expire; skip over idle ticks rather than stepping through them one at a time
+    current_tick_ = std::max(current_tick_, target_tick);
+
+    return expired;
+}
+
+std::chrono::milliseconds TimerWheel::resolution() const
+{
+    return resolution_;
+}
+
+size_t TimerWheel::size() const
+{
+    return count_;
+}
+
+bool TimerWheel::empty() const
+{
+    return count_ == 0;
+}
+
+uint64_t TimerWheel::to_tick(clock_t::time_point time) const
+{
+    if (time <= start_) {
+        return 0;
+    }
+
+    auto const elapsed = std::chrono::ceil<std::chrono::milliseconds>(time - start_);
+    return static_cast<uint64_t>((elapsed + resolution_ - std::chrono::milliseconds{1}) / resolution_);
+}
+
+void TimerWheel::place(slot_t &from, handle_t handle)
+{
+    auto const delta = handle->expiry > current_tick_ ? handle->expiry - current_tick_ : 0;
+
+    // Find the finest wheel that covers the timer's remaining delta. Timers that are beyond the range of the coarsest
+    // wheel are parked in its furthest slot and get re-placed once that slot is cascaded.
+    size_t level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    auto const max_delta = (uint64_t{1} << (SLOT_BITS * LEVEL_COUNT)) - 1;
+    auto const slot_tick = current_tick_ + std::min(delta, max_delta);
+
+    handle->level = level;
+    handle->slot = (slot_tick >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    auto &to = wheels_[handle->level][handle->slot];
+    to.splice(to.end(), from, handle);
+}
+
+size_t TimerWheel::cascade(size_t level)
+{
+    auto const slot_idx = (current_tick_ >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    staging_.splice(staging_.end(), wheels_[level][slot_idx]);
+    while (!staging_.empty()) {
+        place(staging_, staging_.begin());
+    }
+
+    return slot_idx;
+}
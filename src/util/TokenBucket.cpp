@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include "c++ami/util/TokenBucket.hpp"
+
+#include <algorithm>
+#include <fmt/core.h>
+#include <stdexcept>
+
+using namespace cpp_ami::util;
+
+namespace {
+
+/// @brief Returns the time it takes to add a single token at \c rate tokens per second.
+TokenBucket::clock_t::duration token_interval(double rate, size_t burst)
+{
+    // Also rejects NaN; a rate so low that the interval can't be represented would overflow the conversion
+    auto const seconds = std::chrono::duration<double>(1.0 / rate);
+    if (!(rate > 0) || seconds >= TokenBucket::clock_t::duration::max()) {
+        throw std::invalid_argument(fmt::format("Invalid token bucket rate {}", rate));
+    }
+    if (burst == 0) {
+        throw std::invalid_argument("Token bucket burst must be at least 1");
+    }
+
+    // Never zero; an unbounded rate would otherwise hand out tokens without ever draining the bucket
+    auto const interval = std::chrono::duration_cast<TokenBucket::clock_t::duration>(seconds);
+    return std::max(interval, TokenBucket::clock_t::duration(1));
+}
+
+}
+
+TokenBucket::TokenBucket(double rate, size_t burst, clock_t::time_point now)
+    : interval_(token_interval(rate, burst))
+    , burst_(burst)
+    , full_(now)
+{
+}
+
+bool TokenBucket::try_acquire(clock_t::time_point now)
+{
+    if (wait_time(now) > clock_t::duration::zero()) {
+        return false;
+    }
+
+    // Taking a token pushes the time the bucket is full again back by one interval
+    full_ = std::max(full_, now) + interval_;
+    return true;
+}
+
+TokenBucket::clock_t::duration TokenBucket::wait_time(clock_t::time_point now) const
+{
+    // A token is available once the bucket is missing fewer than burst tokens
+    auto const next = full_ - interval_ * static_cast<clock_t::rep>(burst_ - 1);
+    return std::max(next - now, clock_t::duration::zero());
+}
+
+size_t TokenBucket::available(clock_t::time_point now) const
+{
+    auto const missing = static_cast<size_t>((std::max(full_, now) - now + interval_ - clock_t::duration(1)) /
+        interval_);
+    return burst_ - std::min(missing, burst_);
+}
+
+void TokenBucket::set_rate(double rate, size_t burst, clock_t::time_point now)
+{
+    auto const interval = token_interval(rate, burst);
+
+    // Keep the tokens the bucket holds; the missing ones refill at the new rate
+    auto const held = std::min(available(now), burst);
+    interval_ = interval;
+    burst_ = burst;
+    full_ = now + interval_ * static_cast<clock_t::rep>(burst_ - held);
+}
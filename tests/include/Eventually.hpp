@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef TESTS_EVENTUALLY_HPP
+#define TESTS_EVENTUALLY_HPP
+
+#include <chrono>
+#include <thread>
+
+namespace cpp_ami::test {
+
+/// @brief Waits up to five seconds for \c predicate to hold, e.g. for an event that isn't ordered with a response.
+///
+/// @return \c true if \c predicate held before the deadline.
+///
+/// @param predicate Condition to wait for; checked every ten milliseconds.
+template <typename Predicate>
+bool eventually(Predicate predicate)
+{
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#ifndef TESTS_FAKE_AMI_SERVER_HPP
+#define TESTS_FAKE_AMI_SERVER_HPP
+
+#include "c++ami/CppAmiDefs.h"
+#include "c++ami/util/KeyValDict.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fmt/core.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace cpp_ami::test {
+
+///
+/// @class FakeAmiServer
+///
+/// @brief In-process AMI server listening on an ephemeral loopback port, for tests that need a \c Connection.
+///
+/// Every session is serviced by a thread of its own which sends the banner and hands each request to the handler; the
+/// string returned by the handler is written back as is, so a handler can answer with anything from a plain response
+/// to an EventList, or with nothing at all and answer later through \c send. A handler that blocks only holds up its
+/// own session, as a busy Asterisk would.
+///
+class FakeAmiServer {
+public:
+    using handler_t = std::function<std::string(size_t session, util::KeyValDict const &request)>;
+
+public:
+    FakeAmiServer(FakeAmiServer const &) = delete;
+    FakeAmiServer(FakeAmiServer &&) noexcept = delete;
+
+    /// @brief Starts listening; every request is answered by \c handler.
+    ///
+    /// @param handler Handler producing the reply to a request.
+    explicit FakeAmiServer(handler_t handler = success)
+        : handler_(std::move(handler))
+    {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (listen_fd_ == -1 || bind(listen_fd_, reinterpret_cast<sockaddr const *>(&addr), sizeof(addr)) == -1 ||
+            ::listen(listen_fd_, 64) == -1 ||
+            getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &len) == -1) {
+            throw std::runtime_error("FakeAmiServer: unable to listen");
+        }
+        port_ = ntohs(addr.sin_port);
+        accept_thread_ = std::thread(&FakeAmiServer::accept_thread, this);
+    }
+
+    /// @brief Closes every session and stops listening.
+    virtual ~FakeAmiServer()
+    {
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        accept_thread_.join();
+        ::close(listen_fd_);
+
+        std::vector<std::shared_ptr<Session>> sessions;
+        {
+            std::unique_lock const lock(mutex_);
+            sessions = sessions_;
+        }
+        for (auto const &session : sessions) {
+            ::shutdown(session->fd, SHUT_RDWR);
+            session->thread.join();
+            ::close(session->fd);
+        }
+    }
+
+    FakeAmiServer& operator=(FakeAmiServer const &) = delete;
+    FakeAmiServer& operator=(FakeAmiServer &&) noexcept = delete;
+
+    /// @brief Returns the port the server listens on.
+    uint16_t port() const
+    {
+        return port_;
+    }
+
+    /// @brief Returns the number of sessions accepted so far.
+    size_t sessions() const
+    {
+        std::unique_lock const lock(mutex_);
+        return sessions_.size();
+    }
+
+    /// @brief Returns the requests received so far, in the order they were read.
+    std::vector<std::pair<size_t, util::KeyValDict>> requests() const
+    {
+        std::unique_lock const lock(mutex_);
+        return requests_;
+    }
+
+    /// @brief Waits up to \c timeout for at least \c count requests to have been received.
+    bool wait_requests(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(5)) const
+    {
+        std::unique_lock lock(mutex_);
+        return requests_cv_.wait_for(lock, timeout, [this, count]() -> bool { return requests_.size() >= count; });
+    }
+
+    /// @brief Writes \c data to \c session, e.g. an event or a late response.
+    void send(size_t session, std::string_view data)
+    {
+        auto const target = get_session(session);
+        std::unique_lock const lock(target->write_mutex);
+        [[maybe_unused]] auto const ret = ::send(target->fd, data.data(), data.size(), MSG_NOSIGNAL);
+    }
+
+    /// @brief Drops \c session as if the server went away.
+    void close(size_t session)
+    {
+        ::shutdown(get_session(session)->fd, SHUT_RDWR);
+    }
+
+    /// @brief Default handler; answers every request with a plain success response.
+    static std::string success(size_t, util::KeyValDict const &request)
+    {
+        return fmt::format("Response: Success{}ActionID: {}{}{}", EOR, request.get_value("ActionID").value_or(""), EOR,
+            EOR);
+    }
+
+private:
+    ///
+    /// @struct Session
+    ///
+    /// @brief Accepted client connection.
+    ///
+    struct Session {
+        int fd{ -1 };               ///< Session socket.
+        std::mutex write_mutex;     ///< Mutex to keep replies and pushed data from interleaving.
+        std::thread thread;         ///< Handle to the session thread.
+    };
+
+    std::shared_ptr<Session> get_session(size_t session) const
+    {
+        std::unique_lock const lock(mutex_);
+        return sessions_.at(session);
+    }
+
+    void accept_thread()
+    {
+        while (true) {
+            auto const fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd == -1) {
+                return;
+            }
+            auto session = std::make_shared<Session>();
+            session->fd = fd;
+
+            std::unique_lock const lock(mutex_);
+            auto const id = sessions_.size();
+            sessions_.push_back(session);
+            session->thread = std::thread(&FakeAmiServer::session_thread, this, id, session.get());
+        }
+    }
+
+    void session_thread(size_t id, Session *session)
+    {
+        send(id, "Asterisk Call Manager/5.0.0\r\n");
+
+        std::string input;
+        char buf[4096];
+        while (true) {
+            auto const received = recv(session->fd, buf, sizeof(buf), 0);
+            if (received <= 0) {
+                return;
+            }
+            input.append(buf, received);
+
+            for (auto eom = input.find(EOM); eom != std::string::npos; eom = input.find(EOM)) {
+                util::KeyValDict request(input.substr(0, eom + EOM.length()));
+                input.erase(0, eom + EOM.length());
+                {
+                    std::unique_lock const lock(mutex_);
+                    requests_.emplace_back(id, request);
+                }
+                requests_cv_.notify_all();
+                if (auto const reply = handler_(id, request); !reply.empty()) {
+                    send(id, reply);
+                }
+            }
+        }
+    }
+
+    handler_t handler_;                                         ///< Handler producing replies.
+    int listen_fd_{ -1 };                                       ///< Listening socket.
+    uint16_t port_{ 0 };                                        ///< Port the server listens on.
+    std::thread accept_thread_;                                 ///< Handle to the accept thread.
+    std::vector<std::shared_ptr<Session>> sessions_;            ///< Sessions in the order they were accepted.
+    std::vector<std::pair<size_t, util::KeyValDict>> requests_; ///< Requests received, tagged with their session.
+    mutable std::condition_variable requests_cv_;               ///< Condition variable used to wait for requests.
+    mutable std::mutex mutex_;                                  ///< Mutex to control access to the sessions and requests.
+};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/AdmissionController.hpp"
+#include <thread>
+
+using cpp_ami::AdmissionController;
+using Priority = cpp_ami::action::Action::Priority;
+
+BOOST_AUTO_TEST_SUITE(admission_controller_tests)
+
+BOOST_AUTO_TEST_CASE(priority_test)
+{
+    std::vector<std::string> written;
+    AdmissionController controller(
+        [&written](std::string const &buf) -> void { written.push_back(buf); },
+        [](std::string const &, std::exception_ptr const &) -> void {},
+        1);
+
+    controller.submit({ { "a", Priority::bulk, "a" }, { "b", Priority::bulk, "b" } });
+    controller.submit({ { "c", Priority::urgent, "c" } });
+    BOOST_CHECK((written == std::vector<std::string>{ "a" }));
+
+    auto metrics = controller.get_metrics();
+    BOOST_CHECK(metrics.in_flight == 1);
+    BOOST_CHECK(metrics.queued[static_cast<size_t>(Priority::urgent)] == 1);
+    BOOST_CHECK(metrics.queued[static_cast<size_t>(Priority::bulk)] == 1);
+
+    // Urgent action jumps ahead of the bulk action that was queued first
+    controller.release("a");
+    controller.flush();
+    BOOST_CHECK((written == std::vector<std::string>{ "a", "c" }));
+    controller.release("c");
+    controller.flush();
+    BOOST_CHECK((written == std::vector<std::string>{ "a", "c", "b" }));
+
+    metrics = controller.get_metrics();
+    BOOST_CHECK(metrics.admitted == 1);
+    BOOST_CHECK(metrics.deferred == 2);
+}
+
+BOOST_AUTO_TEST_CASE(release_writer_thread_test)
+{
+    std::vector<std::pair<std::string, std::thread::id>> written;
+    AdmissionController controller(
+        [&written](std::string const &buf) -> void { written.emplace_back(buf, std::this_thread::get_id()); },
+        [](std::string const &, std::exception_ptr const &) -> void {},
+        1);
+
+    // Submitted actions are written by the submitting thread, the ones a retirement admits by the writer thread
+    controller.submit({ { "a", Priority::normal, "a" }, { "b", Priority::normal, "b" } });
+    controller.release("a");
+    controller.flush();
+    BOOST_REQUIRE_EQUAL(written.size(), 2);
+    BOOST_CHECK(written[0] == std::make_pair(std::string("a"), std::this_thread::get_id()));
+    BOOST_CHECK(written[1].first == "b");
+    BOOST_CHECK(written[1].second != std::this_thread::get_id());
+
+    // Once closed, nothing admitted is written anymore
+    controller.submit({ { "c", Priority::normal, "c" } });
+    controller.close();
+    controller.release("b");
+    controller.flush();
+    BOOST_CHECK_EQUAL(written.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(retire_queued_test)
+{
+    std::vector<std::string> written;
+    AdmissionController controller(
+        [&written](std::string const &buf) -> void { written.push_back(buf); },
+        [](std::string const &, std::exception_ptr const &) -> void {},
+        1);
+
+    controller.submit({ { "a", Priority::normal, "a" }, { "b", Priority::normal, "b" } });
+
+    // Queued action times out; it is dropped without ever being written or freeing a slot
+    controller.release("b");
+    BOOST_CHECK(controller.get_metrics().in_flight == 1);
+    controller.release("a");
+    BOOST_CHECK((written == std::vector<std::string>{ "a" }));
+    BOOST_CHECK(controller.get_metrics().in_flight == 0);
+}
+
+BOOST_AUTO_TEST_CASE(orphaned_test)
+{
+    std::vector<std::string> written;
+    AdmissionController controller(
+        [&written](std::string const &buf) -> void { written.push_back(buf); },
+        [](std::string const &, std::exception_ptr const &) -> void {},
+        0);
+
+    // Retired before it was submitted; it is dropped once it turns up
+    controller.release("a");
+    controller.submit({ { "a", Priority::normal, "a" }, { "b", Priority::normal, "b" } });
+    BOOST_CHECK((written == std::vector<std::string>{ "b" }));
+    BOOST_CHECK(controller.get_metrics().orphaned == 0);
+
+    // Actions that are never submitted aren't remembered without bound
+    for (size_t i = 0; i < 2 * AdmissionController::MAX_ORPHANED; ++i) {
+        controller.release(std::to_string(i));
+    }
+    BOOST_CHECK(controller.get_metrics().orphaned == AdmissionController::MAX_ORPHANED);
+    controller.submit({ { "0", Priority::normal, "0" }, { "2047", Priority::normal, "2047" } });
+    BOOST_CHECK((written == std::vector<std::string>{ "b", "0" }));
+}
+
+BOOST_AUTO_TEST_CASE(unlimited_pipeline_test)
+{
+    std::vector<std::string> written;
+    AdmissionController controller(
+        [&written](std::string const &buf) -> void { written.push_back(buf); },
+        [](std::string const &, std::exception_ptr const &) -> void {},
+        0);
+
+    // Everything submitted together is written together
+    controller.submit({ { "a", Priority::normal, "a" }, { "b", Priority::bulk, "b" } });
+    BOOST_CHECK((written == std::vector<std::string>{ "ab" }));
+}
+
+BOOST_AUTO_TEST_CASE(write_failure_test)
+{
+    std::vector<std::string> failed;
+    AdmissionController controller(
+        [](std::string const &) -> void { throw std::runtime_error("write failed"); },
+        [&failed](std::string const &action_id, std::exception_ptr const &) -> void { failed.push_back(action_id); },
+        0);
+
+    controller.submit({ { "a", Priority::normal, "a" }, { "b", Priority::normal, "b" } });
+    BOOST_CHECK((failed == std::vector<std::string>{ "a", "b" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "c++ami/event/EventPool.hpp"
 #include "c++ami/util/KeyValDict.hpp"
 
 BOOST_AUTO_TEST_SUITE(ami_message_tests)
@@ -15,4 +16,63 @@ BOOST_AUTO_TEST_CASE(message_parse_test)
     BOOST_CHECK(msg == ami_msg.to_string());
 }
 
+BOOST_AUTO_TEST_CASE(message_reparse_test)
+{
+    std::string const first("Event: Newstate\r\nChannel: SIP/1\r\nUniqueid: 1\r\nChannelState: 6\r\n\r\n");
+    std::string const second("Event: Hangup\r\nUniqueid: 2\r\nCause: 16\r\n\r\n");
+
+    cpp_ami::event::Event event(cpp_ami::util::KeyValDict{ first });
+    event.reset(second);
+
+    // Nothing from the previous contents leaks into the recycled message
+    BOOST_CHECK(second == event.to_string());
+    BOOST_CHECK(event.count() == 3);
+    BOOST_CHECK(!event.get_value("Channel"));
+    BOOST_CHECK(event.get_value("Uniqueid") == "2");
+}
+
+BOOST_AUTO_TEST_CASE(message_repeated_key_test)
+{
+    std::string const msg("Response: Success\r\nOutput: line 1\r\nOutput: line 2\r\nEmpty:\r\nOutput: \r\n\r\n");
+
+    // Repeated keys are joined a line at a time; a key without a value may be sent without the trailing space
+    cpp_ami::util::KeyValDict const ami_msg(msg);
+    BOOST_CHECK(ami_msg.count() == 3);
+    BOOST_CHECK(ami_msg.get_value("Output") == "line 1\nline 2\n");
+    BOOST_CHECK(ami_msg.get_value("Empty") == "");
+
+    // and split up again, in the order they were read, when written out
+    BOOST_CHECK(ami_msg.to_string()
+        == "Response: Success\r\nOutput: line 1\r\nOutput: line 2\r\nEmpty: \r\nOutput: \r\n\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(message_separator_test)
+{
+    std::string const msg("Key:value\r\nSpaced:  two\r\nTime: 12:30\r\n\r\n");
+
+    // Only the colon and a single space following it separate the key from the value
+    cpp_ami::util::KeyValDict const ami_msg(msg);
+    BOOST_CHECK(ami_msg.get_value("Key") == "value");
+    BOOST_CHECK(ami_msg.get_value("Spaced") == " two");
+    BOOST_CHECK(ami_msg.get_value("Time") == "12:30");
+}
+
+BOOST_AUTO_TEST_CASE(event_pool_test)
+{
+    cpp_ami::event::EventPool pool(1);
+
+    cpp_ami::event::Event const *recycled{ nullptr };
+    {
+        auto const event = pool.acquire("Event: Newstate\r\nUniqueid: 1\r\n\r\n");
+        recycled = event.get();
+    }
+    BOOST_CHECK(pool.idle_count() == 1);
+
+    // Idle event is handed out again, re-initialized with the new message
+    auto const event = pool.acquire("Event: Hangup\r\nUniqueid: 2\r\n\r\n");
+    BOOST_CHECK(event.get() == recycled);
+    BOOST_CHECK(event->get_value("Event") == "Hangup");
+    BOOST_CHECK(pool.idle_count() == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/cache/AstDbCache.hpp"
+#include "c++ami/Connection.hpp"
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using cpp_ami::Connection;
+using cpp_ami::cache::AstDbCache;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Returns the Action, Key and Val headers of the requests \c server received after the first \c skip.
+std::vector<std::string> writes(FakeAmiServer const &server, size_t skip = 0)
+{
+    std::vector<std::string> writes;
+    auto const requests = server.requests();
+    for (size_t i = skip; i < requests.size(); ++i) {
+        auto const &request = requests[i].second;
+        writes.push_back(fmt::format("{} {}={}", request.get_value("Action").value_or(""),
+            request.get_value("Key").value_or(""), request.get_value("Val").value_or("")));
+    }
+    return writes;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(astdb_cache_tests)
+
+BOOST_AUTO_TEST_CASE(detached_test)
+{
+    AstDbCache cache;
+    cache.load(KeyValDict("Event: DBGetTreeResponse\r\nKey: /cfwd/100/enabled\r\nVal: 1\r\n\r\n"));
+    cache.load(KeyValDict("Event: DBGetResponse\r\nFamily: dnd\r\nKey: 100\r\nVal: yes\r\n\r\n"));
+
+    BOOST_CHECK(cache.get("cfwd", "100/enabled") == "1");
+    BOOST_CHECK(cache.get("cfwd/100", "enabled") == "1");
+    BOOST_CHECK(cache.get("dnd", "100") == "yes");
+
+    cache.put("dnd", "200", "yes");
+    cache.del("dnd", "100");
+    BOOST_CHECK(cache.get("dnd", "200") == "yes");
+    BOOST_CHECK(!cache.get("dnd", "100"));
+
+    // A detached cache can't read what it doesn't hold
+    cache.invalidate("dnd");
+    BOOST_CHECK_THROW(cache.get("dnd", "200"), std::runtime_error);
+    BOOST_CHECK(cache.get("cfwd", "100/enabled") == "1");
+
+    auto const metrics = cache.get_metrics();
+    BOOST_CHECK(metrics.hits == 6);
+    BOOST_CHECK(metrics.writes == 0);
+    BOOST_CHECK(metrics.entries == 1);
+}
+
+BOOST_AUTO_TEST_CASE(write_behind_test)
+{
+    // The first write is held until the test has queued the writes that follow it
+    std::promise<void> gate;
+    auto const released = gate.get_future().share();
+    FakeAmiServer server([released](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Key") == "gate") {
+            released.wait();
+        }
+        return FakeAmiServer::success(session, request);
+    });
+    Connection conn("127.0.0.1", server.port());
+    AstDbCache cache(conn, 5s, 2);
+
+    cache.put("f", "gate", "0");
+    BOOST_REQUIRE(server.wait_requests(1));
+    cache.put("f", "a", "1");
+    cache.put("f", "b", "1");
+    cache.put("f", "a", "2");
+    cache.del("f", "c");
+
+    // The cache is current before anything was sent
+    BOOST_CHECK(cache.get("f", "a") == "2");
+    BOOST_CHECK(!cache.get("f", "c"));
+    BOOST_CHECK(cache.get_metrics().pending == 3);
+
+    gate.set_value();
+    cache.flush();
+
+    // Only the newest value of a is sent; the queued writes go out in batches of at most two
+    BOOST_CHECK((writes(server, 1) == std::vector<std::string>{ "DBPut a=2", "DBPut b=1", "DBDel c=" }));
+    auto const metrics = cache.get_metrics();
+    BOOST_CHECK(metrics.writes == 5);
+    BOOST_CHECK(metrics.coalesced == 1);
+    BOOST_CHECK(metrics.batches == 3);
+    BOOST_CHECK(metrics.failures == 0);
+    BOOST_CHECK(metrics.pending == 0);
+}
+
+BOOST_AUTO_TEST_CASE(failed_write_test)
+{
+    FakeAmiServer server([](size_t session, KeyValDict const &request) -> std::string {
+        auto const action_id = request.get_value("ActionID").value_or("");
+        if (request.get_value("Action") == "DBPut" && request.get_value("Key") == "locked") {
+            return fmt::format("Response: Error\r\nActionID: {}\r\nMessage: Failed to update entry\r\n\r\n",
+                action_id);
+        }
+        if (request.get_value("Action") == "DBGet") {
+            return fmt::format("Response: Success\r\nActionID: {0}\r\nEventList: start\r\n\r\n"
+                "Event: DBGetResponse\r\nActionID: {0}\r\nFamily: f\r\nKey: {1}\r\nVal: old\r\n\r\n"
+                "Event: DBGetComplete\r\nActionID: {0}\r\nEventList: Complete\r\n\r\n", action_id,
+                request.get_value("Key").value_or(""));
+        }
+        return FakeAmiServer::success(session, request);
+    });
+    Connection conn("127.0.0.1", server.port());
+    AstDbCache cache(conn, 5s);
+
+    cache.put("f", "locked", "new");
+    cache.put("f", "open", "new");
+    cache.flush();
+
+    // The rejected key is dropped and read back from the database on its next lookup
+    auto const metrics = cache.get_metrics();
+    BOOST_CHECK(metrics.failures == 1);
+    BOOST_CHECK(metrics.entries == 1);
+    BOOST_CHECK(cache.get("f", "open") == "new");
+    BOOST_CHECK(cache.get("f", "locked") == "old");
+    BOOST_CHECK(cache.get_metrics().misses == 1);
+    BOOST_CHECK((writes(server) == std::vector<std::string>{ "DBPut locked=new", "DBPut open=new", "DBGet locked=" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
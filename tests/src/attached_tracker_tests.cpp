@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/action/Action.hpp"
+#include "c++ami/cache/AttachedTracker.hpp"
+#include "c++ami/Connection.hpp"
+#include <map>
+#include <mutex>
+
+using cpp_ami::Connection;
+using cpp_ami::action::Action;
+using cpp_ami::cache::AttachedTracker;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Tracker of key/value pairs listed by KeyList and changed by KeyChange events; a change without a value
+///        removes the key.
+class KeyTracker
+    : public AttachedTracker {
+public:
+    KeyTracker()
+        : AttachedTracker("KeyTracker")
+    {
+    }
+
+    explicit KeyTracker(Connection &connection)
+        : KeyTracker()
+    {
+        attach(connection, 5s);
+    }
+
+    ~KeyTracker() override
+    {
+        detach();
+    }
+
+    void apply(KeyValDict const &event) override
+    {
+        auto const key = event.get_value("Key");
+        if (event.get_value("Event") != "KeyChange" || !key) {
+            return;
+        }
+
+        std::unique_lock const lock(mutex_);
+        report(key.value());
+        if (auto const value = event.get_value("Value")) {
+            keys_[key.value()] = value.value();
+        }
+        else {
+            keys_.erase(key.value());
+        }
+    }
+
+    void load(KeyValDict const &event) override
+    {
+        auto const key = event.get_value("Key");
+        if (event.get_value("Event") != "KeyListItem" || !key) {
+            return;
+        }
+
+        std::unique_lock const lock(mutex_);
+        if (list(key.value())) {
+            keys_[key.value()] = event.get_value("Value").value_or("");
+        }
+    }
+
+    std::map<std::string, std::string> keys() const
+    {
+        std::shared_lock const lock(mutex_);
+        return keys_;
+    }
+
+private:
+    void synchronize(std::chrono::milliseconds const &timeout) override
+    {
+        fetch(Action("KeyList"), timeout);
+
+        std::unique_lock const lock(mutex_);
+        std::erase_if(keys_, [this](auto const &entry) -> bool { return !seen(entry.first); });
+    }
+
+    std::map<std::string, std::string> keys_;
+};
+
+/// @brief Returns a KeyList response listing \c items, preceded by the unrelated events \c events.
+std::string key_list(KeyValDict const &request, std::map<std::string, std::string> const &items,
+    std::string const &events = {})
+{
+    auto const action_id = request.get_value("ActionID").value_or("");
+    auto reply = fmt::format("Response: Success\r\nActionID: {}\r\nEventList: start\r\n\r\n{}", action_id, events);
+    for (auto const &[key, value] : items) {
+        reply += fmt::format("Event: KeyListItem\r\nActionID: {}\r\nKey: {}\r\nValue: {}\r\n\r\n", action_id, key,
+            value);
+    }
+    return reply + fmt::format("Event: KeyListComplete\r\nActionID: {}\r\nEventList: Complete\r\n\r\n", action_id);
+}
+
+/// @brief Waits for every event sent to \c conn so far to have been dispatched.
+void sync(Connection const &conn)
+{
+    BOOST_REQUIRE(conn.invoke(Action("Ping"), 5s));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(attached_tracker_tests)
+
+BOOST_AUTO_TEST_CASE(detached_test)
+{
+    KeyTracker tracker;
+    BOOST_CHECK_THROW(tracker.refresh(), std::runtime_error);
+
+    // Outside of a refresh every listed item is stored
+    tracker.load(KeyValDict("Event: KeyListItem\r\nKey: a\r\nValue: 1\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: KeyChange\r\nKey: a\r\nValue: 2\r\n\r\n"));
+    tracker.load(KeyValDict("Event: KeyListItem\r\nKey: a\r\nValue: 1\r\n\r\n"));
+    BOOST_CHECK((tracker.keys() == std::map<std::string, std::string>{ { "a", "1" } }));
+}
+
+BOOST_AUTO_TEST_CASE(bootstrap_test)
+{
+    std::map<std::string, std::string> listed{ { "a", "1" }, { "b", "2" } };
+    std::mutex listed_mutex;
+    FakeAmiServer server([&](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") != "KeyList") {
+            return FakeAmiServer::success(session, request);
+        }
+        std::unique_lock const lock(listed_mutex);
+        return key_list(request, listed);
+    });
+    Connection conn("127.0.0.1", server.port());
+
+    KeyTracker tracker(conn);
+    BOOST_CHECK((tracker.keys() == listed));
+
+    // Events reach the tracker through the callback registered by attach
+    server.send(0, "Event: KeyChange\r\nKey: c\r\nValue: 3\r\n\r\n");
+    sync(conn);
+    BOOST_CHECK(tracker.keys().at("c") == "3");
+
+    // Whatever isn't listed again and isn't reported while the refresh is in progress is dropped
+    {
+        std::unique_lock const lock(listed_mutex);
+        listed = { { "a", "4" } };
+    }
+    tracker.refresh(5s);
+    BOOST_CHECK((tracker.keys() == std::map<std::string, std::string>{ { "a", "4" } }));
+}
+
+BOOST_AUTO_TEST_CASE(event_during_refresh_test)
+{
+    // Events arriving while the list is coming in are newer than the listed state
+    FakeAmiServer server([](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") != "KeyList") {
+            return FakeAmiServer::success(session, request);
+        }
+        return key_list(request, { { "a", "1" }, { "b", "2" }, { "c", "3" } },
+            "Event: KeyChange\r\nKey: a\r\nValue: 5\r\n\r\nEvent: KeyChange\r\nKey: b\r\n\r\n"
+            "Event: KeyChange\r\nKey: d\r\nValue: 6\r\n\r\n");
+    });
+    Connection conn("127.0.0.1", server.port());
+
+    KeyTracker const tracker(conn);
+    BOOST_CHECK((tracker.keys() == std::map<std::string, std::string>{ { "a", "5" }, { "c", "3" }, { "d", "6" } }));
+}
+
+BOOST_AUTO_TEST_CASE(failed_bootstrap_test)
+{
+    FakeAmiServer server([](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") != "KeyList") {
+            return FakeAmiServer::success(session, request);
+        }
+        return fmt::format("Response: Error\r\nActionID: {}\r\nMessage: Permission denied\r\n\r\n",
+            request.get_value("ActionID").value_or(""));
+    });
+    Connection conn("127.0.0.1", server.port());
+
+    BOOST_CHECK_THROW(KeyTracker{ conn }, std::runtime_error);
+
+    // The callback went with the tracker; events don't reach the destroyed tracker
+    server.send(0, "Event: KeyChange\r\nKey: a\r\nValue: 1\r\n\r\n");
+    sync(conn);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/cache/BridgeTracker.hpp"
+#include "c++ami/Connection.hpp"
+#include <algorithm>
+
+using cpp_ami::Connection;
+using cpp_ami::cache::BridgeTracker;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(bridge_tracker_tests)
+
+BOOST_AUTO_TEST_CASE(topology_test)
+{
+    BridgeTracker tracker;
+    tracker.apply(KeyValDict("Event: BridgeCreate\r\nBridgeUniqueid: b1\r\nBridgeType: basic\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: BridgeEnter\r\nBridgeUniqueid: b1\r\n"
+        "Channel: PJSIP/100-1\r\nUniqueid: 1.1\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: BridgeEnter\r\nBridgeUniqueid: b1\r\n"
+        "Channel: PJSIP/200-2\r\nUniqueid: 1.2\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: BridgeEnter\r\nBridgeUniqueid: b2\r\n"
+        "Channel: PJSIP/300-3\r\nUniqueid: 1.3\r\n\r\n"));
+
+    BOOST_REQUIRE(tracker.bridge_of("1.1"));
+    BOOST_CHECK(tracker.bridge_of("1.1")->type == "basic");
+    auto peers = tracker.peers("1.1");
+    BOOST_REQUIRE(peers.size() == 1);
+    BOOST_CHECK(peers[0].channel == "PJSIP/200-2");
+    BOOST_CHECK(tracker.snapshot().size() == 2);
+
+    // Merging moves the channels of the source bridge into the target bridge
+    auto const before = tracker.find("b1");
+    tracker.apply(KeyValDict("Event: BridgeMerge\r\nToBridgeUniqueid: b1\r\nFromBridgeUniqueid: b2\r\n\r\n"));
+    BOOST_CHECK(before->participants.size() == 2);
+    BOOST_CHECK(tracker.peers("1.1").size() == 2);
+    BOOST_CHECK(tracker.find("b2")->participants.empty());
+
+    tracker.apply(KeyValDict("Event: BridgeLeave\r\nBridgeUniqueid: b1\r\nUniqueid: 1.2\r\n\r\n"));
+    BOOST_CHECK(!tracker.bridge_of("1.2"));
+    BOOST_CHECK(tracker.peers("1.1").size() == 1);
+
+    tracker.apply(KeyValDict("Event: BridgeDestroy\r\nBridgeUniqueid: b1\r\n\r\n"));
+    BOOST_CHECK(!tracker.find("b1"));
+    BOOST_CHECK(!tracker.bridge_of("1.1"));
+    BOOST_CHECK(!tracker.bridge_of("1.3"));
+    BOOST_CHECK(tracker.peers("1.3").empty());
+}
+
+BOOST_AUTO_TEST_CASE(bootstrap_test)
+{
+    // b2 goes away between BridgeList and its BridgeInfo
+    FakeAmiServer server([](size_t session, KeyValDict const &request) -> std::string {
+        auto const action = request.get_value("Action");
+        auto const action_id = request.get_value("ActionID").value_or("");
+        if (action == "BridgeList") {
+            return fmt::format("Response: Success\r\nActionID: {0}\r\nEventList: start\r\n\r\n"
+                "Event: BridgeListItem\r\nActionID: {0}\r\nBridgeUniqueid: b1\r\nBridgeType: basic\r\n\r\n"
+                "Event: BridgeListItem\r\nActionID: {0}\r\nBridgeUniqueid: b2\r\nBridgeType: basic\r\n\r\n"
+                "Event: BridgeListComplete\r\nActionID: {0}\r\nEventList: Complete\r\n\r\n", action_id);
+        }
+        if (action == "BridgeInfo" && request.get_value("BridgeUniqueid") == "b1") {
+            return fmt::format("Response: Success\r\nActionID: {0}\r\nEventList: start\r\n\r\n"
+                "Event: BridgeInfoChannel\r\nActionID: {0}\r\nChannel: PJSIP/100-1\r\nUniqueid: 1.1\r\n\r\n"
+                "Event: BridgeInfoChannel\r\nActionID: {0}\r\nChannel: PJSIP/200-2\r\nUniqueid: 1.2\r\n\r\n"
+                "Event: BridgeInfoComplete\r\nActionID: {0}\r\nBridgeUniqueid: b1\r\nEventList: Complete\r\n\r\n",
+                action_id);
+        }
+        if (action == "BridgeInfo") {
+            return fmt::format("Response: Error\r\nActionID: {}\r\nMessage: Bridge not found\r\n\r\n", action_id);
+        }
+        return FakeAmiServer::success(session, request);
+    });
+    Connection conn("127.0.0.1", server.port());
+
+    BridgeTracker const tracker(conn, 5s);
+
+    // Participants come from the BridgeInfo of their bridge
+    auto const requests = server.requests();
+    BOOST_CHECK_EQUAL(std::count_if(requests.begin(), requests.end(), [](auto const &request) -> bool {
+        return request.second.get_value("Action") == "BridgeInfo";
+    }), 2);
+    BOOST_REQUIRE(tracker.bridge_of("1.1"));
+    BOOST_CHECK(tracker.bridge_of("1.1")->uniqueid == "b1");
+    BOOST_REQUIRE(tracker.peers("1.1").size() == 1);
+    BOOST_CHECK(tracker.peers("1.1")[0].channel == "PJSIP/200-2");
+    BOOST_REQUIRE(tracker.find("b2"));
+    BOOST_CHECK(tracker.find("b2")->participants.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
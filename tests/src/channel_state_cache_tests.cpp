@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/cache/ChannelStateCache.hpp"
+
+using cpp_ami::cache::ChannelStateCache;
+using cpp_ami::util::KeyValDict;
+
+BOOST_AUTO_TEST_SUITE(channel_state_cache_tests)
+
+BOOST_AUTO_TEST_CASE(event_test)
+{
+    ChannelStateCache cache;
+
+    cache.apply(KeyValDict("Event: Newchannel\r\nChannel: PJSIP/100-1\r\nChannelState: 4\r\nChannelStateDesc: Ring\r\n"
+        "CallerIDNum: 100\r\nUniqueid: 1.1\r\nLinkedid: 1.1\r\n\r\n"));
+    cache.apply(KeyValDict("Event: Newchannel\r\nChannel: PJSIP/200-2\r\nChannelState: 5\r\nChannelStateDesc: Ringing\r\n"
+        "Uniqueid: 1.2\r\nLinkedid: 1.1\r\n\r\n"));
+    auto const ringing = cache.find_by_uniqueid("1.2");
+
+    cache.apply(KeyValDict("Event: Newstate\r\nChannel: PJSIP/200-2\r\nChannelState: 6\r\nChannelStateDesc: Up\r\n"
+        "Uniqueid: 1.2\r\nLinkedid: 1.1\r\n\r\n"));
+    cache.apply(KeyValDict("Event: VarSet\r\nChannel: PJSIP/200-2\r\nVariable: QUEUE\r\nValue: sales\r\n"
+        "Uniqueid: 1.2\r\nLinkedid: 1.1\r\n\r\n"));
+    cache.apply(KeyValDict("Event: Rename\r\nChannel: PJSIP/200-2\r\nNewname: PJSIP/200-2<ZOMBIE>\r\n"
+        "Uniqueid: 1.2\r\n\r\n"));
+
+    // Snapshots handed out earlier aren't modified by later events
+    BOOST_REQUIRE(ringing);
+    BOOST_CHECK(ringing->state_desc == "Ringing");
+
+    auto const up = cache.find_by_channel("PJSIP/200-2<ZOMBIE>");
+    BOOST_REQUIRE(up);
+    BOOST_CHECK(up->state_desc == "Up");
+    BOOST_CHECK(up->variables.at("QUEUE") == "sales");
+    BOOST_CHECK(!cache.find_by_channel("PJSIP/200-2"));
+    BOOST_CHECK(cache.find_by_linkedid("1.1").size() == 2);
+
+    cache.apply(KeyValDict("Event: Hangup\r\nChannel: PJSIP/100-1\r\nUniqueid: 1.1\r\nLinkedid: 1.1\r\n\r\n"));
+    BOOST_CHECK(cache.size() == 1);
+    BOOST_CHECK(!cache.find_by_uniqueid("1.1"));
+    BOOST_CHECK(cache.find_by_linkedid("1.1").size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(load_test)
+{
+    ChannelStateCache cache;
+
+    cache.apply(KeyValDict("Event: Newstate\r\nChannel: PJSIP/100-1\r\nChannelStateDesc: Up\r\nUniqueid: 1.1\r\n\r\n"));
+
+    // Listed channels fill in what the events haven't reported yet
+    cache.load(KeyValDict("Event: CoreShowChannel\r\nChannel: PJSIP/300-3\r\nChannelStateDesc: Up\r\n"
+        "Application: Dial\r\nBridgeId: b1\r\nUniqueid: 1.3\r\nLinkedid: 1.3\r\n\r\n"));
+    BOOST_REQUIRE(cache.find_by_uniqueid("1.3"));
+    BOOST_CHECK(cache.find_by_uniqueid("1.3")->bridge_id == "b1");
+    BOOST_CHECK(cache.snapshot().size() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "Eventually.hpp"
+#include "FakeAmiServer.hpp"
+#include "c++ami/action/Action.hpp"
+#include "c++ami/action/Ping.hpp"
+#include "c++ami/ConnectionPool.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using cpp_ami::ConnectionPool;
+using cpp_ami::action::Action;
+using cpp_ami::action::Ping;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::test::eventually;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Options of a pool whose health is only checked on demand.
+ConnectionPool::Options const manual_health{ .health_interval = 0ms, .health_timeout = 200ms };
+
+}
+
+BOOST_AUTO_TEST_SUITE(connection_pool_tests)
+
+BOOST_AUTO_TEST_CASE(routing_test)
+{
+    FakeAmiServer a;
+    FakeAmiServer b;
+    ConnectionPool pool(manual_health);
+    pool.add_server("a", "127.0.0.1", a.port());
+    pool.add_server("b", "127.0.0.1", b.port());
+    BOOST_CHECK_THROW(pool.add_server("a", "127.0.0.1", a.port()), std::runtime_error);
+    BOOST_CHECK_THROW(pool.get("c"), std::runtime_error);
+
+    BOOST_REQUIRE(pool.invoke("b", Action("Status"), 5s));
+    BOOST_REQUIRE(pool.invoke("a", Action("CoreSettings"), 5s));
+    BOOST_REQUIRE(pool.invoke("b", Action("CoreStatus"), 5s));
+    BOOST_REQUIRE_EQUAL(a.requests().size(), 1);
+    BOOST_CHECK(a.requests()[0].second.get_value("Action") == "CoreSettings");
+    BOOST_REQUIRE_EQUAL(b.requests().size(), 2);
+    BOOST_CHECK(b.requests()[1].second.get_value("Action") == "CoreStatus");
+
+    pool.remove_server("a");
+    auto servers = pool.get_servers();
+    BOOST_CHECK((servers == std::vector<std::string>{ "b" }));
+    BOOST_CHECK_THROW(pool.invoke("a", Ping(), 5s), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(removed_while_referenced_test)
+{
+    FakeAmiServer server;
+    ConnectionPool pool(manual_health);
+    pool.add_server("a", "127.0.0.1", server.port());
+
+    // A reference taken before the server is removed keeps its connection open
+    auto const connection = pool.get("a");
+    pool.remove_server("a");
+    BOOST_CHECK(pool.get_servers().empty());
+    BOOST_CHECK(connection->is_connected());
+    BOOST_CHECK(connection->invoke(Ping(), 5s));
+}
+
+BOOST_AUTO_TEST_CASE(removed_connection_detached_test)
+{
+    FakeAmiServer server;
+    std::shared_ptr<cpp_ami::Connection> removed;
+    std::shared_ptr<cpp_ami::Connection> orphaned;
+    std::atomic<size_t> received{ 0 };
+    {
+        ConnectionPool pool(manual_health);
+        pool.add_callback([&received](std::string const &, KeyValDict const *) -> void { ++received; });
+        removed = pool.add_server("a", "127.0.0.1", server.port());
+        orphaned = pool.add_server("b", "127.0.0.1", server.port());
+        pool.remove_server("a");
+    }
+
+    // Connections that outlive their place in the pool, or the pool itself, no longer feed the merged stream
+    std::atomic<size_t> direct{ 0 };
+    removed->add_callback([&direct](KeyValDict const *) -> void { ++direct; });
+    orphaned->add_callback([&direct](KeyValDict const *) -> void { ++direct; });
+    BOOST_REQUIRE(eventually([&server]() -> bool { return server.sessions() == 2; }));
+    server.send(0, "Event: Newchannel\r\nUniqueid: 1\r\n\r\n");
+    server.send(1, "Event: Newchannel\r\nUniqueid: 2\r\n\r\n");
+    BOOST_REQUIRE(eventually([&direct]() -> bool { return direct == 2; }));
+    BOOST_CHECK_EQUAL(received, 0);
+    BOOST_CHECK(removed->invoke(Ping(), 5s));
+    BOOST_CHECK(orphaned->invoke(Ping(), 5s));
+}
+
+BOOST_AUTO_TEST_CASE(merged_callbacks_test)
+{
+    FakeAmiServer a;
+    FakeAmiServer b;
+    ConnectionPool pool(manual_health);
+    pool.add_server("a", "127.0.0.1", a.port());
+    pool.add_server("b", "127.0.0.1", b.port());
+
+    std::vector<std::pair<std::string, std::string>> events;
+    std::mutex events_mutex;
+    auto const key = pool.add_callback([&](std::string const &id, KeyValDict const *event) -> void {
+        std::unique_lock const lock(events_mutex);
+        events.emplace_back(id, event->get_value("Uniqueid").value_or(""));
+    });
+
+    auto const count = [&]() -> size_t {
+        std::unique_lock const lock(events_mutex);
+        return events.size();
+    };
+
+    BOOST_REQUIRE(eventually([&]() -> bool { return a.sessions() == 1 && b.sessions() == 1; }));
+    a.send(0, "Event: Newchannel\r\nUniqueid: 1\r\n\r\nEvent: Newchannel\r\nUniqueid: 2\r\n\r\n");
+    b.send(0, "Event: Newchannel\r\nUniqueid: 3\r\n\r\n");
+    BOOST_REQUIRE(eventually([&]() -> bool { return count() == 3; }));
+    {
+        std::unique_lock const lock(events_mutex);
+        std::multimap<std::string, std::string> const tagged(events.begin(), events.end());
+        BOOST_CHECK((tagged == std::multimap<std::string, std::string>{ { "a", "1" }, { "a", "2" }, { "b", "3" } }));
+    }
+
+    // A removed callback no longer sees events; only the one that replaced it records them
+    pool.remove_callback(key);
+    auto const tail = pool.add_callback([&](std::string const &id, KeyValDict const *event) -> void {
+        std::unique_lock const lock(events_mutex);
+        events.emplace_back(id, event->get_value("Uniqueid").value_or(""));
+    });
+    a.send(0, "Event: Newchannel\r\nUniqueid: 4\r\n\r\n");
+    a.send(0, "Event: Newchannel\r\nUniqueid: 5\r\n\r\n");
+    BOOST_REQUIRE(eventually([&]() -> bool { return count() >= 5; }));
+    pool.remove_callback(tail);
+    std::unique_lock const lock(events_mutex);
+    BOOST_CHECK_EQUAL(events.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(health_test)
+{
+    std::atomic<bool> answer{ true };
+    FakeAmiServer a([&answer](size_t session, KeyValDict const &request) -> std::string {
+        return answer ? FakeAmiServer::success(session, request) : std::string();
+    });
+    FakeAmiServer b;
+    ConnectionPool pool(manual_health);
+    pool.add_server("a", "127.0.0.1", a.port());
+    pool.add_server("b", "127.0.0.1", b.port());
+    BOOST_CHECK(!pool.get_health("c"));
+
+    pool.check_health();
+    BOOST_REQUIRE(eventually([&pool]() -> bool {
+        return pool.get_health("a")->last_reply != ConnectionPool::clock_t::time_point();
+    }));
+    BOOST_CHECK(pool.get_health("a")->healthy);
+
+    // A ping that goes unanswered marks the server unhealthy while it stays connected
+    answer = false;
+    pool.check_health();
+    BOOST_REQUIRE(eventually([&pool]() -> bool { return pool.get_health("a")->failures == 1; }));
+    auto health = pool.get_health("a");
+    BOOST_CHECK(health->connected);
+    BOOST_CHECK(!health->healthy);
+
+    answer = true;
+    pool.check_health();
+    BOOST_REQUIRE(eventually([&pool]() -> bool { return pool.get_health("a")->healthy; }));
+    BOOST_CHECK_EQUAL(pool.get_health("a")->failures, 0);
+
+    // A server that closes the connection is neither connected nor healthy
+    b.close(0);
+    BOOST_REQUIRE(eventually([&pool]() -> bool { return !pool.get_health("b")->connected; }));
+    BOOST_CHECK(!pool.get_health("b")->healthy);
+    BOOST_CHECK(pool.get_health("a")->healthy);
+}
+
+BOOST_AUTO_TEST_CASE(poller_churn_test)
+{
+    FakeAmiServer a;
+    FakeAmiServer b;
+    ConnectionPool pool(manual_health);
+    pool.add_server("a", "127.0.0.1", a.port());
+
+    std::atomic<size_t> received{ 0 };
+    pool.add_callback([&received](std::string const &id, KeyValDict const *) -> void {
+        if (id == "a") {
+            ++received;
+        }
+    });
+
+    // Servers join and leave the shared poller while it is busy reading another one
+    BOOST_REQUIRE(eventually([&a]() -> bool { return a.sessions() == 1; }));
+    size_t constexpr events = 2000;
+    std::thread feeder([&a]() -> void {
+        for (size_t i = 0; i < events; ++i) {
+            a.send(0, fmt::format("Event: Newchannel\r\nUniqueid: {}\r\n\r\n", i));
+        }
+    });
+    for (int i = 0; i < 20; ++i) {
+        pool.add_server("b", "127.0.0.1", b.port());
+        BOOST_CHECK(pool.invoke("b", Ping(), 5s));
+        pool.remove_server("b");
+    }
+    feeder.join();
+
+    BOOST_CHECK(eventually([&received]() -> bool { return received == events; }));
+    BOOST_CHECK(pool.get_health("a")->connected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include <tuple>
+#include <vector>
+
+using cpp_ami::Connection;
+using cpp_ami::action::Action;
+using cpp_ami::test::FakeAmiServer;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(connection_tests)
+
+BOOST_AUTO_TEST_CASE(invoke_many_test)
+{
+    // Echo the action name back so that every future can be matched with its action
+    FakeAmiServer server([](size_t, cpp_ami::util::KeyValDict const &request) -> std::string {
+        return fmt::format("Response: Success\r\nActionID: {}\r\nMessage: {}\r\n\r\n",
+            request.get_value("ActionID").value_or(""), request.get_value("Action").value_or(""));
+    });
+    Connection conn("127.0.0.1", server.port());
+
+    std::vector<Action> actions;
+    for (int i = 0; i < 8; ++i) {
+        actions.emplace_back(fmt::format("Action{}", i));
+    }
+    auto reactions = conn.invoke_many(actions, 5s);
+    BOOST_REQUIRE_EQUAL(reactions.size(), actions.size());
+    for (size_t i = 0; i < reactions.size(); ++i) {
+        BOOST_REQUIRE(reactions[i].wait_for(5s) == std::future_status::ready);
+        auto const reaction = reactions[i].get();
+        BOOST_REQUIRE(reaction);
+        BOOST_CHECK(reaction->to_string().find(fmt::format("Message: Action{}", i)) != std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(invoke_many_duplicate_test)
+{
+    FakeAmiServer server;
+    Connection conn("127.0.0.1", server.port());
+
+    // Copies of an action share its ActionID
+    std::vector<Action> actions;
+    actions.emplace_back("Ping");
+    actions.emplace_back("Ping");
+    actions.push_back(actions.front());
+    BOOST_CHECK_THROW(std::ignore = conn.invoke_many(actions, 5s), std::runtime_error);
+
+    // Nothing was registered or sent; the connection is still usable
+    actions.pop_back();
+    for (auto &reaction : conn.invoke_many(actions, 5s)) {
+        BOOST_REQUIRE(reaction.wait_for(5s) == std::future_status::ready);
+        BOOST_CHECK(reaction.get()->is_success());
+    }
+    BOOST_CHECK_EQUAL(server.requests().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/cache/DeviceStateCache.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using cpp_ami::cache::DeviceStateCache;
+using cpp_ami::util::KeyValDict;
+
+BOOST_AUTO_TEST_SUITE(device_state_cache_tests)
+
+BOOST_AUTO_TEST_CASE(device_test)
+{
+    DeviceStateCache cache;
+
+    std::vector<std::string> changes;
+    auto const id = cache.subscribe_device("PJSIP/100",
+        [&changes](DeviceStateCache::Device const &device) -> void { changes.push_back(device.state); });
+
+    cache.load(KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/100\r\nState: NOT_INUSE\r\n\r\n"));
+    cache.apply(KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/100\r\nState: INUSE\r\n\r\n"));
+    cache.apply(KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/100\r\nState: INUSE\r\n\r\n"));
+    cache.apply(KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/200\r\nState: RINGING\r\n\r\n"));
+
+    // Listeners only hear about actual changes of their own device
+    BOOST_CHECK((changes == std::vector<std::string>{ "NOT_INUSE", "INUSE" }));
+    BOOST_REQUIRE(cache.find_device("PJSIP/200"));
+    BOOST_CHECK(cache.find_device("PJSIP/200")->state == "RINGING");
+    BOOST_CHECK(!cache.find_device("PJSIP/300"));
+
+    cache.unsubscribe(id);
+    cache.apply(KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/100\r\nState: NOT_INUSE\r\n\r\n"));
+    BOOST_CHECK(changes.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(extension_test)
+{
+    DeviceStateCache cache;
+
+    std::vector<std::string> changes;
+    cache.subscribe_extension("100", "default",
+        [&changes](DeviceStateCache::Extension const &extension) -> void { changes.push_back(extension.status_text); });
+
+    cache.apply(KeyValDict("Event: ExtensionStatus\r\nExten: 100\r\nContext: default\r\nHint: PJSIP/100\r\n"
+        "Status: 1\r\nStatusText: InUse\r\n\r\n"));
+    cache.apply(KeyValDict("Event: ExtensionStatus\r\nExten: 100\r\nContext: other\r\nHint: PJSIP/100\r\n"
+        "Status: 0\r\nStatusText: Idle\r\n\r\n"));
+
+    BOOST_CHECK((changes == std::vector<std::string>{ "InUse" }));
+    BOOST_REQUIRE(cache.find_extension("100", "other"));
+    BOOST_CHECK(cache.find_extension("100", "other")->status_text == "Idle");
+    BOOST_CHECK(!cache.find_extension("200", "default"));
+}
+
+BOOST_AUTO_TEST_CASE(notification_order_test)
+{
+    DeviceStateCache cache;
+
+    // Listed states and events are stored on different threads; every notification carries the current state
+    std::string last;
+    std::atomic<size_t> stale{ 0 };
+    cache.subscribe_device("PJSIP/100", [&](DeviceStateCache::Device const &device) -> void {
+        if (cache.find_device("PJSIP/100")->state != device.state) {
+            ++stale;
+        }
+        last = device.state;
+    });
+
+    auto const event = [](std::string const &state) -> KeyValDict {
+        return KeyValDict("Event: DeviceStateChange\r\nDevice: PJSIP/100\r\nState: " + state + "\r\n\r\n");
+    };
+    std::thread listed([&]() -> void {
+        for (int i = 0; i < 2000; ++i) {
+            cache.load(event("NOT_INUSE"));
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        cache.apply(event("UNKNOWN"));
+        cache.apply(event("INUSE"));
+    }
+    listed.join();
+
+    BOOST_CHECK_EQUAL(stale, 0);
+    BOOST_CHECK(cache.find_device("PJSIP/100")->state == last);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/DispatchGroup.hpp"
+#include "c++ami/EventDispatcher.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using cpp_ami::DispatchGroup;
+using cpp_ami::EventDispatcher;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(dispatch_group_tests)
+
+BOOST_AUTO_TEST_CASE(shared_threads_test)
+{
+    auto group = std::make_shared<DispatchGroup>();
+
+    std::atomic<size_t> events{ 0 };
+    std::promise<std::thread::id> first_thread;
+    std::promise<std::thread::id> second_thread;
+    EventDispatcher first([&](EventDispatcher::event_batch_t batch) -> void {
+        if (events.fetch_add(batch.size()) == 0) {
+            first_thread.set_value(std::this_thread::get_id());
+        }
+    }, {}, group);
+    EventDispatcher second([&](EventDispatcher::event_batch_t) -> void {
+        second_thread.set_value(std::this_thread::get_id());
+    }, {}, group);
+    BOOST_CHECK_EQUAL(group->size(), 2);
+
+    // Responses are correlated per member
+    auto first_pipe = first.get_event_pipe("1", 5s);
+    auto second_pipe = second.get_event_pipe("1", 5s);
+    second.add_event("Response: Error\r\nActionID: 1\r\n\r\n");
+    first.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+    BOOST_REQUIRE(first_pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(first_pipe.get()->is_success());
+    BOOST_REQUIRE(second_pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(!second_pipe.get()->is_success());
+
+    // Notification callbacks of every member run on the group's notification thread
+    first.add_event("Event: FullyBooted\r\n\r\n");
+    second.add_event("Event: FullyBooted\r\n\r\n");
+    auto first_id = first_thread.get_future();
+    auto second_id = second_thread.get_future();
+    BOOST_REQUIRE(first_id.wait_for(5s) == std::future_status::ready);
+    BOOST_REQUIRE(second_id.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(first_id.get() == second_id.get());
+}
+
+BOOST_AUTO_TEST_CASE(timeout_test)
+{
+    auto group = std::make_shared<DispatchGroup>();
+    EventDispatcher idle([](EventDispatcher::event_batch_t) -> void {}, {}, group);
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {}, {}, group);
+
+    // Deadlines are serviced by the group's response thread
+    auto pipe = dispatcher.get_event_pipe("1", 20ms);
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK_THROW(pipe.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(remove_test)
+{
+    auto group = std::make_shared<DispatchGroup>();
+    EventDispatcher remaining([](EventDispatcher::event_batch_t) -> void {}, {}, group);
+
+    // Events queued when a member goes away are still delivered
+    std::atomic<size_t> events{ 0 };
+    {
+        EventDispatcher dispatcher([&events](EventDispatcher::event_batch_t batch) -> void {
+            events += batch.size();
+        }, {}, group);
+        for (int i = 0; i < 100; ++i) {
+            dispatcher.add_event("Event: FullyBooted\r\n\r\n");
+        }
+    }
+    BOOST_CHECK_EQUAL(events, 100);
+    BOOST_CHECK_EQUAL(group->size(), 1);
+
+    auto pipe = remaining.get_event_pipe("1", 5s);
+    remaining.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(pipe.get()->is_success());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/event/EventConflater.hpp"
+
+using cpp_ami::event::EventConflater;
+using cpp_ami::event::EventPool;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<EventConflater::event_ptr_t> make_batch(EventPool &pool, std::vector<std::string> const &events)
+{
+    std::vector<EventConflater::event_ptr_t> batch;
+    for (auto const &event : events) {
+        auto const sep = event.find('/');
+        batch.emplace_back(pool.acquire("Event: " + event.substr(0, sep) + "\r\nUniqueid: " + event.substr(sep + 1) +
+            "\r\nSeq: " + std::to_string(batch.size()) + "\r\n\r\n"));
+    }
+    return batch;
+}
+
+std::vector<std::string> describe(std::vector<EventConflater::event_ptr_t> const &batch)
+{
+    std::vector<std::string> events;
+    for (auto const &event : batch) {
+        events.push_back((*event)["Event"] + "/" + (*event)["Uniqueid"] + "#" + (*event)["Seq"]);
+    }
+    return events;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(event_conflater_tests)
+
+BOOST_AUTO_TEST_CASE(batch_test)
+{
+    EventPool pool(16);
+    EventConflater conflater;
+    conflater.configure({ "Newexten", "VarSet" }, 0ms);
+
+    // Only the newest event per type and channel survives, in the order the states were reached; the Hangup forces the
+    // held events of channel a out first
+    auto batch = make_batch(pool, { "Newexten/a", "Newexten/b", "VarSet/a", "Newexten/a", "Newexten/b", "Hangup/a",
+        "Newexten/b" });
+    conflater.process(batch, EventConflater::clock_t::now());
+
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "VarSet/a#2", "Newexten/a#3", "Hangup/a#5",
+        "Newexten/b#6" }));
+
+    auto const metrics = conflater.get_metrics();
+    BOOST_CHECK(metrics.conflatable == 6);
+    BOOST_CHECK(metrics.conflated == 3);
+    BOOST_CHECK(metrics.held == 0);
+}
+
+BOOST_AUTO_TEST_CASE(window_test)
+{
+    EventPool pool(16);
+    EventConflater conflater;
+    conflater.configure({ "Newstate" }, 100ms);
+
+    auto const start = EventConflater::clock_t::now();
+    auto batch = make_batch(pool, { "Newstate/a", "Hangup/b" });
+    conflater.process(batch, start);
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "Hangup/b#1" }));
+    BOOST_REQUIRE(conflater.next_deadline().has_value());
+    BOOST_CHECK(conflater.next_deadline().value() == start + 100ms);
+
+    // Newer state replaces the held event without extending its deadline
+    batch = make_batch(pool, { "Newstate/a" });
+    conflater.process(batch, start + 50ms);
+    BOOST_CHECK(batch.empty());
+
+    conflater.process(batch, start + 100ms);
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "Newstate/a#0" }));
+    BOOST_CHECK(!conflater.next_deadline().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(channel_order_test)
+{
+    EventPool pool(16);
+    EventConflater conflater;
+    conflater.configure({ "Newstate", "VarSet" }, 100ms);
+
+    // The replacing state follows the event held for the channel in between, and the channel keeps its deadline
+    auto const start = EventConflater::clock_t::now();
+    auto batch = make_batch(pool, { "Newstate/a", "VarSet/a" });
+    conflater.process(batch, start);
+    batch = make_batch(pool, { "Newstate/a" });
+    conflater.process(batch, start + 50ms);
+    BOOST_CHECK(batch.empty());
+    BOOST_CHECK(conflater.next_deadline().value() == start + 100ms);
+
+    conflater.process(batch, start + 100ms);
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "VarSet/a#1", "Newstate/a#0" }));
+}
+
+BOOST_AUTO_TEST_CASE(reconfigured_window_test)
+{
+    EventPool pool(16);
+    EventConflater conflater;
+    conflater.configure({ "Newstate" }, 1h);
+
+    auto const start = EventConflater::clock_t::now();
+    auto batch = make_batch(pool, { "Newstate/a" });
+    conflater.process(batch, start);
+    batch = make_batch(pool, { "Newstate/b" });
+    conflater.process(batch, start + 10ms);
+    BOOST_CHECK(batch.empty());
+
+    // A shorter window applies to the events already held back, whichever channel was held first
+    conflater.configure({ "Newstate" }, 20ms);
+    BOOST_CHECK(conflater.next_deadline().value() == start + 20ms);
+    conflater.process(batch, start + 20ms);
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "Newstate/a#0" }));
+    batch.clear();
+    conflater.configure({ "Newstate" }, 0ms);
+    conflater.process(batch, start + 20ms);
+    BOOST_CHECK((describe(batch) == std::vector<std::string>{ "Newstate/b#0" }));
+}
+
+BOOST_AUTO_TEST_CASE(disabled_test)
+{
+    EventPool pool(16);
+    EventConflater conflater;
+
+    auto batch = make_batch(pool, { "Newexten/a", "Newexten/a" });
+    conflater.process(batch, EventConflater::clock_t::now());
+    BOOST_CHECK(batch.size() == 2);
+
+    // Disabling conflation releases held events with the next batch
+    conflater.configure({ "Newexten" }, 1h);
+    conflater.process(batch, EventConflater::clock_t::now());
+    BOOST_CHECK(batch.empty());
+    conflater.configure({}, 0ms);
+    conflater.process(batch, EventConflater::clock_t::now());
+    BOOST_CHECK(batch.size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/EventDispatcher.hpp"
+#include "c++ami/reaction/EventList.hpp"
+
+using cpp_ami::EventDispatcher;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(event_dispatcher_tests)
+
+BOOST_AUTO_TEST_CASE(response_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    auto pipe = dispatcher.get_event_pipe("1", 5s);
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    auto const reaction = pipe.get();
+    BOOST_REQUIRE(reaction);
+    BOOST_CHECK(reaction->is_success());
+}
+
+BOOST_AUTO_TEST_CASE(timeout_test)
+{
+    std::promise<void> dispatched;
+    EventDispatcher dispatcher([&dispatched](EventDispatcher::event_batch_t) -> void { dispatched.set_value(); });
+
+    auto pipe = dispatcher.get_event_pipe("1", 20ms);
+    // Start an EventList that never completes
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\nEventList: start\r\n\r\n");
+
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK_THROW(pipe.get(), std::runtime_error);
+
+    // Late list items are no longer matched to the retired request; they fall through as notification events
+    dispatcher.add_event("Event: Item\r\nActionID: 1\r\n\r\n");
+    BOOST_CHECK(dispatched.get_future().wait_for(5s) == std::future_status::ready);
+}
+
+BOOST_AUTO_TEST_CASE(completion_handler_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    std::promise<EventDispatcher::reaction_ptr_t> result;
+    dispatcher.add_completion_handler("1",
+        [&result](EventDispatcher::reaction_ptr_t reaction, std::exception_ptr err) -> void {
+            BOOST_CHECK(!err);
+            result.set_value(std::move(reaction));
+        });
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\nEventList: start\r\n\r\n");
+    dispatcher.add_event("Event: Item\r\nActionID: 1\r\n\r\n");
+    dispatcher.add_event("Event: ItemComplete\r\nActionID: 1\r\nEventList: Complete\r\n\r\n");
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    auto const reaction = future.get();
+    BOOST_REQUIRE(reaction);
+    BOOST_CHECK(reaction->is_success());
+}
+
+BOOST_AUTO_TEST_CASE(completion_handler_timeout_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    std::promise<std::exception_ptr> result;
+    dispatcher.add_completion_handler("1",
+        [&result](EventDispatcher::reaction_ptr_t reaction, std::exception_ptr err) -> void {
+            BOOST_CHECK(!reaction);
+            result.set_value(err);
+        },
+        20ms);
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK_THROW(std::rethrow_exception(future.get()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_action_id_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    // A second request under an outstanding ID is refused without disturbing the first one
+    auto pipe = dispatcher.get_event_pipe("1", 5s);
+    BOOST_CHECK_THROW(static_cast<void>(dispatcher.get_event_pipe("1", 20ms)), std::runtime_error);
+
+    std::exception_ptr rejected;
+    BOOST_CHECK(!dispatcher.add_completion_handler("1",
+        [&rejected](EventDispatcher::reaction_ptr_t reaction, std::exception_ptr err) -> void {
+            BOOST_CHECK(!reaction);
+            rejected = err;
+        },
+        20ms));
+    BOOST_CHECK_THROW(std::rethrow_exception(rejected), std::runtime_error);
+
+    // No deadline was armed for the refused requests
+    BOOST_CHECK(pipe.wait_for(100ms) == std::future_status::timeout);
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(pipe.get()->is_success());
+
+    // Once answered the ID may be used again
+    auto again = dispatcher.get_event_pipe("1", 5s);
+    dispatcher.set_null_on_pipe("1");
+    BOOST_CHECK(!again.get());
+}
+
+BOOST_AUTO_TEST_CASE(completion_event_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    // The acknowledgement doesn't complete the request; the named event does
+    auto pipe = dispatcher.get_event_pipe("1", EventDispatcher::timeout_t::zero(), "OriginateResponse");
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\nMessage: Originate successfully queued\r\n\r\n");
+    BOOST_CHECK(pipe.wait_for(50ms) == std::future_status::timeout);
+
+    dispatcher.add_event("Event: OriginateResponse\r\nActionID: 1\r\nResponse: Failure\r\nReason: 3\r\n\r\n");
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    auto const reaction = pipe.get();
+    BOOST_REQUIRE(reaction);
+    BOOST_CHECK(!reaction->is_success());
+
+    // A rejected action is complete right away
+    auto rejected = dispatcher.get_event_pipe("2", EventDispatcher::timeout_t::zero(), "OriginateResponse");
+    dispatcher.add_event("Response: Error\r\nActionID: 2\r\nMessage: Permission denied\r\n\r\n");
+    BOOST_REQUIRE(rejected.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(!rejected.get()->is_success());
+}
+
+BOOST_AUTO_TEST_CASE(streaming_handler_test)
+{
+    EventDispatcher dispatcher([](EventDispatcher::event_batch_t) -> void {});
+
+    std::vector<std::string> items;
+    std::promise<EventDispatcher::reaction_ptr_t> result;
+    dispatcher.add_streaming_handler("1",
+        [&items](cpp_ami::event::Event const &item) -> void { items.push_back(item["Device"]); },
+        [&result](EventDispatcher::reaction_ptr_t reaction, std::exception_ptr) -> void {
+            result.set_value(std::move(reaction));
+        });
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\nEventList: start\r\n\r\n");
+    dispatcher.add_event("Event: DeviceStateChange\r\nActionID: 1\r\nDevice: SIP/1\r\n\r\n");
+    dispatcher.add_event("Event: DeviceStateChange\r\nActionID: 1\r\nDevice: SIP/2\r\n\r\n");
+    dispatcher.add_event("Event: DeviceStateListComplete\r\nActionID: 1\r\nEventList: Complete\r\n\r\n");
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    auto const reaction = future.get();
+    BOOST_REQUIRE(reaction);
+    BOOST_CHECK(reaction->is_success());
+
+    // Items were handed off in order and not buffered in the list
+    BOOST_CHECK((items == std::vector<std::string>{ "SIP/1", "SIP/2" }));
+    auto const *event_list = dynamic_cast<cpp_ami::reaction::EventList const *>(reaction.get());
+    BOOST_REQUIRE(event_list);
+    BOOST_CHECK(event_list->event_count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(batch_test)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> received;
+    EventDispatcher dispatcher([&](EventDispatcher::event_batch_t events) -> void {
+        std::unique_lock const lock(mutex);
+        for (auto const &event : events) {
+            received.push_back((*event)["Uniqueid"]);
+        }
+        cv.notify_one();
+    });
+
+    // Responses are pulled out of the stream; only notification events make it into the batches
+    auto pipe = dispatcher.get_event_pipe("1");
+    dispatcher.add_event("Event: Newstate\r\nUniqueid: a\r\n\r\n");
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+    dispatcher.add_event("Event: Newstate\r\nUniqueid: b\r\n\r\n");
+    dispatcher.add_event("Event: Hangup\r\nUniqueid: c\r\n\r\n");
+
+    BOOST_REQUIRE(pipe.wait_for(5s) == std::future_status::ready);
+    std::unique_lock lock(mutex);
+    BOOST_REQUIRE(cv.wait_for(lock, 5s, [&received]() -> bool { return received.size() == 3; }));
+    BOOST_CHECK((received == std::vector<std::string>{ "a", "b", "c" }));
+}
+
+BOOST_AUTO_TEST_CASE(response_lane_test)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    auto blocked = true;
+    EventDispatcher dispatcher([&](EventDispatcher::event_batch_t) -> void {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&blocked]() -> bool { return !blocked; });
+    });
+
+    // Responses are completed even while the notification callback is stuck
+    auto pipe = dispatcher.get_event_pipe("1");
+    dispatcher.add_event("Event: Newstate\r\nUniqueid: a\r\n\r\n");
+    dispatcher.add_event("Response: Success\r\nActionID: 1\r\n\r\n");
+    BOOST_CHECK(pipe.wait_for(5s) == std::future_status::ready);
+
+    std::unique_lock lock(mutex);
+    blocked = false;
+    cv.notify_all();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
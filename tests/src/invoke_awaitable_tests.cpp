@@ -0,0 +1,173 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/action/Action.hpp"
+#include "c++ami/Connection.hpp"
+#include <coroutine>
+#include <future>
+#include <stop_token>
+#include <thread>
+
+using cpp_ami::Connection;
+using cpp_ami::InvokeAwaitable;
+using cpp_ami::action::Action;
+using cpp_ami::test::FakeAmiServer;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Coroutine that runs eagerly and frees itself once it returns.
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/// @brief Reaction an awaiting coroutine was resumed with and the thread it was resumed on.
+struct Outcome {
+    InvokeAwaitable::reaction_ptr_t reaction;
+    std::thread::id thread;
+};
+
+Task await_invoke(Connection const &conn, Action action, InvokeAwaitable::executor_t executor,
+    std::chrono::milliseconds timeout, std::stop_token stop_token, std::promise<Outcome> &result)
+{
+    try {
+        auto reaction = co_await conn.invoke_async(action, std::move(executor), timeout, std::move(stop_token));
+        result.set_value(Outcome{ .reaction = std::move(reaction), .thread = std::this_thread::get_id() });
+    }
+    catch (...) {
+        result.set_exception(std::current_exception());
+    }
+}
+
+/// @brief Answers every action but Never right away.
+std::string never_handler(size_t session, cpp_ami::util::KeyValDict const &request)
+{
+    return request.get_value("Action") == "Never" ? std::string() : FakeAmiServer::success(session, request);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(invoke_awaitable_tests)
+
+BOOST_AUTO_TEST_CASE(immediate_completion_test)
+{
+    FakeAmiServer server;
+    Connection conn("127.0.0.1", server.port());
+
+    // Answered as fast as the server can; some reactions arrive before the coroutine is suspended, which leaves
+    // resuming to await_suspend
+    for (int i = 0; i < 200; ++i) {
+        std::promise<Outcome> result;
+        await_invoke(conn, Action("Ping"), {}, 5s, {}, result);
+        auto future = result.get_future();
+        BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        auto const outcome = future.get();
+        BOOST_REQUIRE(outcome.reaction);
+        BOOST_CHECK(outcome.reaction->is_success());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(late_completion_test)
+{
+    FakeAmiServer server(never_handler);
+    Connection conn("127.0.0.1", server.port());
+
+    std::promise<Outcome> result;
+    Action const action("Never");
+    await_invoke(conn, action, {}, 5s, {}, result);
+
+    // The coroutine is suspended until the reaction arrives, then resumed on the dispatcher thread
+    auto future = result.get_future();
+    BOOST_REQUIRE(server.wait_requests(1));
+    BOOST_CHECK(future.wait_for(50ms) == std::future_status::timeout);
+    server.send(0, fmt::format("Response: Success\r\nActionID: {}\r\n\r\n", action.get_action_id()));
+
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    auto const outcome = future.get();
+    BOOST_REQUIRE(outcome.reaction);
+    BOOST_CHECK(outcome.reaction->is_success());
+    BOOST_CHECK(outcome.thread != std::this_thread::get_id());
+}
+
+BOOST_AUTO_TEST_CASE(executor_test)
+{
+    FakeAmiServer server(never_handler);
+    std::jthread worker;
+    std::promise<std::thread::id> worker_id;
+    Connection conn("127.0.0.1", server.port());
+
+    std::promise<Outcome> result;
+    Action const action("Never");
+    await_invoke(conn, action,
+        [&worker, &worker_id](std::function<void()> resume) -> void {
+            worker = std::jthread(std::move(resume));
+            worker_id.set_value(worker.get_id());
+        },
+        5s, {}, result);
+    BOOST_REQUIRE(server.wait_requests(1));
+    server.send(0, fmt::format("Response: Success\r\nActionID: {}\r\n\r\n", action.get_action_id()));
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(future.get().thread == worker_id.get_future().get());
+}
+
+BOOST_AUTO_TEST_CASE(timeout_test)
+{
+    FakeAmiServer server(never_handler);
+    Connection conn("127.0.0.1", server.port());
+
+    std::promise<Outcome> result;
+    await_invoke(conn, Action("Never"), {}, 20ms, {}, result);
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK_THROW(future.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(stop_before_send_test)
+{
+    FakeAmiServer server;
+    Connection conn("127.0.0.1", server.port());
+
+    std::stop_source stop;
+    stop.request_stop();
+    std::promise<Outcome> result;
+    await_invoke(conn, Action("Ping"), {}, 5s, stop.get_token(), result);
+
+    // Never suspended and never sent
+    auto future = result.get_future();
+    BOOST_REQUIRE(future.wait_for(0s) == std::future_status::ready);
+    BOOST_CHECK(!future.get().reaction);
+    std::this_thread::sleep_for(20ms);
+    BOOST_CHECK(server.requests().empty());
+}
+
+BOOST_AUTO_TEST_CASE(stop_after_send_test)
+{
+    FakeAmiServer server(never_handler);
+    Connection conn("127.0.0.1", server.port());
+
+    std::stop_source stop;
+    std::promise<Outcome> result;
+    await_invoke(conn, Action("Never"), {}, 5s, stop.get_token(), result);
+
+    auto future = result.get_future();
+    BOOST_REQUIRE(server.wait_requests(1));
+    BOOST_CHECK(future.wait_for(0s) == std::future_status::timeout);
+    stop.request_stop();
+
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(!future.get().reaction);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
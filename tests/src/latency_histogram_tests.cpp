@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/util/LatencyHistogram.hpp"
+#include <thread>
+
+using cpp_ami::util::LatencyHistogram;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(latency_histogram_tests)
+
+BOOST_AUTO_TEST_CASE(quantile_test)
+{
+    LatencyHistogram histogram;
+    BOOST_CHECK(histogram.quantile(0.99) == 0us);
+
+    // 1ms through 100ms in 1ms steps
+    for (int i = 1; i <= 100; ++i) {
+        histogram.record(std::chrono::milliseconds(i));
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 100);
+
+    // Reported quantiles are bucket upper bounds: never below the true value, at most 12.5% above it
+    for (auto const &[quantile, expected] : { std::pair{ 0.5, 50ms }, { 0.95, 95ms }, { 1.0, 100ms } }) {
+        auto const reported = histogram.quantile(quantile);
+        BOOST_CHECK(reported >= expected);
+        BOOST_CHECK(reported <= expected + expected / 8);
+    }
+
+    histogram.reset();
+    BOOST_CHECK_EQUAL(histogram.count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(range_test)
+{
+    LatencyHistogram histogram;
+    histogram.record(-1ms);
+    histogram.record(7us);
+    BOOST_CHECK(histogram.quantile(0.5) == 0us);
+    BOOST_CHECK(histogram.quantile(1.0) == 7us);
+
+    // Latencies far outside the expected range still land in a bucket
+    histogram.record(std::chrono::hours(24 * 365));
+    BOOST_CHECK(histogram.quantile(1.0) >= std::chrono::hours(24 * 365));
+}
+
+BOOST_AUTO_TEST_CASE(decay_test)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100; ++i) {
+        histogram.record(1ms);
+    }
+    histogram.decay();
+    BOOST_CHECK_EQUAL(histogram.count(), 50);
+
+    // Once the old latencies count half, the new ones make up the median
+    for (int i = 0; i < 60; ++i) {
+        histogram.record(10ms);
+    }
+    BOOST_CHECK(histogram.quantile(0.5) >= 10ms);
+}
+
+BOOST_AUTO_TEST_CASE(half_life_test)
+{
+    LatencyHistogram histogram(20ms);
+    for (int i = 0; i < 64; ++i) {
+        histogram.record(1ms);
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 64);
+
+    // Recording ages the counts by every half-life that passed in between
+    std::this_thread::sleep_for(45ms);
+    histogram.record(1ms);
+    BOOST_CHECK(histogram.count() <= 64 / 4 + 1);
+
+    histogram.set_half_life(0ms);
+    std::this_thread::sleep_for(45ms);
+    auto const count = histogram.count();
+    histogram.record(1ms);
+    BOOST_CHECK_EQUAL(histogram.count(), count + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/cache/MailboxCache.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using cpp_ami::cache::MailboxCache;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(mailbox_cache_tests)
+
+BOOST_AUTO_TEST_CASE(single_flight_test)
+{
+    std::atomic<int> fetches{ 0 };
+    std::promise<void> gate;
+    auto const opened = gate.get_future().share();
+    MailboxCache cache([&fetches, opened](std::string const &mailbox) -> MailboxCache::Mailbox {
+        ++fetches;
+        opened.wait();
+        return { .mailbox = mailbox, .new_messages = 2, .waiting = true };
+    });
+
+    // Every lookup that misses while the first query is in flight waits for that query
+    std::vector<std::thread> lookups;
+    std::atomic<int> found{ 0 };
+    for (int idx = 0; idx < 8; ++idx) {
+        lookups.emplace_back([&cache, &found]() -> void {
+            if (cache.get("100")->new_messages == 2) {
+                ++found;
+            }
+        });
+    }
+    std::this_thread::sleep_for(50ms);
+    gate.set_value();
+    for (auto &lookup : lookups) {
+        lookup.join();
+    }
+
+    BOOST_CHECK(fetches == 1);
+    BOOST_CHECK(found == 8);
+    BOOST_REQUIRE(cache.find("100@default"));
+    BOOST_CHECK(cache.find("100@default")->mailbox == "100@default");
+}
+
+BOOST_AUTO_TEST_CASE(event_test)
+{
+    int fetches{ 0 };
+    MailboxCache cache([&fetches](std::string const &mailbox) -> MailboxCache::Mailbox {
+        ++fetches;
+        return { .mailbox = mailbox, .urgent_messages = 1, .new_messages = 1, .old_messages = 4, .waiting = true };
+    });
+
+    cache.get("100@sales");
+    cache.apply(KeyValDict("Event: MessageWaiting\r\nMailbox: 100@sales\r\nWaiting: 0\r\nNew: 0\r\nOld: 5\r\n\r\n"));
+
+    // Counts reported by the event are applied without querying the mailbox again
+    auto const counts = cache.get("100@sales");
+    BOOST_CHECK(fetches == 1);
+    BOOST_CHECK(counts->new_messages == 0);
+    BOOST_CHECK(counts->old_messages == 5);
+    BOOST_CHECK(!counts->waiting);
+
+    // Password change invalidates the mailbox
+    cache.apply(KeyValDict("Event: VoicemailPasswordChange\r\nContext: sales\r\nMailbox: 100\r\nNewPassword: 1\r\n\r\n"));
+    BOOST_CHECK(!cache.find("100@sales"));
+    cache.get("100@sales");
+    BOOST_CHECK(fetches == 2);
+
+    cache.resync();
+    BOOST_CHECK(!cache.find("100@sales"));
+}
+
+BOOST_AUTO_TEST_CASE(failure_test)
+{
+    MailboxCache cache([](std::string const &) -> MailboxCache::Mailbox {
+        throw std::runtime_error("no such mailbox");
+    });
+
+    // Failures aren't cached
+    BOOST_CHECK_THROW(cache.get("100"), std::runtime_error);
+    BOOST_CHECK(!cache.find("100"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "FakeAmiServer.hpp"
+#include "c++ami/Connection.hpp"
+#include "c++ami/OriginateEngine.hpp"
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using cpp_ami::Connection;
+using cpp_ami::OriginateEngine;
+using cpp_ami::action::Originate;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Returns the response Asterisk sends once it queued an asynchronous origination.
+std::string queued(std::string const &action_id)
+{
+    return fmt::format("Response: Success\r\nActionID: {}\r\nMessage: Originate successfully queued\r\n\r\n",
+        action_id);
+}
+
+/// @brief Returns the OriginateResponse event reporting the outcome of origination \c action_id.
+std::string outcome(std::string const &action_id, bool answered)
+{
+    return fmt::format("Event: OriginateResponse\r\nActionID: {}\r\nResponse: {}\r\nChannel: PJSIP/100\r\n"
+        "Reason: {}\r\n\r\n", action_id, answered ? "Success" : "Failure", answered ? 4 : 5);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(originate_engine_tests)
+
+BOOST_AUTO_TEST_CASE(pacing_test)
+{
+    std::vector<std::chrono::steady_clock::time_point> arrivals;
+    std::mutex arrivals_mutex;
+    FakeAmiServer server([&](size_t, KeyValDict const &request) -> std::string {
+        {
+            std::unique_lock const lock(arrivals_mutex);
+            arrivals.push_back(std::chrono::steady_clock::now());
+        }
+        auto const action_id = request.get_value("ActionID").value_or("");
+        return queued(action_id) + outcome(action_id, true);
+    });
+    Connection conn("127.0.0.1", server.port());
+    OriginateEngine engine(conn, OriginateEngine::Options{
+        .calls_per_second = 20.0, .burst = 1, .max_concurrent = 0, .timeout = 5s });
+
+    for (int i = 0; i < 6; ++i) {
+        engine.submit(Originate("PJSIP/100"));
+    }
+    engine.wait_idle();
+
+    // One token every 50 ms; the first origination goes out right away
+    std::unique_lock const lock(arrivals_mutex);
+    BOOST_REQUIRE_EQUAL(arrivals.size(), 6);
+    BOOST_CHECK(arrivals.back() - arrivals.front() >= 225ms);
+    for (size_t i = 1; i < arrivals.size(); ++i) {
+        BOOST_CHECK(arrivals[i] - arrivals[i - 1] >= 40ms);
+    }
+    BOOST_CHECK(engine.get_metrics().succeeded == 6);
+}
+
+BOOST_AUTO_TEST_CASE(correlation_test)
+{
+    // Asterisk only acknowledges the originations; their outcomes are pushed by the test
+    FakeAmiServer server([](size_t, KeyValDict const &request) -> std::string {
+        return queued(request.get_value("ActionID").value_or(""));
+    });
+    Connection conn("127.0.0.1", server.port());
+    OriginateEngine engine(conn, OriginateEngine::Options{
+        .calls_per_second = 1000.0, .burst = 10, .max_concurrent = 2, .timeout = 5s });
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 3; ++i) {
+        ids.push_back(engine.submit(Originate(fmt::format("PJSIP/{}", 100 + i))));
+    }
+
+    // The acknowledgement doesn't complete an origination, so the third one waits for room
+    BOOST_REQUIRE(server.wait_requests(2));
+    BOOST_CHECK(!engine.next(100ms));
+    BOOST_CHECK_EQUAL(server.requests().size(), 2);
+    BOOST_CHECK_EQUAL(engine.get_metrics().in_flight, 2);
+    BOOST_CHECK_EQUAL(engine.get_metrics().queued, 1);
+
+    // Outcomes are matched to their origination by ActionID, whatever order they are reported in
+    server.send(0, outcome(ids[1], false));
+    auto result = engine.next(5s);
+    BOOST_REQUIRE(result);
+    BOOST_CHECK(result->action_id == ids[1]);
+    BOOST_CHECK(!result->success);
+    BOOST_REQUIRE(result->reaction);
+    BOOST_CHECK(result->reaction->to_string().find("Reason: 5") != std::string::npos);
+
+    BOOST_REQUIRE(server.wait_requests(3));
+    BOOST_CHECK(server.requests()[2].second.get_value("ActionID") == ids[2]);
+    server.send(0, outcome(ids[2], true));
+    server.send(0, outcome(ids[0], true));
+    for (auto const &id : { ids[2], ids[0] }) {
+        result = engine.next(5s);
+        BOOST_REQUIRE(result);
+        BOOST_CHECK(result->action_id == id);
+        BOOST_CHECK(result->success);
+    }
+
+    auto const metrics = engine.get_metrics();
+    BOOST_CHECK(metrics.sent == 3);
+    BOOST_CHECK(metrics.succeeded == 2);
+    BOOST_CHECK(metrics.failed == 1);
+    BOOST_CHECK(metrics.in_flight == 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_rate_test)
+{
+    FakeAmiServer server;
+    Connection conn("127.0.0.1", server.port());
+    BOOST_CHECK_THROW(OriginateEngine(conn, OriginateEngine::Options{ .calls_per_second = 0.0 }),
+        std::invalid_argument);
+
+    // A rejected change keeps the engine pacing at its current rate
+    OriginateEngine engine(conn, OriginateEngine::Options{});
+    BOOST_CHECK_THROW(engine.set_options(OriginateEngine::Options{ .calls_per_second = -5.0 }),
+        std::invalid_argument);
+    BOOST_CHECK_THROW(engine.set_options(OriginateEngine::Options{ .burst = 0 }), std::invalid_argument);
+    engine.submit(Originate("PJSIP/100"));
+    BOOST_CHECK(server.wait_requests(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,48 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/cache/ParkingTracker.hpp"
+#include <vector>
+
+using cpp_ami::cache::ParkingTracker;
+using cpp_ami::util::KeyValDict;
+
+BOOST_AUTO_TEST_SUITE(parking_tracker_tests)
+
+BOOST_AUTO_TEST_CASE(slot_test)
+{
+    ParkingTracker tracker;
+
+    std::vector<std::string> changes;
+    tracker.subscribe([&changes](std::string const &lot, std::string const &space,
+                          ParkingTracker::parked_call_ptr_t const &call) -> void {
+        changes.push_back(lot + "/" + space + "=" + (call ? call->channel : "empty"));
+    });
+
+    tracker.load(KeyValDict("Event: Parkinglot\r\nName: default\r\nStartSpace: 701\r\nStopSpace: 720\r\n"
+        "Timeout: 45\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: ParkedCall\r\nParkeeChannel: PJSIP/100-1\r\nParkeeUniqueid: 1.1\r\n"
+        "Parkinglot: default\r\nParkingSpace: 701\r\nParkingTimeout: 45\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: ParkedCallSwap\r\nParkeeChannel: PJSIP/200-2\r\nParkeeUniqueid: 1.2\r\n"
+        "Parkinglot: default\r\nParkingSpace: 701\r\n\r\n"));
+
+    BOOST_REQUIRE(tracker.find_lot("default"));
+    BOOST_CHECK(tracker.find_lot("default")->stop_space == "720");
+    BOOST_REQUIRE(tracker.find("default", "701"));
+    BOOST_CHECK(tracker.find("default", "701")->uniqueid == "1.2");
+    BOOST_CHECK(tracker.parked_calls("default").size() == 1);
+
+    tracker.apply(KeyValDict("Event: ParkedCallTimeOut\r\nParkeeChannel: PJSIP/200-2\r\nParkinglot: default\r\n"
+        "ParkingSpace: 701\r\n\r\n"));
+    BOOST_CHECK(!tracker.find("default", "701"));
+    BOOST_CHECK(tracker.parked_calls().empty());
+
+    // Emptying an empty slot isn't a change
+    tracker.apply(KeyValDict("Event: UnParkedCall\r\nParkinglot: default\r\nParkingSpace: 701\r\n\r\n"));
+    BOOST_CHECK((changes == std::vector<std::string>{ "default/701=PJSIP/100-1", "default/701=PJSIP/200-2",
+        "default/701=empty" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
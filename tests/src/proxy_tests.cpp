@@ -0,0 +1,414 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "Eventually.hpp"
+#include "FakeAmiServer.hpp"
+#include "Proxy.hpp"
+#include "c++ami/DispatchGroup.hpp"
+#include "c++ami/net/SocketPoller.hpp"
+#include <atomic>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using cpp_ami::DispatchGroup;
+using cpp_ami::net::SocketPoller;
+using cpp_ami::proxy::Proxy;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::test::eventually;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Answers Command with its output in the current format and echoes the Tag of every other action.
+std::string handle(size_t session, KeyValDict const &request)
+{
+    auto const action_id = request.get_value("ActionID").value_or("");
+    if (request.get_value("Action") == "Command") {
+        return fmt::format("Response: Success\r\nActionID: {}\r\nMessage: Command output follows\r\nOutput: a\r\n"
+            "Output: b\r\n\r\n", action_id);
+    }
+    if (auto const tag = request.get_value("Tag")) {
+        return fmt::format("Response: Success\r\nActionID: {}\r\nTag: {}\r\n\r\n", action_id, tag.value());
+    }
+    return FakeAmiServer::success(session, request);
+}
+
+///
+/// @class Fixture
+///
+/// @brief Proxy of a fake AMI server, listening on a Unix socket of its own.
+///
+class Fixture {
+public:
+    explicit Fixture(FakeAmiServer::handler_t handler = handle)
+        : server(std::move(handler))
+    {
+        static std::atomic<int> sequence{ 0 };
+        path = fmt::format("/tmp/cppami_proxy_tests_{}_{}.sock", getpid(), sequence++);
+
+        Proxy::Options options;
+        options.listen = "unix:" + path;
+        options.users = { { "alice", Proxy::User{ .secret = "wonderland", .actions = { "*" } } },
+            { "bob", Proxy::User{ .secret = "builder", .actions = { "ping", "originate" } } } };
+        options.hostname = "127.0.0.1";
+        options.port = server.port();
+        options.username = "proxy";
+        options.secret = "secret";
+        options.timeout = 5s;
+        proxy = std::make_unique<Proxy>(options, poller, group);
+    }
+
+    FakeAmiServer server;
+    std::shared_ptr<SocketPoller> poller{ std::make_shared<SocketPoller>() };
+    std::shared_ptr<DispatchGroup> group{ std::make_shared<DispatchGroup>() };
+    std::string path;
+    std::unique_ptr<Proxy> proxy;
+};
+
+///
+/// @class Client
+///
+/// @brief Downstream AMI client speaking to the proxy over its Unix socket.
+///
+class Client {
+public:
+    explicit Client(std::string const &path)
+    {
+        sockaddr_un addr{ .sun_family = AF_UNIX, .sun_path = {} };
+        path.copy(addr.sun_path, path.length());
+        fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd_ == -1 || connect(fd_, reinterpret_cast<sockaddr const *>(&addr), sizeof(addr)) == -1) {
+            throw std::runtime_error("Client: unable to connect");
+        }
+        banner = read_until(cpp_ami::EOR);
+    }
+
+    /// @brief Connects and logs in as \c username, receiving the events in \c events.
+    Client(std::string const &path, std::string const &username, std::string const &secret,
+        std::string const &events = "on")
+        : Client(path)
+    {
+        send(fmt::format("Action: Login\r\nUsername: {}\r\nSecret: {}\r\nEvents: {}\r\n\r\n", username, secret,
+            events));
+        auto const response = read();
+        if (response.get_value("Response") != "Success") {
+            throw std::runtime_error("Client: login failed");
+        }
+    }
+
+    Client(Client const &) = delete;
+    Client& operator=(Client const &) = delete;
+
+    ~Client()
+    {
+        ::close(fd_);
+    }
+
+    void send(std::string_view data) const
+    {
+        [[maybe_unused]] auto const ret = ::send(fd_, data.data(), data.size(), MSG_NOSIGNAL);
+    }
+
+    /// @brief Returns the next message as it was written, or an empty string if none arrives in time.
+    std::string read_raw()
+    {
+        return read_until(cpp_ami::EOM);
+    }
+
+    /// @brief Returns the next message.
+    KeyValDict read()
+    {
+        auto message = read_raw();
+        BOOST_REQUIRE(!message.empty());
+        return KeyValDict(std::move(message));
+    }
+
+    /// @brief Returns \c true if the proxy closes the session within five seconds.
+    bool closed()
+    {
+        while (read_more(5s)) {
+        }
+        return eof_;
+    }
+
+    std::string banner;
+
+private:
+    std::string read_until(std::string_view delimiter)
+    {
+        auto end = input_.find(delimiter);
+        while (end == std::string::npos) {
+            if (!read_more(5s)) {
+                return {};
+            }
+            end = input_.find(delimiter);
+        }
+        auto message = input_.substr(0, end + delimiter.length());
+        input_.erase(0, end + delimiter.length());
+        return message;
+    }
+
+    bool read_more(std::chrono::milliseconds timeout)
+    {
+        pollfd fd{ .fd = fd_, .events = POLLIN, .revents = 0 };
+        if (eof_ || poll(&fd, 1, static_cast<int>(timeout.count())) != 1) {
+            return false;
+        }
+        char buf[4096];
+        auto const received = recv(fd_, buf, sizeof(buf), 0);
+        if (received <= 0) {
+            eof_ = true;
+            return false;
+        }
+        input_.append(buf, received);
+        return true;
+    }
+
+    int fd_{ -1 };
+    bool eof_{ false };
+    std::string input_;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(proxy_tests)
+
+BOOST_AUTO_TEST_CASE(rewrite_test)
+{
+    std::string const message("Response: Success\r\nActionID: up-1\r\nMessage: Pong\r\n\r\n");
+    BOOST_CHECK_EQUAL(Proxy::rewrite(message, "up-1", "mine"),
+        "Response: Success\r\nActionID: mine\r\nMessage: Pong\r\n\r\n");
+    BOOST_CHECK_EQUAL(Proxy::rewrite(message, "up-1", std::nullopt), "Response: Success\r\nMessage: Pong\r\n\r\n");
+
+    // Only the exact upstream ActionID is replaced
+    BOOST_CHECK_EQUAL(Proxy::rewrite(message, "up-", "mine"), message);
+    BOOST_CHECK_EQUAL(Proxy::rewrite("ActionID: a\r\nActionID: a\r\n\r\n", "a", "a-a"),
+        "ActionID: a-a\r\nActionID: a-a\r\n\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(login_test)
+{
+    Fixture fixture;
+
+    // Nothing reaches the upstream server before the client logs in
+    Client anonymous(fixture.path);
+    BOOST_CHECK_EQUAL(anonymous.banner, "Asterisk Call Manager/5.0.0\r\n");
+    anonymous.send("Action: Ping\r\nActionID: 1\r\n\r\n");
+    auto response = anonymous.read();
+    BOOST_CHECK(response.get_value("Response") == "Error");
+    BOOST_CHECK(response.get_value("Message") == "Permission denied");
+    BOOST_CHECK(response.get_value("ActionID") == "1");
+
+    anonymous.send("Action: Challenge\r\nAuthType: MD5\r\n\r\n");
+    BOOST_CHECK(anonymous.read().get_value("Response") == "Error");
+
+    // A failed login ends the session
+    anonymous.send("Action: Login\r\nUsername: alice\r\nSecret: looking-glass\r\n\r\n");
+    response = anonymous.read();
+    BOOST_CHECK(response.get_value("Message") == "Authentication failed");
+    BOOST_CHECK(anonymous.closed());
+
+    // Users may only send the actions they are allowed to
+    Client bob(fixture.path, "bob", "builder");
+    bob.send("Action: Status\r\nActionID: 2\r\n\r\n");
+    response = bob.read();
+    BOOST_CHECK(response.get_value("Message") == "Permission denied");
+    bob.send("Action: PING\r\nActionID: 3\r\n\r\n");
+    response = bob.read();
+    BOOST_CHECK(response.get_value("Response") == "Success");
+    BOOST_CHECK(response.get_value("ActionID") == "3");
+
+    // Only the proxy's own login and the ping went upstream
+    auto const requests = fixture.server.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 2);
+    BOOST_CHECK(requests[0].second.get_value("Username") == "proxy");
+    BOOST_CHECK(requests[1].second.get_value("Action") == "PING");
+
+    bob.send("Action: Logoff\r\n\r\n");
+    BOOST_CHECK(bob.read().get_value("Response") == "Goodbye");
+    BOOST_CHECK(bob.closed());
+}
+
+BOOST_AUTO_TEST_CASE(request_limit_test)
+{
+    Fixture fixture;
+    Client client(fixture.path, "alice", "wonderland");
+    Client other(fixture.path, "alice", "wonderland");
+
+    // A request that doesn't end within the limit disconnects its client, and only that one
+    std::string request("Action: Ping\r\n");
+    while (request.size() <= Proxy::Options{}.max_input) {
+        request += "Variable: padding\r\n";
+    }
+    client.send(request);
+    BOOST_CHECK(client.closed());
+    other.send("Action: Ping\r\nActionID: 1\r\n\r\n");
+    BOOST_CHECK(other.read().get_value("Response") == "Success");
+}
+
+BOOST_AUTO_TEST_CASE(action_id_collision_test)
+{
+    Fixture fixture;
+    Client a(fixture.path, "alice", "wonderland", "off");
+    Client b(fixture.path, "alice", "wonderland", "off");
+
+    // Both clients use the same ActionID; each gets its own response back under it
+    a.send("Action: UserEvent\r\nActionID: 1\r\nTag: a\r\n\r\n");
+    b.send("Action: UserEvent\r\nActionID: 1\r\nTag: b\r\n\r\n");
+    auto const response_a = a.read();
+    auto const response_b = b.read();
+    BOOST_CHECK(response_a.get_value("ActionID") == "1");
+    BOOST_CHECK(response_a.get_value("Tag") == "a");
+    BOOST_CHECK(response_b.get_value("ActionID") == "1");
+    BOOST_CHECK(response_b.get_value("Tag") == "b");
+
+    auto const requests = fixture.server.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 3);
+    BOOST_CHECK(requests[1].second.get_value("ActionID") != requests[2].second.get_value("ActionID"));
+    BOOST_CHECK(requests[1].second.get_value("ActionID") != "1");
+
+    // A request without an ActionID is answered without one
+    a.send("Action: UserEvent\r\nTag: c\r\n\r\n");
+    auto const response = a.read();
+    BOOST_CHECK(response.get_value("Tag") == "c");
+    BOOST_CHECK(!response.get_value("ActionID"));
+}
+
+BOOST_AUTO_TEST_CASE(event_mask_test)
+{
+    Fixture fixture;
+    Client calls(fixture.path, "alice", "wonderland", "call");
+    Client all(fixture.path, "alice", "wonderland");
+    Client none(fixture.path, "alice", "wonderland", "off");
+
+    fixture.server.send(0, "Event: Reload\r\nPrivilege: system,all\r\nModule: manager\r\n\r\n"
+        "Event: Newchannel\r\nPrivilege: call,all\r\nUniqueid: 1\r\n\r\n");
+    BOOST_CHECK(calls.read().get_value("Uniqueid") == "1");
+    BOOST_CHECK(all.read().get_value("Event") == "Reload");
+    BOOST_CHECK(all.read().get_value("Event") == "Newchannel");
+
+    // Events turns the events back on; the next event is the first the client receives
+    none.send("Action: Events\r\nActionID: 1\r\nEventMask: system\r\n\r\n");
+    BOOST_CHECK(none.read().get_value("Events") == "On");
+    fixture.server.send(0, "Event: Newchannel\r\nPrivilege: call,all\r\nUniqueid: 2\r\n\r\n"
+        "Event: Reload\r\nPrivilege: system,all\r\nModule: cdr\r\n\r\n");
+    BOOST_CHECK(none.read().get_value("Module") == "cdr");
+    BOOST_CHECK(calls.read().get_value("Uniqueid") == "2");
+
+    // The mask is applied by the proxy; the upstream session still receives every event
+    auto const requests = fixture.server.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 1);
+    BOOST_CHECK(requests[0].second.get_value("Events") == "on");
+}
+
+BOOST_AUTO_TEST_CASE(filter_test)
+{
+    Fixture fixture;
+    Client client(fixture.path, "alice", "wonderland");
+
+    client.send("Action: Filter\r\nActionID: 1\r\nOperation: Add\r\nFilter: Event: (Hangup|Newchannel)\r\n\r\n");
+    BOOST_CHECK(client.read().get_value("Message") == "Filter Added Successfully");
+    client.send("Action: Filter\r\nActionID: 2\r\nFilter: !Uniqueid: 2\r\n\r\n");
+    BOOST_CHECK(client.read().get_value("Message") == "Filter Added Successfully");
+    client.send("Action: Filter\r\nActionID: 3\r\nFilter: Event: (\r\n\r\n");
+    BOOST_CHECK(client.read().get_value("Message") == "Filter Not Added");
+
+    fixture.server.send(0, "Event: Newchannel\r\nUniqueid: 1\r\n\r\nEvent: Newstate\r\nUniqueid: 1\r\n\r\n"
+        "Event: Newchannel\r\nUniqueid: 2\r\n\r\nEvent: Hangup\r\nUniqueid: 1\r\n\r\n");
+    auto event = client.read();
+    BOOST_CHECK(event.get_value("Event") == "Newchannel");
+    BOOST_CHECK(event.get_value("Uniqueid") == "1");
+    event = client.read();
+    BOOST_CHECK(event.get_value("Event") == "Hangup");
+
+    // WaitEvent would hold up the shared upstream session and is answered by the proxy as well
+    client.send("Action: WaitEvent\r\nActionID: 4\r\nTimeout: 10\r\n\r\n");
+    auto const response = client.read();
+    BOOST_CHECK(response.get_value("Response") == "Error");
+    BOOST_CHECK(response.get_value("ActionID") == "4");
+    BOOST_CHECK_EQUAL(fixture.server.requests().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(originate_response_test)
+{
+    Fixture fixture([](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") != "Originate") {
+            return FakeAmiServer::success(session, request);
+        }
+        auto const action_id = request.get_value("ActionID").value_or("");
+        return fmt::format("Response: Success\r\nActionID: {}\r\nMessage: Originate successfully queued\r\n\r\n"
+            "Event: OriginateResponse\r\nPrivilege: call,all\r\nActionID: {}\r\nResponse: Success\r\n"
+            "Channel: PJSIP/100\r\nReason: 4\r\n\r\n", action_id, action_id);
+    });
+    Client sender(fixture.path, "bob", "builder");
+    Client other(fixture.path, "alice", "wonderland");
+
+    sender.send("Action: Originate\r\nActionID: call-1\r\nChannel: PJSIP/100\r\nApplication: Wait\r\nAsync: true\r\n"
+        "\r\n");
+
+    // The response and the event travel separately, so they may arrive in either order
+    std::vector<KeyValDict> messages{ sender.read(), sender.read() };
+    auto const event = std::ranges::find_if(messages, [](KeyValDict const &message) -> bool {
+        return message.get_value("Event") == "OriginateResponse";
+    });
+    BOOST_REQUIRE(event != messages.end());
+    BOOST_CHECK(event->get_value("ActionID") == "call-1");
+    BOOST_CHECK(event->get_value("Reason") == "4");
+
+    // The outcome only goes to the client that originated the call
+    fixture.server.send(0, "Event: Newchannel\r\nPrivilege: call,all\r\nUniqueid: 1\r\n\r\n");
+    BOOST_CHECK(other.read().get_value("Event") == "Newchannel");
+}
+
+BOOST_AUTO_TEST_CASE(command_test)
+{
+    Fixture fixture([](size_t session, KeyValDict const &request) -> std::string {
+        auto const action_id = request.get_value("ActionID").value_or("");
+        if (request.get_value("Command") == "legacy") {
+            return fmt::format("Response: Follows\r\nPrivilege: Command\r\nActionID: {}\r\nline 1\nline 2\n"
+                "--END COMMAND--\r\n\r\n", action_id);
+        }
+        return handle(session, request);
+    });
+    Client client(fixture.path, "alice", "wonderland", "off");
+
+    // The output is relayed as the AMI server sent it rather than as the list the parser turns it into
+    client.send("Action: Command\r\nActionID: 1\r\nCommand: core show uptime\r\n\r\n");
+    BOOST_CHECK_EQUAL(client.read_raw(),
+        "Response: Success\r\nActionID: 1\r\nMessage: Command output follows\r\nOutput: a\r\nOutput: b\r\n\r\n");
+
+    client.send("Action: Command\r\nActionID: 2\r\nCommand: legacy\r\n\r\n");
+    BOOST_CHECK_EQUAL(client.read_raw(),
+        "Response: Follows\r\nPrivilege: Command\r\nActionID: 2\r\nline 1\nline 2\n--END COMMAND--\r\n\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(reconnect_test)
+{
+    Fixture fixture;
+    Client client(fixture.path, "alice", "wonderland", "off");
+
+    fixture.server.close(0);
+    BOOST_REQUIRE(eventually([&fixture]() -> bool { return !fixture.proxy->is_connected(); }));
+    client.send("Action: Ping\r\nActionID: 1\r\n\r\n");
+    BOOST_CHECK(client.read().get_value("Message") == "Upstream session unavailable");
+
+    // The clients stay connected and are told when the session goes and comes back
+    fixture.proxy->reconnect();
+    BOOST_CHECK(fixture.proxy->is_connected());
+    BOOST_CHECK(client.read().get_value("Event") == "Shutdown");
+    BOOST_CHECK(client.read().get_value("Event") == "FullyBooted");
+
+    client.send("Action: Ping\r\nActionID: 2\r\n\r\n");
+    auto const response = client.read();
+    BOOST_CHECK(response.get_value("Response") == "Success");
+    BOOST_CHECK(response.get_value("ActionID") == "2");
+    BOOST_CHECK_EQUAL(fixture.server.sessions(), 2);
+    BOOST_CHECK_EQUAL(fixture.proxy->get_clients(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
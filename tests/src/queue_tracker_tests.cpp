@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/cache/QueueTracker.hpp"
+
+using cpp_ami::cache::QueueTracker;
+using cpp_ami::util::KeyValDict;
+
+BOOST_AUTO_TEST_SUITE(queue_tracker_tests)
+
+BOOST_AUTO_TEST_CASE(member_test)
+{
+    QueueTracker tracker;
+    tracker.load(KeyValDict("Event: QueueParams\r\nQueue: sales\r\nStrategy: ringall\r\nHoldtime: 20\r\n"
+        "Completed: 7\r\n\r\n"));
+    tracker.load(KeyValDict("Event: QueueMember\r\nQueue: sales\r\nName: Alice\r\nLocation: PJSIP/100\r\n"
+        "Status: 1\r\nPaused: 0\r\nCallsTaken: 3\r\n\r\n"));
+    tracker.load(KeyValDict("Event: QueueMember\r\nQueue: sales\r\nName: Bob\r\nLocation: PJSIP/200\r\n"
+        "Status: 5\r\nPaused: 0\r\n\r\n"));
+
+    auto const before = tracker.find("sales");
+    tracker.apply(KeyValDict("Event: QueueMemberPause\r\nQueue: sales\r\nInterface: PJSIP/100\r\nPaused: 1\r\n"
+        "PausedReason: lunch\r\n\r\n"));
+
+    // Snapshots taken before an update don't change
+    BOOST_REQUIRE(before);
+    BOOST_CHECK(before->members.at("PJSIP/100").paused == "0");
+
+    auto const after = tracker.find("sales");
+    BOOST_REQUIRE(after);
+    BOOST_CHECK(after->strategy == "ringall");
+    BOOST_CHECK(after->members.at("PJSIP/100").paused_reason == "lunch");
+    BOOST_CHECK(after->members.at("PJSIP/100").calls_taken == 3);
+
+    auto const summary = tracker.summarize("sales");
+    BOOST_REQUIRE(summary);
+    BOOST_CHECK(summary->logged_in == 1);
+    BOOST_CHECK(summary->available == 0);
+
+    tracker.apply(KeyValDict("Event: AgentComplete\r\nQueue: sales\r\nInterface: PJSIP/100\r\nTalkTime: 40\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: QueueMemberRemoved\r\nQueue: sales\r\nInterface: PJSIP/200\r\n\r\n"));
+    BOOST_CHECK(tracker.find("sales")->completed == 8);
+    BOOST_CHECK(tracker.find("sales")->talk_time == 10);
+    BOOST_CHECK(tracker.find("sales")->members.size() == 1);
+    BOOST_CHECK(!tracker.summarize("support"));
+}
+
+BOOST_AUTO_TEST_CASE(caller_test)
+{
+    QueueTracker tracker;
+
+    int changes{ 0 };
+    tracker.subscribe([&changes](std::string const &, QueueTracker::queue_ptr_t const &) -> void { ++changes; });
+
+    tracker.load(KeyValDict("Event: QueueEntry\r\nQueue: sales\r\nPosition: 1\r\nUniqueid: 1.1\r\nWait: 30\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: QueueCallerJoin\r\nQueue: sales\r\nPosition: 2\r\nUniqueid: 1.2\r\n\r\n"));
+    // Priority caller joins ahead of the others
+    tracker.apply(KeyValDict("Event: QueueCallerJoin\r\nQueue: sales\r\nPosition: 1\r\nUniqueid: 1.3\r\n\r\n"));
+
+    auto queue = tracker.find("sales");
+    BOOST_REQUIRE(queue && queue->callers.size() == 3);
+    BOOST_CHECK(queue->callers[0].uniqueid == "1.3");
+    BOOST_CHECK(queue->callers[1].uniqueid == "1.1" && queue->callers[1].position == 2);
+    BOOST_CHECK(tracker.summarize("sales")->longest_hold_time >= std::chrono::seconds(30));
+
+    tracker.apply(KeyValDict("Event: QueueCallerAbandon\r\nQueue: sales\r\nUniqueid: 1.1\r\n\r\n"));
+    tracker.apply(KeyValDict("Event: QueueCallerLeave\r\nQueue: sales\r\nUniqueid: 1.1\r\n\r\n"));
+
+    queue = tracker.find("sales");
+    BOOST_CHECK(queue->abandoned == 1);
+    BOOST_REQUIRE(queue->callers.size() == 2);
+    BOOST_CHECK(queue->callers[1].uniqueid == "1.2" && queue->callers[1].position == 2);
+
+    // The leave following the abandon changes nothing
+    BOOST_CHECK(changes == 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/action/Getvar.hpp"
+#include "c++ami/action/ListCommands.hpp"
+#include "c++ami/cache/ReactionCache.hpp"
+#include "c++ami/reaction/Event.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using cpp_ami::cache::ReactionCache;
+
+namespace {
+
+cpp_ami::EventDispatcher::reaction_ptr_t make_reaction(std::string const &response)
+{
+    return std::make_unique<cpp_ami::reaction::Event>(
+        cpp_ami::util::KeyValDict("Response: " + response + "\r\nValue: 1\r\n\r\n"));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(reaction_cache_tests)
+
+BOOST_AUTO_TEST_CASE(cache_key_test)
+{
+    cpp_ami::action::Getvar first;
+    first.set_value("Channel", "PJSIP/100-1");
+    first.set_value("Variable", "FOO");
+    cpp_ami::action::Getvar second;
+    second.set_value("Variable", "FOO");
+    second.set_value("Channel", "PJSIP/100-1");
+
+    // Action IDs differ, the headers don't
+    BOOST_CHECK(ReactionCache::cache_key(first) == ReactionCache::cache_key(second));
+    second.set_value("Variable", "BAR");
+    BOOST_CHECK(ReactionCache::cache_key(first) != ReactionCache::cache_key(second));
+}
+
+BOOST_AUTO_TEST_CASE(ttl_test)
+{
+    std::atomic<int> invocations{ 0 };
+    std::string response{ "Success" };
+    ReactionCache cache([&](cpp_ami::action::Action const &) -> cpp_ami::EventDispatcher::reaction_ptr_t {
+        ++invocations;
+        return make_reaction(response);
+    });
+    cache.set_ttl("ListCommands", std::chrono::milliseconds(50));
+
+    auto const first = cache.invoke(cpp_ami::action::ListCommands());
+    auto const second = cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(first == second);
+    BOOST_CHECK(invocations == 1);
+
+    // Actions without a TTL aren't cached
+    cache.invoke(cpp_ami::action::Getvar());
+    cache.invoke(cpp_ami::action::Getvar());
+    BOOST_CHECK(invocations == 3);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(invocations == 4);
+
+    // Unsuccessful reactions aren't cached
+    cache.invalidate("listcommands");
+    response = "Error";
+    cache.invoke(cpp_ami::action::ListCommands());
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(invocations == 6);
+
+    auto const metrics = cache.get_metrics();
+    BOOST_CHECK(metrics.hits == 1);
+    BOOST_CHECK(metrics.misses == 4);
+    BOOST_CHECK(metrics.bypassed == 2);
+    BOOST_CHECK(metrics.entries == 0);
+}
+
+BOOST_AUTO_TEST_CASE(single_flight_test)
+{
+    std::atomic<int> invocations{ 0 };
+    ReactionCache cache([&](cpp_ami::action::Action const &) -> cpp_ami::EventDispatcher::reaction_ptr_t {
+        ++invocations;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return make_reaction("Success");
+    });
+    cache.set_ttl("ListCommands", std::chrono::milliseconds::zero());
+
+    std::vector<ReactionCache::reaction_ptr_t> reactions(8);
+    std::vector<std::thread> threads;
+    for (auto &reaction : reactions) {
+        threads.emplace_back([&cache, &reaction]() -> void {
+            reaction = cache.invoke(cpp_ami::action::ListCommands());
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    BOOST_CHECK(invocations == 1);
+    for (auto const &reaction : reactions) {
+        BOOST_CHECK(reaction && reaction == reactions.front());
+    }
+
+    // A zero TTL coalesces without retaining the reaction
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(invocations == 2);
+}
+
+BOOST_AUTO_TEST_CASE(sweep_test)
+{
+    ReactionCache cache([](cpp_ami::action::Action const &) -> cpp_ami::EventDispatcher::reaction_ptr_t {
+        return make_reaction("Success");
+    });
+    cache.set_ttl("Getvar", std::chrono::milliseconds(20));
+    cache.set_ttl("ListCommands", std::chrono::seconds(60));
+
+    for (auto const *variable : { "FOO", "BAR", "BAZ" }) {
+        cpp_ami::action::Getvar action;
+        action.set_value("Variable", variable);
+        cache.invoke(action);
+    }
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(cache.get_metrics().entries == 4);
+
+    // Expired reactions of keys that aren't looked up again are dropped once another reaction is cached
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    cache.invalidate("ListCommands");
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(cache.get_metrics().entries == 1);
+
+    // Invalidated reactions take their timers with them
+    cache.invalidate();
+    BOOST_CHECK(cache.get_metrics().entries == 0);
+    cache.invoke(cpp_ami::action::ListCommands());
+    BOOST_CHECK(cache.get_metrics().entries == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
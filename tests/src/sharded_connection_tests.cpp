@@ -0,0 +1,289 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "Eventually.hpp"
+#include "FakeAmiServer.hpp"
+#include "c++ami/action/Action.hpp"
+#include "c++ami/action/Ping.hpp"
+#include "c++ami/ShardedConnection.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+using cpp_ami::ShardedConnection;
+using cpp_ami::action::Action;
+using cpp_ami::action::Ping;
+using cpp_ami::test::FakeAmiServer;
+using cpp_ami::test::eventually;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// @brief Answers every request right away except Slow actions, which are left for the test to answer.
+std::string hold_slow(size_t session, KeyValDict const &request)
+{
+    return request.get_value("Action") == "Slow" ? std::string() : FakeAmiServer::success(session, request);
+}
+
+/// @brief Answers every Slow action \c server received and hasn't answered yet.
+void answer_slow(FakeAmiServer &server)
+{
+    for (auto const &[session, request] : server.requests()) {
+        if (request.get_value("Action") == "Slow") {
+            server.send(session, FakeAmiServer::success(session, request));
+        }
+    }
+}
+
+/// @brief Returns the total number of actions outstanding on \c conn.
+size_t outstanding(ShardedConnection const &conn)
+{
+    auto const counts = conn.get_outstanding();
+    return std::accumulate(counts.begin(), counts.end(), size_t{ 0 });
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(sharded_connection_tests)
+
+BOOST_AUTO_TEST_CASE(sessions_test)
+{
+    FakeAmiServer server;
+    ShardedConnection const conn("127.0.0.1", server.port(), "admin", "secret", 3);
+    BOOST_CHECK_EQUAL(conn.size(), 3);
+    BOOST_CHECK_EQUAL(server.sessions(), 3);
+
+    // Every session logs in; only the first one asks for events
+    auto const requests = server.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 3);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto const &[session, request] = requests[i];
+        BOOST_CHECK_EQUAL(session, i);
+        BOOST_CHECK(request.get_value("Action") == "Login");
+        BOOST_CHECK(request.get_value("Username") == "admin");
+        BOOST_CHECK(request.get_value("Events") == (i == 0 ? "on" : "off"));
+    }
+
+    BOOST_CHECK_THROW(ShardedConnection("127.0.0.1", server.port(), "admin", "secret", 0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(failed_login_test)
+{
+    FakeAmiServer server([](size_t session, KeyValDict const &request) -> std::string {
+        if (session == 0) {
+            return FakeAmiServer::success(session, request);
+        }
+        return fmt::format("Response: Error\r\nActionID: {}\r\nMessage: Authentication failed\r\n\r\n",
+            request.get_value("ActionID").value_or(""));
+    });
+    BOOST_CHECK_THROW(ShardedConnection("127.0.0.1", server.port(), "admin", "secret", 2), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(least_outstanding_test)
+{
+    FakeAmiServer server(hold_slow);
+    ShardedConnection const conn("127.0.0.1", server.port(), "admin", "secret", 3);
+
+    // Busy sessions are passed over; two slow actions land on two different sessions
+    conn.async_invoke(Action("Slow"), [](auto, auto) -> void {}, 5s);
+    conn.async_invoke(Action("Slow"), [](auto, auto) -> void {}, 5s);
+    auto const counts = conn.get_outstanding();
+    BOOST_CHECK_EQUAL(std::ranges::count(counts, 1), 2);
+    auto const idle = static_cast<size_t>(std::ranges::find(counts, 0) - counts.begin());
+    BOOST_REQUIRE_LT(idle, 3);
+
+    BOOST_REQUIRE(conn.invoke(Ping(), 5s));
+    BOOST_CHECK_EQUAL(server.requests().back().first, idle);
+    BOOST_CHECK_EQUAL(outstanding(conn), 2);
+
+    BOOST_REQUIRE(server.wait_requests(3 + 3));
+    answer_slow(server);
+    BOOST_CHECK(eventually([&conn]() -> bool { return outstanding(conn) == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(untracked_test)
+{
+    FakeAmiServer server(hold_slow);
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 3);
+
+    std::atomic<size_t> answered{ 0 };
+    Action const untracked("Slow");
+    conn.add_callback([&answered, &untracked](KeyValDict const *event) -> void {
+        if (event->get_value("ActionID") == untracked.get_action_id()) {
+            ++answered;
+        }
+    });
+
+    // An action sent without a handler goes over the first session and its response reaches the event callbacks
+    conn.async_invoke(untracked);
+    BOOST_REQUIRE(server.wait_requests(3 + 1));
+    BOOST_CHECK_EQUAL(server.requests().back().first, 0);
+    BOOST_CHECK_EQUAL(outstanding(conn), 0);
+    answer_slow(server);
+    BOOST_CHECK(eventually([&answered]() -> bool { return answered == 1; }));
+}
+
+BOOST_AUTO_TEST_CASE(events_test)
+{
+    FakeAmiServer server;
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 2);
+
+    std::vector<std::string> seen;
+    std::mutex seen_mutex;
+    auto const key = conn.add_callback([&](KeyValDict const *event) -> void {
+        std::unique_lock const lock(seen_mutex);
+        seen.push_back(event->get_value("Uniqueid").value_or(""));
+    });
+    std::atomic<size_t> stray{ 0 };
+    conn.get_session(1).add_callback([&stray](KeyValDict const *) -> void { ++stray; });
+
+    // Whatever reaches another session doesn't reach the callbacks
+    server.send(1, "Event: Newchannel\r\nUniqueid: 1\r\n\r\n");
+    BOOST_REQUIRE(eventually([&stray]() -> bool { return stray == 1; }));
+    server.send(0, "Event: Newchannel\r\nUniqueid: 2\r\n\r\n");
+    BOOST_REQUIRE(eventually([&]() -> bool {
+        std::unique_lock const lock(seen_mutex);
+        return !seen.empty();
+    }));
+
+    conn.remove_callback(key);
+    std::unique_lock const lock(seen_mutex);
+    BOOST_CHECK((seen == std::vector<std::string>{ "2" }));
+}
+
+BOOST_AUTO_TEST_CASE(cancel_test)
+{
+    FakeAmiServer server(hold_slow);
+    ShardedConnection const conn("127.0.0.1", server.port(), "admin", "secret", 3);
+
+    // Keep two sessions busy so that the cancelled action isn't on the first one searched
+    conn.async_invoke(Action("Slow"), [](auto, auto) -> void {}, 5s);
+    conn.async_invoke(Action("Slow"), [](auto, auto) -> void {}, 5s);
+
+    Action const action("Slow");
+    std::promise<ShardedConnection::reaction_ptr_t> cancelled;
+    conn.async_invoke(action,
+        [&cancelled](ShardedConnection::reaction_ptr_t reaction, std::exception_ptr) -> void {
+            cancelled.set_value(std::move(reaction));
+        },
+        5s);
+    BOOST_CHECK_EQUAL(outstanding(conn), 3);
+
+    // The cancel reaches whichever session the action was sent over
+    conn.cancel(action);
+    auto future = cancelled.get_future();
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(!future.get());
+    BOOST_CHECK_EQUAL(outstanding(conn), 2);
+
+    BOOST_REQUIRE(server.wait_requests(3 + 3));
+    answer_slow(server);
+    BOOST_CHECK(eventually([&conn]() -> bool { return outstanding(conn) == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(hedge_race_test)
+{
+    // The first and third Getvar are held for the test to answer; the others are answered right away
+    std::atomic<size_t> getvars{ 0 };
+    FakeAmiServer server([&getvars](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") == "Getvar" && ++getvars % 2 == 1) {
+            return {};
+        }
+        return FakeAmiServer::success(session, request);
+    });
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 2);
+    conn.set_hedge_policy(ShardedConnection::HedgePolicy{
+        .quantile = 1.0, .min_delay = 1ms, .initial_delay = 20ms, .min_samples = 2 });
+
+    // The second copy wins; the first one keeps its session busy until the late answer comes in
+    auto const reaction = conn.invoke_hedged(Action("Getvar"), 5s);
+    BOOST_REQUIRE(reaction);
+    BOOST_CHECK(reaction->is_success());
+    auto metrics = conn.get_hedge_metrics();
+    BOOST_CHECK_EQUAL(metrics.hedged, 1);
+    BOOST_CHECK_EQUAL(metrics.hedge_wins, 1);
+    BOOST_CHECK_EQUAL(outstanding(conn), 1);
+
+    std::this_thread::sleep_for(200ms);
+    auto const held = server.requests()[2];
+    server.send(held.first, FakeAmiServer::success(held.first, held.second));
+    BOOST_REQUIRE(eventually([&conn]() -> bool { return outstanding(conn) == 0; }));
+
+    // The late answer was observed, so the hedge delay is now the slow copy's latency: an action answered within it
+    // isn't sent again
+    std::thread answer([&server]() -> void {
+        BOOST_REQUIRE(server.wait_requests(2 + 3));
+        std::this_thread::sleep_for(50ms);
+        auto const [session, request] = server.requests()[4];
+        server.send(session, FakeAmiServer::success(session, request));
+    });
+    BOOST_CHECK(conn.invoke_hedged(Action("Getvar"), 5s));
+    answer.join();
+    metrics = conn.get_hedge_metrics();
+    BOOST_CHECK_EQUAL(metrics.invoked, 2);
+    BOOST_CHECK_EQUAL(metrics.hedged, 1);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_cancel_test)
+{
+    FakeAmiServer server(hold_slow);
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 2);
+    conn.set_hedge_policy(ShardedConnection::HedgePolicy{ .initial_delay = 10ms });
+
+    // Cancelling closes both copies; the caller gets no reaction and no session stays busy
+    Action const action("Slow");
+    std::thread canceller([&server, &conn, &action]() -> void {
+        BOOST_REQUIRE(server.wait_requests(2 + 2));
+        conn.cancel(action);
+    });
+    BOOST_CHECK(!conn.invoke_hedged(action, 5s));
+    canceller.join();
+    BOOST_CHECK_EQUAL(conn.get_hedge_metrics().hedged, 1);
+    BOOST_CHECK(eventually([&conn]() -> bool { return outstanding(conn) == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(hedge_timeout_test)
+{
+    FakeAmiServer server(hold_slow);
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 2);
+    conn.set_hedge_policy(ShardedConnection::HedgePolicy{ .initial_delay = 100ms });
+
+    // The second copy only gets what is left of the timeout
+    auto const started = std::chrono::steady_clock::now();
+    BOOST_CHECK_THROW(conn.invoke_hedged(Action("Slow"), 300ms), std::exception);
+    auto const elapsed = std::chrono::steady_clock::now() - started;
+    BOOST_CHECK(elapsed >= 250ms);
+    BOOST_CHECK(elapsed < 390ms);
+    BOOST_CHECK_EQUAL(conn.get_hedge_metrics().hedged, 1);
+    BOOST_CHECK_EQUAL(outstanding(conn), 0);
+
+    // No time is left for a second copy once the timeout is within the hedge delay
+    BOOST_CHECK_THROW(conn.invoke_hedged(Action("Slow"), 50ms), std::exception);
+    BOOST_CHECK_EQUAL(conn.get_hedge_metrics().hedged, 1);
+    BOOST_CHECK_EQUAL(server.requests().size(), 2 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_destruction_test)
+{
+    std::atomic<size_t> getvars{ 0 };
+    FakeAmiServer server([&getvars](size_t session, KeyValDict const &request) -> std::string {
+        if (request.get_value("Action") == "Getvar" && ++getvars == 1) {
+            return {};
+        }
+        return FakeAmiServer::success(session, request);
+    });
+
+    // The losing copy is still outstanding when the connection goes; it is closed rather than left pending
+    ShardedConnection conn("127.0.0.1", server.port(), "admin", "secret", 2);
+    conn.set_hedge_policy(ShardedConnection::HedgePolicy{ .initial_delay = 10ms });
+    BOOST_REQUIRE(conn.invoke_hedged(Action("Getvar"), 5s));
+    BOOST_CHECK_EQUAL(outstanding(conn), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/StreamParser.hpp"
+#include "c++ami/util/KeyValDict.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using cpp_ami::StreamParser;
+using cpp_ami::util::KeyValDict;
+using namespace std::chrono_literals;
+
+namespace {
+
+///
+/// @class Collector
+///
+/// @brief Collects the messages framed by a stream parser.
+///
+class Collector {
+public:
+    Collector()
+        : parser_([](std::string) -> void {}, [this](std::string message) -> void {
+            std::unique_lock const lock(mutex_);
+            messages_.emplace_back(std::move(message));
+            cv_.notify_one();
+        })
+    {
+        parser_.add_buf("Asterisk Call Manager/5.0.0\r\n");
+    }
+
+    void add_buf(std::string buf)
+    {
+        parser_.add_buf(std::move(buf));
+    }
+
+    std::vector<KeyValDict> wait_for(size_t count)
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait_for(lock, 5s, [this, count]() -> bool { return messages_.size() >= count; });
+        return messages_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<KeyValDict> messages_;
+    StreamParser parser_;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(stream_parser_tests)
+
+BOOST_AUTO_TEST_CASE(frame_test)
+{
+    Collector collector;
+    collector.add_buf("Event: Newstate\r\nUniqueid: 1\r\n\r\nEvent: Hangup\r\n");
+    collector.add_buf("Uniqueid: 1\r\n\r");
+    collector.add_buf("\n");
+
+    auto const messages = collector.wait_for(2);
+    BOOST_REQUIRE(messages.size() == 2);
+    BOOST_CHECK(messages[0].get_value("Event") == "Newstate");
+    BOOST_CHECK(messages[1].get_value("Event") == "Hangup");
+}
+
+BOOST_AUTO_TEST_CASE(command_output_test)
+{
+    // Output lines are streamed as list items while the response is still being read
+    Collector collector;
+    collector.add_buf("Response: Success\r\nActionID: 1\r\nMessage: Command output follows\r\nOutput: a\r\nOut");
+    auto messages = collector.wait_for(2);
+    BOOST_REQUIRE(messages.size() == 2);
+    BOOST_CHECK(messages[0].get_value("EventList") == "start");
+    BOOST_CHECK(messages[1].get_value("Event") == "CommandOutput");
+    BOOST_CHECK(messages[1].get_value("ActionID") == "1");
+    BOOST_CHECK(messages[1].get_value("Output") == "a");
+
+    collector.add_buf("put: b\r\nOutput: c\r\n\r\nEvent: Hangup\r\n\r\n");
+    messages = collector.wait_for(5);
+    BOOST_REQUIRE(messages.size() == 5);
+    BOOST_CHECK(messages[2].get_value("Output") == "b\nc");
+    BOOST_CHECK(messages[3].get_value("EventList") == "Complete");
+    BOOST_CHECK(messages[3].get_value("ListItems") == "2");
+    BOOST_CHECK(messages[4].get_value("Event") == "Hangup");
+}
+
+BOOST_AUTO_TEST_CASE(legacy_command_output_test)
+{
+    Collector collector;
+    collector.add_buf("Response: Follows\r\nPrivilege: Command\r\nActionID: 1\r\nline: 1\nline 2\n\nlast--END COMM");
+    collector.add_buf("AND--\r\n\r\nResponse: Success\r\nActionID: 2\r\n\r\n");
+
+    auto const messages = collector.wait_for(5);
+    BOOST_REQUIRE(messages.size() == 5);
+    BOOST_CHECK(messages[0].get_value("Response") == "Follows");
+    BOOST_CHECK(messages[0].get_value("EventList") == "start");
+    BOOST_CHECK(messages[1].get_value("Output") == "line: 1\nline 2\n");
+    BOOST_CHECK(messages[2].get_value("Output") == "last");
+    BOOST_CHECK(messages[3].get_value("EventList") == "Complete");
+    BOOST_CHECK(messages[4].get_value("ActionID") == "2");
+    BOOST_CHECK(!messages[4].get_value("EventList"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,177 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/Subscriber.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using cpp_ami::Subscriber;
+using namespace std::chrono_literals;
+
+namespace {
+
+///
+/// @class Consumer
+///
+/// @brief Subscriber callback that records events and can be held back to let the queue fill up.
+///
+class Consumer {
+public:
+    void operator()(Subscriber::event_t const *event)
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this]() -> bool { return !held_; });
+        auto const id = event->get_value("Uniqueid").value_or(event->get_value("Peer").value_or(""));
+        received_.push_back(id + "/" + event->get_value("State").value_or(""));
+        cv_.notify_all();
+    }
+
+    void hold()
+    {
+        std::unique_lock const lock(mutex_);
+        held_ = true;
+    }
+
+    void release()
+    {
+        std::unique_lock const lock(mutex_);
+        held_ = false;
+        cv_.notify_all();
+    }
+
+    bool wait_for(size_t count)
+    {
+        std::unique_lock lock(mutex_);
+        return cv_.wait_for(lock, 5s, [this, count]() -> bool { return received_.size() >= count; });
+    }
+
+    std::vector<std::string> received()
+    {
+        std::unique_lock const lock(mutex_);
+        return received_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool held_{ false };
+    std::vector<std::string> received_;
+};
+
+Subscriber::event_ptr_t make_event(std::string const &uniqueid, std::string const &state)
+{
+    return std::make_shared<Subscriber::event_t const>(
+        "Event: Newstate\r\nUniqueid: " + uniqueid + "\r\nState: " + state + "\r\n\r\n");
+}
+
+Subscriber::event_ptr_t make_peer_event(std::string const &peer, std::string const &state)
+{
+    return std::make_shared<Subscriber::event_t const>(
+        "Event: PeerStatus\r\nPeer: " + peer + "\r\nState: " + state + "\r\n\r\n");
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(subscriber_tests)
+
+BOOST_AUTO_TEST_CASE(drop_test)
+{
+    Consumer consumer;
+    consumer.hold();
+    Subscriber subscriber([&consumer](Subscriber::event_t const *event) -> void { consumer(event); },
+        { .capacity = 2, .overflow = Subscriber::Overflow::drop, .conflate_key = {} });
+
+    // First event is taken by the (held) delivery thread, the next two fill the queue and the last one is dropped
+    subscriber.push(std::vector{ make_event("a", "1") });
+    while (subscriber.get_metrics().queued != 0) {
+        std::this_thread::yield();
+    }
+    subscriber.push(std::vector{ make_event("b", "1"), make_event("c", "1"), make_event("d", "1") });
+
+    auto const metrics = subscriber.get_metrics();
+    BOOST_CHECK(metrics.queued == 2);
+    BOOST_CHECK(metrics.dropped == 1);
+
+    consumer.release();
+    BOOST_REQUIRE(consumer.wait_for(3));
+    BOOST_CHECK((consumer.received() == std::vector<std::string>{ "a/1", "b/1", "c/1" }));
+}
+
+BOOST_AUTO_TEST_CASE(conflate_test)
+{
+    Consumer consumer;
+    consumer.hold();
+    Subscriber subscriber([&consumer](Subscriber::event_t const *event) -> void { consumer(event); },
+        { .capacity = 2, .overflow = Subscriber::Overflow::conflate, .conflate_key = {} });
+
+    subscriber.push(std::vector{ make_event("a", "1") });
+    while (subscriber.get_metrics().queued != 0) {
+        std::this_thread::yield();
+    }
+
+    // Newer state replaces queued state of the same channel in place; the oldest event makes room once the queue is full
+    subscriber.push(std::vector{ make_event("b", "1"), make_event("c", "1"), make_event("b", "2"),
+        make_event("d", "1") });
+
+    auto const metrics = subscriber.get_metrics();
+    BOOST_CHECK(metrics.conflated == 1);
+    BOOST_CHECK(metrics.dropped == 1);
+
+    consumer.release();
+    BOOST_REQUIRE(consumer.wait_for(3));
+    BOOST_CHECK((consumer.received() == std::vector<std::string>{ "a/1", "c/1", "d/1" }));
+}
+
+BOOST_AUTO_TEST_CASE(conflate_room_test)
+{
+    Consumer consumer;
+    consumer.hold();
+    Subscriber subscriber([&consumer](Subscriber::event_t const *event) -> void { consumer(event); },
+        { .capacity = 3, .overflow = Subscriber::Overflow::conflate, .conflate_key = {} });
+
+    subscriber.push(std::vector{ make_event("a", "1") });
+    while (subscriber.get_metrics().queued != 0) {
+        std::this_thread::yield();
+    }
+
+    // Nothing is merged while there is room, and events without a Uniqueid are never merged with each other
+    subscriber.push(std::vector{ make_event("b", "1"), make_event("b", "2"), make_peer_event("p", "1") });
+    BOOST_CHECK(subscriber.get_metrics().conflated == 0);
+
+    // Full: a peer event makes room by discarding the oldest event, a channel event replaces its newest queued state
+    subscriber.push(std::vector{ make_peer_event("q", "1"), make_event("b", "3") });
+
+    auto const metrics = subscriber.get_metrics();
+    BOOST_CHECK(metrics.conflated == 1);
+    BOOST_CHECK(metrics.dropped == 1);
+
+    consumer.release();
+    BOOST_REQUIRE(consumer.wait_for(4));
+    BOOST_CHECK((consumer.received() == std::vector<std::string>{ "a/1", "b/3", "p/1", "q/1" }));
+}
+
+BOOST_AUTO_TEST_CASE(block_test)
+{
+    Consumer consumer;
+    {
+        Subscriber subscriber([&consumer](Subscriber::event_t const *event) -> void { consumer(event); },
+            { .capacity = 1, .overflow = Subscriber::Overflow::block, .conflate_key = {} });
+
+        std::vector<Subscriber::event_ptr_t> events;
+        for (auto const *uniqueid : { "a", "b", "c", "d" }) {
+            events.push_back(make_event(uniqueid, "1"));
+        }
+        subscriber.push(events);
+
+        BOOST_CHECK(subscriber.get_metrics().dropped == 0);
+        BOOST_CHECK(subscriber.get_metrics().high_water == 1);
+    }
+
+    // Destroying the subscriber delivers whatever was still queued
+    BOOST_CHECK((consumer.received() == std::vector<std::string>{ "a/1", "b/1", "c/1", "d/1" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
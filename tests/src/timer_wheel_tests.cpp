@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/util/TimerWheel.hpp"
+
+using cpp_ami::util::TimerWheel;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_tests)
+
+BOOST_AUTO_TEST_CASE(expire_test)
+{
+    auto const start = TimerWheel::clock_t::now();
+    TimerWheel wheel(10ms, start);
+
+    wheel.arm("a", start + 25ms);
+    wheel.arm("b", start + 50ms);
+    BOOST_CHECK(wheel.size() == 2);
+
+    BOOST_CHECK(wheel.advance(start + 20ms).empty());
+
+    auto expired = wheel.advance(start + 30ms);
+    BOOST_REQUIRE(expired.size() == 1);
+    BOOST_CHECK(expired[0] == "a");
+
+    expired = wheel.advance(start + 50ms);
+    BOOST_REQUIRE(expired.size() == 1);
+    BOOST_CHECK(expired[0] == "b");
+    BOOST_CHECK(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(cancel_test)
+{
+    auto const start = TimerWheel::clock_t::now();
+    TimerWheel wheel(10ms, start);
+
+    auto const handle = wheel.arm("a", start + 10ms);
+    wheel.arm("b", start + 10ms);
+    wheel.cancel(handle);
+    BOOST_CHECK(wheel.size() == 1);
+
+    auto const expired = wheel.advance(start + 10ms);
+    BOOST_REQUIRE(expired.size() == 1);
+    BOOST_CHECK(expired[0] == "b");
+}
+
+BOOST_AUTO_TEST_CASE(cascade_test)
+{
+    auto const start = TimerWheel::clock_t::now();
+    TimerWheel wheel(1ms, start);
+
+    // Spread timers across every wheel level, including one beyond the range of the coarsest wheel
+    std::vector<std::chrono::milliseconds> const deadlines{ 1ms, 63ms, 64ms, 65ms, 4095ms, 4097ms, 300000ms,
+        20000000ms };
+    for (auto const deadline : deadlines) {
+        wheel.arm(std::to_string(deadline.count()), start + deadline);
+    }
+
+    // Step the wheel in uneven increments; every timer must expire on its own tick and not a tick earlier
+    for (auto const deadline : deadlines) {
+        BOOST_CHECK(wheel.advance(start + deadline - 1ms).empty());
+
+        auto const expired = wheel.advance(start + deadline);
+        BOOST_REQUIRE(expired.size() == 1);
+        BOOST_CHECK(expired[0] == std::to_string(deadline.count()));
+    }
+    BOOST_CHECK(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(rearm_after_idle_test)
+{
+    auto const start = TimerWheel::clock_t::now();
+    TimerWheel wheel(10ms, start);
+
+    // Idle wheel skips ahead without stepping through every tick
+    BOOST_CHECK(wheel.advance(start + 1h).empty());
+
+    wheel.arm("a", start + 1h + 100ms);
+    BOOST_CHECK(wheel.advance(start + 1h + 90ms).empty());
+    BOOST_CHECK(wheel.advance(start + 1h + 100ms).size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Christopher L Walker
+// SPDX-License-Identifier: MIT
+
+#include <boost/test/unit_test.hpp>
+
+#include "c++ami/util/TokenBucket.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using cpp_ami::util::TokenBucket;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(token_bucket_tests)
+
+BOOST_AUTO_TEST_CASE(burst_test)
+{
+    auto const start = TokenBucket::clock_t::now();
+    TokenBucket bucket(10.0, 3, start);
+
+    BOOST_CHECK(bucket.available(start) == 3);
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(!bucket.try_acquire(start));
+    BOOST_CHECK(bucket.wait_time(start) == 100ms);
+
+    // Refills one token per interval, never beyond the burst
+    BOOST_CHECK(!bucket.try_acquire(start + 99ms));
+    BOOST_CHECK(bucket.try_acquire(start + 100ms));
+    BOOST_CHECK(bucket.available(start + 10s) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(rate_test)
+{
+    // Tokens handed out over a long run match the rate exactly, even when the interval isn't a whole number of ticks
+    auto now = TokenBucket::clock_t::now();
+    auto const end = now + 60s;
+    TokenBucket bucket(3.0, 1, now);
+
+    size_t acquired = 0;
+    while (now <= end) {
+        if (bucket.try_acquire(now)) {
+            ++acquired;
+        }
+        else {
+            now += bucket.wait_time(now);
+        }
+    }
+    BOOST_CHECK(acquired == 181);
+}
+
+BOOST_AUTO_TEST_CASE(set_rate_test)
+{
+    auto const start = TokenBucket::clock_t::now();
+    TokenBucket bucket(1.0, 5, start);
+    BOOST_CHECK(bucket.try_acquire(start));
+
+    // Held tokens are kept up to the new burst; the missing ones refill at the new rate
+    bucket.set_rate(100.0, 2, start);
+    BOOST_CHECK(bucket.available(start) == 2);
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(!bucket.try_acquire(start));
+    BOOST_CHECK(bucket.wait_time(start) == 10ms);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_rate_test)
+{
+    BOOST_CHECK_THROW(TokenBucket(0.0, 1), std::invalid_argument);
+    BOOST_CHECK_THROW(TokenBucket(-1.0, 1), std::invalid_argument);
+    BOOST_CHECK_THROW(TokenBucket(std::nan(""), 1), std::invalid_argument);
+    BOOST_CHECK_THROW(TokenBucket(1e-300, 1), std::invalid_argument);
+    BOOST_CHECK_THROW(TokenBucket(1.0, 0), std::invalid_argument);
+
+    // A rejected change leaves the bucket as it was
+    auto const start = TokenBucket::clock_t::now();
+    TokenBucket bucket(1.0, 2, start);
+    BOOST_CHECK_THROW(bucket.set_rate(0.0, 2, start), std::invalid_argument);
+    BOOST_CHECK(bucket.available(start) == 2);
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(bucket.try_acquire(start));
+    BOOST_CHECK(bucket.wait_time(start) == 1s);
+}
+
+BOOST_AUTO_TEST_SUITE_END()